@@ -0,0 +1,545 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+//SSE2 is always there on x64 and on x86 builds compiled with /arch:SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIPMAP_USE_SSE2 1
+#endif
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path, optionally building a chain of half-size mip levels
+		bool loadFromFile(std::string path, bool generateMipmaps = false);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point
+		void render(int x, int y);
+
+		//Renders texture stretched into the given size, using the closest mip level
+		void render(int x, int y, int width, int height);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+		//Gets number of levels (1 when no mipmaps were built)
+		int getLevelCount();
+
+	private:
+		//Picks the mip level that best fits the destination size
+		int selectLevel(int width, int height);
+
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Half-size textures, mMipTextures[0] is level 1 (the level after mTexture)
+		std::vector<SDL_Texture*> mMipTextures;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Premultiplies color by alpha in place for a 32-bit ARGB surface
+void premultiplyAlpha(SDL_Surface* surface);
+
+//Undoes premultiplyAlpha in place
+void unpremultiplyAlpha(SDL_Surface* surface);
+
+//Box filters source into destination, which has to be half its size (rounded down, at least 1)
+void downsampleBox(SDL_Surface* source, SDL_Surface* destination);
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene texture
+LTexture gViewportTexture;
+
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path, bool generateMipmaps) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL_Image Error: %s\n", path.c_str(), IMG_GetError());
+		return false;
+	}
+
+	//Color key image
+	SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+	//Filtering needs a known layout, so mipmapped images are converted to 32-bit ARGB first.
+	//Converting a color keyed surface to a format with alpha turns the keyed pixels transparent.
+	if (generateMipmaps) {
+		SDL_Surface* formattedSurface = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_ARGB8888, 0);
+		if (formattedSurface == NULL) {
+			printf("Unable to convert %s for mipmapping! SDL Error: %s\n", path.c_str(), SDL_GetError());
+			generateMipmaps = false;
+		}
+		else {
+			SDL_FreeSurface(loadedSurface);
+			loadedSurface = formattedSurface;
+		}
+	}
+
+	//Create texture from surface pixels
+	newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+	if (newTexture == NULL) {
+		printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+	}
+	else {
+		//Get image dimensions
+		mWidth = loadedSurface->w;
+		mHeight = loadedSurface->h;
+
+		if (generateMipmaps) {
+			//Filter in premultiplied space so transparent pixels don't bleed their color into the edges
+			premultiplyAlpha(loadedSurface);
+
+			//Each level is half the previous one until both sides reach a single pixel
+			SDL_Surface* previousLevel = loadedSurface;
+			while (previousLevel->w > 1 || previousLevel->h > 1) {
+				int levelWidth = previousLevel->w > 1 ? previousLevel->w / 2 : 1;
+				int levelHeight = previousLevel->h > 1 ? previousLevel->h / 2 : 1;
+				SDL_Surface* level = SDL_CreateRGBSurface(0, levelWidth, levelHeight, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+				if (level == NULL) {
+					printf("Unable to create mip level for %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+					break;
+				}
+				downsampleBox(previousLevel, level);
+
+				//The premultiplied copy is still needed to build the next level, so the texture gets its own straight alpha copy
+				SDL_Surface* straightLevel = SDL_ConvertSurfaceFormat(level, SDL_PIXELFORMAT_ARGB8888, 0);
+				SDL_Texture* levelTexture = NULL;
+				if (straightLevel != NULL) {
+					unpremultiplyAlpha(straightLevel);
+					levelTexture = SDL_CreateTextureFromSurface(gRenderer, straightLevel);
+					SDL_FreeSurface(straightLevel);
+				}
+
+				if (previousLevel != loadedSurface) {
+					SDL_FreeSurface(previousLevel);
+				}
+				previousLevel = level;
+
+				if (levelTexture == NULL) {
+					printf("Unable to create mip texture for %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+					break;
+				}
+				mMipTextures.push_back(levelTexture);
+			}
+
+			if (previousLevel != loadedSurface) {
+				SDL_FreeSurface(previousLevel);
+			}
+		}
+	}
+
+	//Get rid of old loaded surface
+	SDL_FreeSurface(loadedSurface);
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	//Free mip levels if they exist
+	for (size_t i = 0; i < mMipTextures.size(); ++i) {
+		SDL_DestroyTexture(mMipTextures[i]);
+	}
+	mMipTextures.clear();
+
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	//Allows us to render images at certain positions on the screen rather than full-screen images like before
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+void LTexture::render(int x, int y, int width, int height) {
+	//Linear filtering only looks at 4 texels, so shrinking by more than 2x skips texels and aliases.
+	//Sampling from a smaller pre-filtered level reads fewer texels and looks better at the same time.
+	int level = selectLevel(width, height);
+	SDL_Texture* texture = level == 0 ? mTexture : mMipTextures[level - 1];
+
+	SDL_Rect renderQuad = { x, y, width, height };
+	SDL_RenderCopy(gRenderer, texture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+int LTexture::getLevelCount()
+{
+	return mTexture == NULL ? 0 : (int)mMipTextures.size() + 1;
+}
+
+int LTexture::selectLevel(int width, int height)
+{
+	//Walk down while the next level is still at least as big as the destination, so we never magnify a level
+	//that is smaller than the area it covers
+	int level = 0;
+	int levelWidth = mWidth;
+	int levelHeight = mHeight;
+	while (level < (int)mMipTextures.size() && levelWidth / 2 >= width && levelHeight / 2 >= height)
+	{
+		levelWidth /= 2;
+		levelHeight /= 2;
+		++level;
+	}
+
+	return level;
+}
+
+void premultiplyAlpha(SDL_Surface* surface)
+{
+	SDL_LockSurface(surface);
+	for (int y = 0; y < surface->h; ++y)
+	{
+		Uint32* row = (Uint32*)((Uint8*)surface->pixels + y * surface->pitch);
+		for (int x = 0; x < surface->w; ++x)
+		{
+			Uint32 p = row[x];
+			Uint32 a = p >> 24;
+			Uint32 r = (((p >> 16) & 0xFF) * a + 127) / 255;
+			Uint32 g = (((p >> 8) & 0xFF) * a + 127) / 255;
+			Uint32 b = ((p & 0xFF) * a + 127) / 255;
+			row[x] = (a << 24) | (r << 16) | (g << 8) | b;
+		}
+	}
+	SDL_UnlockSurface(surface);
+}
+
+void unpremultiplyAlpha(SDL_Surface* surface)
+{
+	SDL_LockSurface(surface);
+	for (int y = 0; y < surface->h; ++y)
+	{
+		Uint32* row = (Uint32*)((Uint8*)surface->pixels + y * surface->pitch);
+		for (int x = 0; x < surface->w; ++x)
+		{
+			Uint32 p = row[x];
+			Uint32 a = p >> 24;
+			if (a == 0)
+			{
+				row[x] = 0;
+			}
+			else if (a < 0xFF)
+			{
+				Uint32 r = SDL_min((((p >> 16) & 0xFF) * 255 + a / 2) / a, 0xFFu);
+				Uint32 g = SDL_min((((p >> 8) & 0xFF) * 255 + a / 2) / a, 0xFFu);
+				Uint32 b = SDL_min(((p & 0xFF) * 255 + a / 2) / a, 0xFFu);
+				row[x] = (a << 24) | (r << 16) | (g << 8) | b;
+			}
+		}
+	}
+	SDL_UnlockSurface(surface);
+}
+
+//Averages one output pixel from up to four source pixels, per channel
+static Uint32 averageQuad(Uint32 p0, Uint32 p1, Uint32 p2, Uint32 p3)
+{
+	Uint32 result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		Uint32 sum = ((p0 >> shift) & 0xFF) + ((p1 >> shift) & 0xFF) + ((p2 >> shift) & 0xFF) + ((p3 >> shift) & 0xFF);
+		result |= ((sum + 2) >> 2) << shift;
+	}
+	return result;
+}
+
+void downsampleBox(SDL_Surface* source, SDL_Surface* destination)
+{
+	SDL_LockSurface(source);
+	SDL_LockSurface(destination);
+
+#ifdef MIPMAP_USE_SSE2
+	const bool useSSE2 = SDL_HasSSE2() == SDL_TRUE;
+#endif
+
+	for (int y = 0; y < destination->h; ++y)
+	{
+		//A source with a single row (or column) just reuses it instead of reading past the edge
+		int sourceY0 = SDL_min(y * 2, source->h - 1);
+		int sourceY1 = SDL_min(y * 2 + 1, source->h - 1);
+		const Uint32* row0 = (const Uint32*)((const Uint8*)source->pixels + sourceY0 * source->pitch);
+		const Uint32* row1 = (const Uint32*)((const Uint8*)source->pixels + sourceY1 * source->pitch);
+		Uint32* out = (Uint32*)((Uint8*)destination->pixels + y * destination->pitch);
+
+		int x = 0;
+
+#ifdef MIPMAP_USE_SSE2
+		//Two output pixels per step: 4 source pixels from each row are widened to 16 bits per channel,
+		//summed vertically, then the neighbouring pixel is added by shifting the upper half down
+		if (useSSE2 && source->w >= 2)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i rounding = _mm_set1_epi16(2);
+			for (; x + 2 <= destination->w && x * 2 + 4 <= source->w; x += 2)
+			{
+				__m128i top = _mm_loadu_si128((const __m128i*)(row0 + x * 2));
+				__m128i bottom = _mm_loadu_si128((const __m128i*)(row1 + x * 2));
+
+				__m128i left = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+				__m128i right = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+				left = _mm_add_epi16(left, _mm_srli_si128(left, 8));
+				right = _mm_add_epi16(right, _mm_srli_si128(right, 8));
+
+				__m128i sum = _mm_unpacklo_epi64(left, right);
+				sum = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+				_mm_storel_epi64((__m128i*)(out + x), _mm_packus_epi16(sum, zero));
+			}
+		}
+#endif
+
+		//Scalar path for the remaining pixels (and for CPUs without SSE2)
+		for (; x < destination->w; ++x)
+		{
+			int sourceX0 = SDL_min(x * 2, source->w - 1);
+			int sourceX1 = SDL_min(x * 2 + 1, source->w - 1);
+			out[x] = averageQuad(row0[sourceX0], row0[sourceX1], row1[sourceX0], row1[sourceX1]);
+		}
+	}
+
+	SDL_UnlockSurface(destination);
+	SDL_UnlockSurface(source);
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load viewport texture along with its mip chain
+	if (!gViewportTexture.loadFromFile("Images/viewport.png", true))
+	{
+		printf("Failed to load viewport texture image!\n");
+		success = false;
+	}
+	else
+	{
+		printf("Loaded viewport texture with %d mip levels\n", gViewportTexture.getLevelCount());
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded image
+	gViewportTexture.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Top left corner viewport
+				SDL_Rect topLeftViewport = { 0, 0, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
+				SDL_RenderSetViewport(gRenderer, &topLeftViewport);
+
+				//Render texture into the whole viewport, the mip level closest to the viewport size is picked
+				gViewportTexture.render(0, 0, topLeftViewport.w, topLeftViewport.h);
+
+				//Top right viewport
+				SDL_Rect topRightViewport = { SCREEN_WIDTH / 2, 0, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
+				SDL_RenderSetViewport(gRenderer, &topRightViewport);
+
+				//Render a row of shrinking thumbnails, each one drawn from a smaller level
+				int thumbnailX = 0;
+				int thumbnailWidth = topRightViewport.w / 2;
+				int thumbnailHeight = topRightViewport.h / 2;
+				while (thumbnailWidth >= 4 && thumbnailHeight >= 4)
+				{
+					gViewportTexture.render(thumbnailX, 0, thumbnailWidth, thumbnailHeight);
+					thumbnailX += thumbnailWidth;
+					thumbnailWidth /= 2;
+					thumbnailHeight /= 2;
+				}
+
+				//Bottom viewport
+				SDL_Rect bottomViewport = { 0, SCREEN_HEIGHT / 2, SCREEN_WIDTH, SCREEN_HEIGHT / 2 };
+				SDL_RenderSetViewport(gRenderer, &bottomViewport);
+
+				//Render texture to screen
+				gViewportTexture.render(0, 0, bottomViewport.w, bottomViewport.h);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
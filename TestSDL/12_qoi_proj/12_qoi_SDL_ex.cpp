@@ -0,0 +1,842 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, and strings
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//QOI ("Quite OK Image") is a lossless format that is a lot simpler than PNG: there is no zlib stream and no
+//per-row filters, every pixel is one of six small ops that either repeats, indexes, or nudges the previous pixel.
+//That makes decoding a single tight loop, which is several times faster than IMG_Load on a PNG of similar size.
+//The spec is at https://qoiformat.org/qoi-specification.pdf
+
+//QOI chunk tags
+const Uint8 QOI_OP_INDEX = 0x00;
+const Uint8 QOI_OP_DIFF = 0x40;
+const Uint8 QOI_OP_LUMA = 0x80;
+const Uint8 QOI_OP_RUN = 0xC0;
+const Uint8 QOI_OP_RGB = 0xFE;
+const Uint8 QOI_OP_RGBA = 0xFF;
+const Uint8 QOI_MASK_2 = 0xC0;
+
+//Header is "qoif", width, height (both big endian), channels, colorspace
+const int QOI_HEADER_SIZE = 14;
+
+//Stream ends with seven 0x00 bytes and a single 0x01
+const Uint8 QOI_PADDING[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+//Guards against headers that would make us allocate gigabytes
+const Uint32 QOI_PIXELS_MAX = 400000000;
+
+//Decoded images use R, G, B, A byte order, SDL_PIXELFORMAT_RGBA32 names this but only exists in newer SDL versions
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+const Uint32 QOI_SURFACE_FORMAT = SDL_PIXELFORMAT_RGBA8888;
+#else
+const Uint32 QOI_SURFACE_FORMAT = SDL_PIXELFORMAT_ABGR8888;
+#endif
+
+//Number of decodes per image in benchmark mode
+const int BENCHMARK_ITERATIONS = 200;
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point
+		void render(int x, int y);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Returns true if the stream starts with the QOI magic, the stream position is left unchanged
+bool QOI_isQOI(SDL_RWops* src);
+
+//Decodes a QOI image held in memory into a new 32-bit surface
+SDL_Surface* QOI_Decode(const Uint8* data, size_t size);
+
+//Loads a QOI image from a stream, closing it afterwards if freesrc is non-zero
+SDL_Surface* QOI_Load_RW(SDL_RWops* src, int freesrc);
+
+//Encodes a surface of any format and writes it as a QOI file
+bool QOI_Save(SDL_Surface* surface, std::string path);
+
+//Loads individual image as surface, QOI files are decoded here and everything else goes through IMG_Load
+SDL_Surface* loadSurface(std::string path);
+
+//Loads individual image as texture
+SDL_Texture* loadTexture(std::string path);
+
+//Converts every path given from PNG (or anything IMG_Load reads) into a .qoi file next to it
+int convertImages(int count, char* paths[]);
+
+//Times PNG against QOI decoding for the images in the Images folder
+int benchmarkImages();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path, loadSurface picks the decoder from the file contents
+	SDL_Surface* loadedSurface = loadSurface(path);
+	if (loadedSurface != NULL) {
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else {
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+//Pixel as it sits in a QOI_SURFACE_FORMAT surface
+union QOIPixel
+{
+	struct
+	{
+		Uint8 r, g, b, a;
+	} rgba;
+	Uint32 v;
+};
+
+//Position of a pixel in the 64 entry table of recently seen pixels
+static inline int qoiHash(const QOIPixel& p)
+{
+	return (p.rgba.r * 3 + p.rgba.g * 5 + p.rgba.b * 7 + p.rgba.a * 11) & 63;
+}
+
+static inline Uint32 qoiReadBE32(const Uint8* bytes)
+{
+	return ((Uint32)bytes[0] << 24) | ((Uint32)bytes[1] << 16) | ((Uint32)bytes[2] << 8) | bytes[3];
+}
+
+static inline void qoiWriteBE32(std::vector<Uint8>& bytes, Uint32 value)
+{
+	bytes.push_back((Uint8)(value >> 24));
+	bytes.push_back((Uint8)(value >> 16));
+	bytes.push_back((Uint8)(value >> 8));
+	bytes.push_back((Uint8)value);
+}
+
+bool QOI_isQOI(SDL_RWops* src)
+{
+	if (src == NULL)
+	{
+		return false;
+	}
+
+	//Peek at the magic and rewind, the same way IMG_isPNG does
+	Sint64 start = SDL_RWtell(src);
+	char magic[4] = { 0, 0, 0, 0 };
+	bool isQOI = SDL_RWread(src, magic, 1, 4) == 4 && magic[0] == 'q' && magic[1] == 'o' && magic[2] == 'i' && magic[3] == 'f';
+	SDL_RWseek(src, start, RW_SEEK_SET);
+
+	return isQOI;
+}
+
+SDL_Surface* QOI_Decode(const Uint8* data, size_t size)
+{
+	if (data == NULL || size < QOI_HEADER_SIZE + sizeof(QOI_PADDING) || data[0] != 'q' || data[1] != 'o' || data[2] != 'i' || data[3] != 'f')
+	{
+		SDL_SetError("Not a QOI image");
+		return NULL;
+	}
+
+	Uint32 width = qoiReadBE32(data + 4);
+	Uint32 height = qoiReadBE32(data + 8);
+	Uint8 channels = data[12];
+	if (width == 0 || height == 0 || channels < 3 || channels > 4 || height >= QOI_PIXELS_MAX / width)
+	{
+		SDL_SetError("Invalid QOI header");
+		return NULL;
+	}
+
+	//Always decode to 4 channels, 3 channel images just keep alpha at 255
+	int bpp = 0;
+	Uint32 rmask = 0, gmask = 0, bmask = 0, amask = 0;
+	SDL_PixelFormatEnumToMasks(QOI_SURFACE_FORMAT, &bpp, &rmask, &gmask, &bmask, &amask);
+	SDL_Surface* surface = SDL_CreateRGBSurface(0, (int)width, (int)height, bpp, rmask, gmask, bmask, amask);
+	if (surface == NULL)
+	{
+		return NULL;
+	}
+
+	QOIPixel index[64];
+	SDL_memset(index, 0, sizeof(index));
+
+	QOIPixel px;
+	px.rgba.r = 0;
+	px.rgba.g = 0;
+	px.rgba.b = 0;
+	px.rgba.a = 255;
+
+	//The last 8 bytes are the end marker, no chunk may start inside them
+	const Uint8* bytes = data + QOI_HEADER_SIZE;
+	const Uint8* chunksEnd = data + size - sizeof(QOI_PADDING);
+	int run = 0;
+
+	SDL_LockSurface(surface);
+	for (Uint32 y = 0; y < height; ++y)
+	{
+		Uint32* row = (Uint32*)((Uint8*)surface->pixels + y * surface->pitch);
+		for (Uint32 x = 0; x < width; ++x)
+		{
+			if (run > 0)
+			{
+				--run;
+			}
+			else if (bytes < chunksEnd)
+			{
+				int b1 = *bytes++;
+
+				if (b1 == QOI_OP_RGB)
+				{
+					px.rgba.r = bytes[0];
+					px.rgba.g = bytes[1];
+					px.rgba.b = bytes[2];
+					bytes += 3;
+				}
+				else if (b1 == QOI_OP_RGBA)
+				{
+					px.rgba.r = bytes[0];
+					px.rgba.g = bytes[1];
+					px.rgba.b = bytes[2];
+					px.rgba.a = bytes[3];
+					bytes += 4;
+				}
+				else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX)
+				{
+					px = index[b1];
+				}
+				else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF)
+				{
+					px.rgba.r += ((b1 >> 4) & 0x03) - 2;
+					px.rgba.g += ((b1 >> 2) & 0x03) - 2;
+					px.rgba.b += (b1 & 0x03) - 2;
+				}
+				else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA)
+				{
+					int b2 = *bytes++;
+					int vg = (b1 & 0x3F) - 32;
+					px.rgba.r += vg - 8 + ((b2 >> 4) & 0x0F);
+					px.rgba.g += vg;
+					px.rgba.b += vg - 8 + (b2 & 0x0F);
+				}
+				else
+				{
+					//QOI_OP_RUN, the bias of -1 is folded in since this pixel is written right away
+					run = b1 & 0x3F;
+				}
+
+				index[qoiHash(px)] = px;
+			}
+
+			row[x] = px.v;
+		}
+	}
+	SDL_UnlockSurface(surface);
+
+	//A chunk that runs past the end marker means the file was truncated
+	if (bytes > chunksEnd)
+	{
+		SDL_FreeSurface(surface);
+		SDL_SetError("Truncated QOI image");
+		return NULL;
+	}
+
+	return surface;
+}
+
+SDL_Surface* QOI_Load_RW(SDL_RWops* src, int freesrc)
+{
+	if (src == NULL)
+	{
+		return NULL;
+	}
+
+	//Read the whole file in one go, QOI has no structure that benefits from streaming
+	SDL_Surface* surface = NULL;
+	Sint64 size = SDL_RWsize(src) - SDL_RWtell(src);
+	if (size > 0)
+	{
+		std::vector<Uint8> data((size_t)size);
+		if (SDL_RWread(src, &data[0], 1, data.size()) == data.size())
+		{
+			surface = QOI_Decode(&data[0], data.size());
+		}
+		else
+		{
+			SDL_SetError("Unable to read QOI image");
+		}
+	}
+
+	if (freesrc)
+	{
+		SDL_RWclose(src);
+	}
+
+	return surface;
+}
+
+bool QOI_Save(SDL_Surface* surface, std::string path)
+{
+	//Work on a R, G, B, A copy so we don't care what format the source came in
+	SDL_Surface* rgbaSurface = SDL_ConvertSurfaceFormat(surface, QOI_SURFACE_FORMAT, 0);
+	if (rgbaSurface == NULL)
+	{
+		printf("Unable to convert surface for %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return false;
+	}
+
+	//Keep 3 channels when the image is fully opaque, it only changes the header but tells readers they can skip alpha
+	bool hasAlpha = false;
+	for (int y = 0; y < rgbaSurface->h && !hasAlpha; ++y)
+	{
+		const QOIPixel* row = (const QOIPixel*)((const Uint8*)rgbaSurface->pixels + y * rgbaSurface->pitch);
+		for (int x = 0; x < rgbaSurface->w; ++x)
+		{
+			if (row[x].rgba.a != 255)
+			{
+				hasAlpha = true;
+				break;
+			}
+		}
+	}
+
+	std::vector<Uint8> bytes;
+	bytes.reserve(QOI_HEADER_SIZE + rgbaSurface->w * rgbaSurface->h * 5 + sizeof(QOI_PADDING));
+	bytes.push_back('q');
+	bytes.push_back('o');
+	bytes.push_back('i');
+	bytes.push_back('f');
+	qoiWriteBE32(bytes, (Uint32)rgbaSurface->w);
+	qoiWriteBE32(bytes, (Uint32)rgbaSurface->h);
+	bytes.push_back(hasAlpha ? 4 : 3);
+	bytes.push_back(0);
+
+	QOIPixel index[64];
+	SDL_memset(index, 0, sizeof(index));
+
+	QOIPixel previous;
+	previous.rgba.r = 0;
+	previous.rgba.g = 0;
+	previous.rgba.b = 0;
+	previous.rgba.a = 255;
+
+	int run = 0;
+	int pixelCount = rgbaSurface->w * rgbaSurface->h;
+	for (int i = 0; i < pixelCount; ++i)
+	{
+		const QOIPixel* row = (const QOIPixel*)((const Uint8*)rgbaSurface->pixels + (i / rgbaSurface->w) * rgbaSurface->pitch);
+		QOIPixel px = row[i % rgbaSurface->w];
+
+		if (px.v == previous.v)
+		{
+			//Runs are capped at 62 since 63 and 64 would collide with the RGB and RGBA tags
+			++run;
+			if (run == 62 || i == pixelCount - 1)
+			{
+				bytes.push_back((Uint8)(QOI_OP_RUN | (run - 1)));
+				run = 0;
+			}
+			continue;
+		}
+
+		if (run > 0)
+		{
+			bytes.push_back((Uint8)(QOI_OP_RUN | (run - 1)));
+			run = 0;
+		}
+
+		int hash = qoiHash(px);
+		if (index[hash].v == px.v)
+		{
+			bytes.push_back((Uint8)(QOI_OP_INDEX | hash));
+		}
+		else
+		{
+			index[hash] = px;
+
+			if (px.rgba.a == previous.rgba.a)
+			{
+				//Differences wrap around like the decoder's Uint8 arithmetic does
+				Sint8 vr = (Sint8)(px.rgba.r - previous.rgba.r);
+				Sint8 vg = (Sint8)(px.rgba.g - previous.rgba.g);
+				Sint8 vb = (Sint8)(px.rgba.b - previous.rgba.b);
+				Sint8 vgr = (Sint8)(vr - vg);
+				Sint8 vgb = (Sint8)(vb - vg);
+
+				if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+				{
+					bytes.push_back((Uint8)(QOI_OP_DIFF | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2)));
+				}
+				else if (vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8)
+				{
+					bytes.push_back((Uint8)(QOI_OP_LUMA | (vg + 32)));
+					bytes.push_back((Uint8)(((vgr + 8) << 4) | (vgb + 8)));
+				}
+				else
+				{
+					bytes.push_back(QOI_OP_RGB);
+					bytes.push_back(px.rgba.r);
+					bytes.push_back(px.rgba.g);
+					bytes.push_back(px.rgba.b);
+				}
+			}
+			else
+			{
+				bytes.push_back(QOI_OP_RGBA);
+				bytes.push_back(px.rgba.r);
+				bytes.push_back(px.rgba.g);
+				bytes.push_back(px.rgba.b);
+				bytes.push_back(px.rgba.a);
+			}
+		}
+
+		previous = px;
+	}
+
+	bytes.insert(bytes.end(), QOI_PADDING, QOI_PADDING + sizeof(QOI_PADDING));
+	SDL_FreeSurface(rgbaSurface);
+
+	//Write the encoded image
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "wb");
+	if (file == NULL)
+	{
+		printf("Unable to open %s for writing! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return false;
+	}
+	bool success = SDL_RWwrite(file, &bytes[0], 1, bytes.size()) == bytes.size();
+	SDL_RWclose(file);
+
+	return success;
+}
+
+SDL_Surface* loadSurface(std::string path)
+{
+	//Open the file ourselves so we can look at the magic before choosing a decoder
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == NULL)
+	{
+		printf("Unable to open image %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return NULL;
+	}
+
+	//Both loaders close the file for us
+	SDL_Surface* loadedSurface = NULL;
+	if (QOI_isQOI(file))
+	{
+		loadedSurface = QOI_Load_RW(file, 1);
+		if (loadedSurface == NULL)
+		{
+			printf("Unable to load QOI image %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+	}
+	else
+	{
+		loadedSurface = IMG_Load_RW(file, 1);
+		if (loadedSurface == NULL)
+		{
+			printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+		}
+	}
+
+	return loadedSurface;
+}
+
+SDL_Texture* loadTexture(std::string path)
+{
+	//The final texture
+	SDL_Texture* newTexture = NULL;
+
+	//Load image at specified path
+	SDL_Surface* loadedSurface = loadSurface(path);
+	if (loadedSurface != NULL)
+	{
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL)
+		{
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	return newTexture;
+}
+
+int convertImages(int count, char* paths[])
+{
+	int failures = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		//Swap the extension (or append one) to get the output name
+		std::string source = paths[i];
+		std::string destination = source;
+		size_t dot = destination.find_last_of('.');
+		size_t slash = destination.find_last_of("/\\");
+		if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+		{
+			destination.erase(dot);
+		}
+		destination += ".qoi";
+
+		SDL_Surface* surface = IMG_Load(source.c_str());
+		if (surface == NULL)
+		{
+			printf("Unable to load image %s! SDL_image Error: %s\n", source.c_str(), IMG_GetError());
+			++failures;
+			continue;
+		}
+
+		if (QOI_Save(surface, destination))
+		{
+			printf("%s -> %s\n", source.c_str(), destination.c_str());
+		}
+		else
+		{
+			++failures;
+		}
+		SDL_FreeSurface(surface);
+	}
+
+	return failures == 0 ? 0 : 1;
+}
+
+//Reads a whole file into memory so the benchmark measures decoding and not the disk
+static bool readFile(std::string path, std::vector<Uint8>& bytes)
+{
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == NULL)
+	{
+		return false;
+	}
+
+	Sint64 size = SDL_RWsize(file);
+	bool success = size > 0;
+	if (success)
+	{
+		bytes.resize((size_t)size);
+		success = SDL_RWread(file, &bytes[0], 1, bytes.size()) == bytes.size();
+	}
+	SDL_RWclose(file);
+
+	return success;
+}
+
+int benchmarkImages()
+{
+	//Every image the lesson ships, each needs a .qoi made by the convert mode first
+	const char* images[] = { "Images/background", "Images/foo", "Images/viewport", "Images/texture", "Images/loaded" };
+
+	double frequency = (double)SDL_GetPerformanceFrequency();
+	double totalPNG = 0.0;
+	double totalQOI = 0.0;
+
+	printf("%-20s %10s %10s %12s %12s %8s\n", "image", "png bytes", "qoi bytes", "png ms", "qoi ms", "speedup");
+	for (size_t i = 0; i < SDL_arraysize(images); ++i)
+	{
+		std::string name = images[i];
+		std::vector<Uint8> png;
+		std::vector<Uint8> qoi;
+		if (!readFile(name + ".png", png) || !readFile(name + ".qoi", qoi))
+		{
+			printf("Skipping %s, run with \"convert %s.png\" first\n", name.c_str(), name.c_str());
+			continue;
+		}
+
+		//Decode through the same entry points loadSurface uses, from memory
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (int n = 0; n < BENCHMARK_ITERATIONS; ++n)
+		{
+			SDL_FreeSurface(IMG_Load_RW(SDL_RWFromConstMem(&png[0], (int)png.size()), 1));
+		}
+		double pngTime = (SDL_GetPerformanceCounter() - start) / frequency * 1000.0 / BENCHMARK_ITERATIONS;
+
+		start = SDL_GetPerformanceCounter();
+		for (int n = 0; n < BENCHMARK_ITERATIONS; ++n)
+		{
+			SDL_FreeSurface(QOI_Decode(&qoi[0], qoi.size()));
+		}
+		double qoiTime = (SDL_GetPerformanceCounter() - start) / frequency * 1000.0 / BENCHMARK_ITERATIONS;
+
+		totalPNG += pngTime;
+		totalQOI += qoiTime;
+		printf("%-20s %10u %10u %12.4f %12.4f %7.2fx\n", name.c_str(), (unsigned)png.size(), (unsigned)qoi.size(), pngTime, qoiTime, qoiTime > 0.0 ? pngTime / qoiTime : 0.0);
+	}
+	printf("%-20s %10s %10s %12.4f %12.4f %7.2fx\n", "total", "", "", totalPNG, totalQOI, totalQOI > 0.0 ? totalPNG / totalQOI : 0.0);
+
+	return 0;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading, still needed for images that haven't been converted
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' texture
+	if (!gFooTexture.loadFromFile("Images/foo.qoi"))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Load background texture
+	if (!gBackgroundTexture.loadFromFile("Images/background.qoi"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images
+	gFooTexture.free();
+	gBackgroundTexture.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Command line tools, "convert <images...>" writes .qoi files and "benchmark" compares decode times.
+	//Neither needs a window so they only start SDL_image.
+	if (argc >= 2 && (std::string(args[1]) == "convert" || std::string(args[1]) == "benchmark"))
+	{
+		if (SDL_Init(0) < 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG))
+		{
+			printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+			return 1;
+		}
+
+		int result = std::string(args[1]) == "convert" ? convertImages(argc - 2, args + 2) : benchmarkImages();
+
+		IMG_Quit();
+		SDL_Quit();
+		return result;
+	}
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render background texture to screen
+				gBackgroundTexture.render(0, 0);
+
+				//Render Foo' to the screen
+				gFooTexture.render(240, 190);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
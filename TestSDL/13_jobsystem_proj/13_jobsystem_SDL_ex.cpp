@@ -0,0 +1,897 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, SDL_thread, standard IO, strings, and atomics
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_thread.h>
+#include <stdio.h>
+#include <string>
+#include <atomic>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Number of stars that get culled and drawn every frame
+const int STAR_COUNT = 200000;
+
+//Size of each worker's job ring, has to be a power of two
+const int JOB_POOL_SIZE = 4096;
+const int JOB_POOL_MASK = JOB_POOL_SIZE - 1;
+
+//Upper bound on worker threads, including the main thread
+const int MAX_WORKERS = 64;
+
+//Bytes of argument storage each job carries, sized so a job fills one 64 byte cache line
+const int JOB_DATA_SIZE = 64 - sizeof(void*) * 2 - sizeof(std::atomic<int>);
+
+//Failed attempts to find work before an idle worker goes to sleep
+const int IDLE_SPIN_COUNT = 64;
+
+struct Job;
+
+//Work function, data points at the job's own argument storage
+typedef void (*JobFunction)(Job* job, void* data);
+
+//Function run by parallelFor on every sub-range [begin, end)
+typedef void (*ParallelForFunction)(int begin, int end, void* userdata);
+
+//A unit of work. A job is finished once it and every child created with it as parent have run,
+//which is what lets a parent be used as a fork-join counter.
+struct Job
+{
+	JobFunction function;
+	Job* parent;
+	std::atomic<int> unfinishedJobs;
+	char data[JOB_DATA_SIZE];
+};
+
+//Chase-Lev work stealing deque. The owning worker pushes and pops at the bottom (LIFO, so it keeps
+//working on what is hot in its cache) and other workers steal from the top (FIFO, so they take the
+//biggest, oldest pieces of work).
+class JobDeque
+{
+	public:
+		//Initializes the indices
+		JobDeque();
+
+		//Adds a job at the bottom, owner only. Returns false when the deque is full.
+		bool push(Job* job);
+
+		//Takes a job from the bottom, owner only
+		Job* pop();
+
+		//Takes a job from the top, any thread
+		Job* steal();
+
+	private:
+		std::atomic<Job*> mJobs[JOB_POOL_SIZE];
+		std::atomic<long long> mTop;
+		std::atomic<long long> mBottom;
+};
+
+//Fixed pool of worker threads sharing one set of deques. The main thread is worker 0 and
+//helps out whenever it waits on a job, so it never sits idle.
+class JobSystem
+{
+	public:
+		//Initializes variables
+		JobSystem();
+
+		//Starts the workers, 0 sizes the pool to the number of CPU cores
+		bool init(int workerCount = 0);
+
+		//Stops and joins the workers
+		void shutdown();
+
+		//Creates a job on the calling worker, optionally as a child of parent
+		Job* createJob(JobFunction function, Job* parent = NULL);
+
+		//Creates a job and copies size bytes of arguments into its data
+		Job* createJob(JobFunction function, const void* data, size_t size, Job* parent = NULL);
+
+		//Queues a job on the calling worker's deque
+		void run(Job* job);
+
+		//Runs other jobs until the given job and all of its children are finished
+		void wait(const Job* job);
+
+		//Creates a job that splits [begin, end) into pieces of at most grainSize and calls function on each
+		Job* createParallelFor(int begin, int end, int grainSize, ParallelForFunction function, void* userdata, Job* parent = NULL);
+
+		//Runs function over [begin, end) across all workers and returns once every piece is done
+		void parallelFor(int begin, int end, int grainSize, ParallelForFunction function, void* userdata);
+
+		//Gets number of workers, including the main thread
+		int getWorkerCount();
+
+	private:
+		//Finds something to do, first in our own deque then by stealing
+		Job* getJob();
+
+		//Runs a job and marks it finished
+		void execute(Job* job);
+
+		//Drops the unfinished count and propagates completion to the parent
+		void finish(Job* job);
+
+		//Worker thread entry point
+		static int workerThread(void* data);
+
+		//Worker threads, index 0 is the main thread and has no SDL_Thread
+		SDL_Thread* mThreads[MAX_WORKERS];
+		int mWorkerCount;
+
+		//Per worker deques and job pools
+		JobDeque mDeques[MAX_WORKERS];
+		Job* mJobPools[MAX_WORKERS];
+		unsigned int mJobPoolNext[MAX_WORKERS];
+
+		//Idle workers sleep on this, run() wakes one when there is new work
+		SDL_sem* mWakeSemaphore;
+		std::atomic<int> mSleepingWorkers;
+
+		//Cleared by shutdown()
+		std::atomic<bool> mRunning;
+};
+
+//Arguments handed to each worker thread
+struct WorkerStart
+{
+	JobSystem* system;
+	int index;
+};
+
+//Range job payload for createParallelFor
+struct ParallelForData
+{
+	ParallelForFunction function;
+	void* userdata;
+	int begin;
+	int end;
+	int grainSize;
+};
+
+//A star that may or may not be on screen this frame
+struct Star
+{
+	float x;
+	float y;
+	float speed;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//The engine's shared job system, asset loading, culling and blitting all go through it
+JobSystem gJobSystem;
+
+//Scene textures
+SDL_Texture* gFooTexture = NULL;
+SDL_Texture* gBackgroundTexture = NULL;
+
+//Texture the CPU writes into every frame
+SDL_Texture* gStreamingTexture = NULL;
+
+//Star field that gets culled in parallel
+Star* gStars = NULL;
+Uint8* gStarVisible = NULL;
+SDL_Point* gStarPoints = NULL;
+
+//Index of the worker running on the current thread
+static thread_local int tWorkerIndex = 0;
+
+//Per thread random state used to pick steal victims
+static thread_local unsigned int tRandomState = 0x9E3779B9u;
+
+
+// implementation of JobDeque class
+JobDeque::JobDeque()
+{
+	//Initialize
+	mTop = 0;
+	mBottom = 0;
+	for (int i = 0; i < JOB_POOL_SIZE; ++i)
+	{
+		mJobs[i] = NULL;
+	}
+}
+
+bool JobDeque::push(Job* job)
+{
+	long long bottom = mBottom.load(std::memory_order_relaxed);
+	long long top = mTop.load(std::memory_order_acquire);
+	if (bottom - top >= JOB_POOL_SIZE)
+	{
+		return false;
+	}
+
+	//The job has to be visible before the new bottom is, or a thief could grab an empty slot
+	mJobs[bottom & JOB_POOL_MASK].store(job, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+	return true;
+}
+
+Job* JobDeque::pop()
+{
+	long long bottom = mBottom.load(std::memory_order_relaxed) - 1;
+	mBottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long long top = mTop.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		//Deque was already empty
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+		return NULL;
+	}
+
+	Job* job = mJobs[bottom & JOB_POOL_MASK].load(std::memory_order_relaxed);
+	if (top == bottom)
+	{
+		//Last job left, race the thieves for it
+		if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			job = NULL;
+		}
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	return job;
+}
+
+Job* JobDeque::steal()
+{
+	long long top = mTop.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long long bottom = mBottom.load(std::memory_order_acquire);
+
+	if (top >= bottom)
+	{
+		return NULL;
+	}
+
+	//Another thief or the owner may have taken it in the meantime, in which case we just report nothing
+	Job* job = mJobs[top & JOB_POOL_MASK].load(std::memory_order_relaxed);
+	if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return NULL;
+	}
+
+	return job;
+}
+
+// implementation of JobSystem class
+JobSystem::JobSystem()
+{
+	//Initialize
+	mWorkerCount = 0;
+	mWakeSemaphore = NULL;
+	mSleepingWorkers = 0;
+	mRunning = false;
+	for (int i = 0; i < MAX_WORKERS; ++i)
+	{
+		mThreads[i] = NULL;
+		mJobPools[i] = NULL;
+		mJobPoolNext[i] = 0;
+	}
+}
+
+bool JobSystem::init(int workerCount)
+{
+	//One worker per core, the main thread counts as one of them
+	if (workerCount <= 0)
+	{
+		workerCount = SDL_GetCPUCount();
+	}
+	mWorkerCount = SDL_min(SDL_max(workerCount, 1), MAX_WORKERS);
+
+	mWakeSemaphore = SDL_CreateSemaphore(0);
+	if (mWakeSemaphore == NULL)
+	{
+		printf("Unable to create job semaphore! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	for (int i = 0; i < mWorkerCount; ++i)
+	{
+		mJobPools[i] = new Job[JOB_POOL_SIZE];
+		mJobPoolNext[i] = 0;
+		for (int j = 0; j < JOB_POOL_SIZE; ++j)
+		{
+			mJobPools[i][j].unfinishedJobs.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	//The calling thread becomes worker 0
+	tWorkerIndex = 0;
+	mRunning = true;
+
+	bool success = true;
+	for (int i = 1; i < mWorkerCount; ++i)
+	{
+		WorkerStart* start = new WorkerStart;
+		start->system = this;
+		start->index = i;
+		mThreads[i] = SDL_CreateThread(workerThread, "JobWorker", start);
+		if (mThreads[i] == NULL)
+		{
+			printf("Unable to create job worker %d! SDL Error: %s\n", i, SDL_GetError());
+			delete start;
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+void JobSystem::shutdown()
+{
+	//Tell the workers to stop and wake up any that are asleep
+	mRunning = false;
+	for (int i = 1; i < mWorkerCount; ++i)
+	{
+		SDL_SemPost(mWakeSemaphore);
+	}
+
+	for (int i = 1; i < mWorkerCount; ++i)
+	{
+		if (mThreads[i] != NULL)
+		{
+			SDL_WaitThread(mThreads[i], NULL);
+			mThreads[i] = NULL;
+		}
+	}
+
+	for (int i = 0; i < mWorkerCount; ++i)
+	{
+		delete[] mJobPools[i];
+		mJobPools[i] = NULL;
+	}
+
+	if (mWakeSemaphore != NULL)
+	{
+		SDL_DestroySemaphore(mWakeSemaphore);
+		mWakeSemaphore = NULL;
+	}
+	mWorkerCount = 0;
+}
+
+Job* JobSystem::createJob(JobFunction function, Job* parent)
+{
+	//Jobs come out of the calling worker's ring, so no locking or heap allocation is needed.
+	//Slots whose job is still running (deeply nested waits can keep many alive) are skipped.
+	int worker = tWorkerIndex;
+	Job* job = NULL;
+	while (job == NULL)
+	{
+		for (int i = 0; i < JOB_POOL_SIZE; ++i)
+		{
+			Job* slot = &mJobPools[worker][mJobPoolNext[worker]++ & JOB_POOL_MASK];
+			if (slot->unfinishedJobs.load(std::memory_order_acquire) == 0)
+			{
+				job = slot;
+				break;
+			}
+		}
+
+		//Every slot is live, reusing one would corrupt a running job's counters.
+		//Help with pending work like wait() does until one of them finishes.
+		if (job == NULL)
+		{
+			Job* next = getJob();
+			if (next != NULL)
+			{
+				execute(next);
+			}
+			else
+			{
+				SDL_Delay(0);
+			}
+		}
+	}
+
+	job->function = function;
+	job->parent = parent;
+	job->unfinishedJobs.store(1, std::memory_order_relaxed);
+
+	//The parent can't finish until this child does
+	if (parent != NULL)
+	{
+		parent->unfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return job;
+}
+
+Job* JobSystem::createJob(JobFunction function, const void* data, size_t size, Job* parent)
+{
+	SDL_assert(size <= JOB_DATA_SIZE);
+
+	Job* job = createJob(function, parent);
+	SDL_memcpy(job->data, data, size);
+	return job;
+}
+
+void JobSystem::run(Job* job)
+{
+	//When our deque is full just do the work right here
+	if (!mDeques[tWorkerIndex].push(job))
+	{
+		execute(job);
+		return;
+	}
+
+	//Wake a sleeping worker so the new job doesn't wait for a timeout
+	if (mSleepingWorkers.load(std::memory_order_relaxed) > 0)
+	{
+		SDL_SemPost(mWakeSemaphore);
+	}
+}
+
+void JobSystem::wait(const Job* job)
+{
+	//Help out instead of blocking, this is what keeps fork-join from deadlocking the pool
+	while (job->unfinishedJobs.load(std::memory_order_acquire) > 0)
+	{
+		Job* next = getJob();
+		if (next != NULL)
+		{
+			execute(next);
+		}
+		else
+		{
+			SDL_Delay(0);
+		}
+	}
+}
+
+//Splits a range in half until it is small enough to run directly
+static void parallelForJob(Job* job, void* data)
+{
+	ParallelForData* range = (ParallelForData*)data;
+	int count = range->end - range->begin;
+
+	if (count > range->grainSize)
+	{
+		//Both halves are children of this job, so whoever waits on it waits on the whole range
+		int middle = range->begin + count / 2;
+		ParallelForData left = *range;
+		ParallelForData right = *range;
+		left.end = middle;
+		right.begin = middle;
+
+		gJobSystem.run(gJobSystem.createJob(parallelForJob, &left, sizeof(left), job));
+		gJobSystem.run(gJobSystem.createJob(parallelForJob, &right, sizeof(right), job));
+	}
+	else if (count > 0)
+	{
+		range->function(range->begin, range->end, range->userdata);
+	}
+}
+
+Job* JobSystem::createParallelFor(int begin, int end, int grainSize, ParallelForFunction function, void* userdata, Job* parent)
+{
+	ParallelForData range;
+	range.function = function;
+	range.userdata = userdata;
+	range.begin = begin;
+	range.end = end;
+	range.grainSize = SDL_max(grainSize, 1);
+
+	return createJob(parallelForJob, &range, sizeof(range), parent);
+}
+
+void JobSystem::parallelFor(int begin, int end, int grainSize, ParallelForFunction function, void* userdata)
+{
+	Job* job = createParallelFor(begin, end, grainSize, function, userdata);
+	run(job);
+	wait(job);
+}
+
+int JobSystem::getWorkerCount()
+{
+	return mWorkerCount;
+}
+
+Job* JobSystem::getJob()
+{
+	int worker = tWorkerIndex;
+
+	Job* job = mDeques[worker].pop();
+	if (job != NULL)
+	{
+		return job;
+	}
+
+	if (mWorkerCount <= 1)
+	{
+		return NULL;
+	}
+
+	//Pick a random victim, xorshift is plenty for spreading steals out
+	tRandomState ^= tRandomState << 13;
+	tRandomState ^= tRandomState >> 17;
+	tRandomState ^= tRandomState << 5;
+	int victim = (int)(tRandomState % (unsigned int)mWorkerCount);
+	if (victim == worker)
+	{
+		victim = (victim + 1) % mWorkerCount;
+	}
+
+	return mDeques[victim].steal();
+}
+
+void JobSystem::execute(Job* job)
+{
+	job->function(job, job->data);
+	finish(job);
+}
+
+void JobSystem::finish(Job* job)
+{
+	//Read the parent first, once the count hits zero the slot can be handed out again.
+	//Release so the waiter sees everything the job wrote.
+	Job* parent = job->parent;
+	int unfinished = job->unfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) - 1;
+	if (unfinished == 0 && parent != NULL)
+	{
+		finish(parent);
+	}
+}
+
+int JobSystem::workerThread(void* data)
+{
+	WorkerStart* start = (WorkerStart*)data;
+	JobSystem* system = start->system;
+	tWorkerIndex = start->index;
+	tRandomState = 0x9E3779B9u * (unsigned int)(start->index + 1);
+	delete start;
+
+	int idleCount = 0;
+	while (system->mRunning.load(std::memory_order_relaxed))
+	{
+		Job* job = system->getJob();
+		if (job != NULL)
+		{
+			system->execute(job);
+			idleCount = 0;
+		}
+		else if (++idleCount < IDLE_SPIN_COUNT)
+		{
+			SDL_Delay(0);
+		}
+		else
+		{
+			//Nothing to steal for a while, sleep until run() posts or a millisecond passes
+			system->mSleepingWorkers.fetch_add(1, std::memory_order_relaxed);
+			SDL_SemWaitTimeout(system->mWakeSemaphore, 1);
+			system->mSleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+			idleCount = 0;
+		}
+	}
+
+	return 0;
+}
+
+//Does nothing, used for parent jobs that only exist to be waited on
+static void emptyJob(Job* job, void* data)
+{
+}
+
+//Arguments for an image decode job
+struct DecodeImageData
+{
+	const char* path;
+	SDL_Surface** surface;
+};
+
+//Decodes an image into a surface, textures have to be made on the main thread afterwards
+static void decodeImageJob(Job* job, void* data)
+{
+	DecodeImageData* image = (DecodeImageData*)data;
+	*image->surface = IMG_Load(image->path);
+	if (*image->surface == NULL)
+	{
+		printf("Unable to load image %s! SDL_image Error: %s\n", image->path, IMG_GetError());
+	}
+	else
+	{
+		//Color key image
+		SDL_SetColorKey(*image->surface, SDL_TRUE, SDL_MapRGB((*image->surface)->format, 0, 0xFF, 0xFF));
+	}
+}
+
+//Moves stars and flags the ones inside the screen
+static void cullStars(int begin, int end, void* userdata)
+{
+	float offset = *(float*)userdata;
+	for (int i = begin; i < end; ++i)
+	{
+		float x = gStars[i].x + offset * gStars[i].speed;
+		x -= (float)((int)(x / (SCREEN_WIDTH * 4)) * (SCREEN_WIDTH * 4));
+		gStarPoints[i].x = (int)x - SCREEN_WIDTH;
+		gStarPoints[i].y = (int)gStars[i].y;
+		gStarVisible[i] = gStarPoints[i].x >= 0 && gStarPoints[i].x < SCREEN_WIDTH && gStarPoints[i].y >= 0 && gStarPoints[i].y < SCREEN_HEIGHT;
+	}
+}
+
+//Locked streaming texture rows shared with the blit jobs
+struct PlasmaTarget
+{
+	Uint8* pixels;
+	int pitch;
+	Uint32 time;
+};
+
+//Writes a band of rows of the animated background
+static void blitPlasmaRows(int begin, int end, void* userdata)
+{
+	PlasmaTarget* target = (PlasmaTarget*)userdata;
+	for (int y = begin; y < end; ++y)
+	{
+		Uint32* row = (Uint32*)(target->pixels + y * target->pitch);
+		for (int x = 0; x < SCREEN_WIDTH; ++x)
+		{
+			Uint32 r = (Uint32)(x + target->time / 8) & 0xFF;
+			Uint32 g = (Uint32)(y + target->time / 16) & 0xFF;
+			Uint32 b = (Uint32)((x ^ y) + target->time / 4) & 0xFF;
+			row[x] = 0xFF000000 | (r << 16) | (g << 8) | b;
+		}
+	}
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Start the shared workers before anything else so loading can use them
+		if (!gJobSystem.init())
+		{
+			printf("Warning: Not every job worker could be started!\n");
+		}
+		printf("Job system running on %d workers\n", gJobSystem.getWorkerCount());
+
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Decode both images at the same time, one child job each, and wait on the parent
+	SDL_Surface* fooSurface = NULL;
+	SDL_Surface* backgroundSurface = NULL;
+	DecodeImageData fooImage = { "Images/foo.png", &fooSurface };
+	DecodeImageData backgroundImage = { "Images/background.png", &backgroundSurface };
+
+	Job* loadJob = gJobSystem.createJob(emptyJob);
+	gJobSystem.run(gJobSystem.createJob(decodeImageJob, &fooImage, sizeof(fooImage), loadJob));
+	gJobSystem.run(gJobSystem.createJob(decodeImageJob, &backgroundImage, sizeof(backgroundImage), loadJob));
+	gJobSystem.run(loadJob);
+	gJobSystem.wait(loadJob);
+
+	//The renderer isn't thread safe, so textures are created here on the main thread
+	if (fooSurface == NULL || (gFooTexture = SDL_CreateTextureFromSurface(gRenderer, fooSurface)) == NULL)
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+	if (backgroundSurface == NULL || (gBackgroundTexture = SDL_CreateTextureFromSurface(gRenderer, backgroundSurface)) == NULL)
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+	SDL_FreeSurface(fooSurface);
+	SDL_FreeSurface(backgroundSurface);
+
+	//Create the texture the blit jobs write into
+	gStreamingTexture = SDL_CreateTexture(gRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, SCREEN_WIDTH, SCREEN_HEIGHT);
+	if (gStreamingTexture == NULL)
+	{
+		printf("Unable to create streaming texture! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+
+	//Scatter the stars over a strip four screens wide so only some of them are visible at a time
+	gStars = new Star[STAR_COUNT];
+	gStarVisible = new Uint8[STAR_COUNT];
+	gStarPoints = new SDL_Point[STAR_COUNT];
+	Uint32 seed = 12345;
+	for (int i = 0; i < STAR_COUNT; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		gStars[i].x = (float)(seed % (SCREEN_WIDTH * 4));
+		seed = seed * 1664525u + 1013904223u;
+		gStars[i].y = (float)(seed % SCREEN_HEIGHT);
+		seed = seed * 1664525u + 1013904223u;
+		gStars[i].speed = 0.5f + (seed % 100) / 50.f;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images
+	SDL_DestroyTexture(gFooTexture);
+	SDL_DestroyTexture(gBackgroundTexture);
+	SDL_DestroyTexture(gStreamingTexture);
+	gFooTexture = NULL;
+	gBackgroundTexture = NULL;
+	gStreamingTexture = NULL;
+
+	//Free star field
+	delete[] gStars;
+	delete[] gStarVisible;
+	delete[] gStarPoints;
+	gStars = NULL;
+	gStarVisible = NULL;
+	gStarPoints = NULL;
+
+	//Stop the workers
+	gJobSystem.shutdown();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Visible stars gathered for one batched draw
+			SDL_Point* visiblePoints = new SDL_Point[STAR_COUNT];
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+				}
+
+				//Fill the animated background on every core, a band of rows per job
+				void* pixels = NULL;
+				int pitch = 0;
+				if (SDL_LockTexture(gStreamingTexture, NULL, &pixels, &pitch) == 0)
+				{
+					PlasmaTarget target = { (Uint8*)pixels, pitch, SDL_GetTicks() };
+					gJobSystem.parallelFor(0, SCREEN_HEIGHT, 16, blitPlasmaRows, &target);
+					SDL_UnlockTexture(gStreamingTexture);
+				}
+
+				//Move and cull the stars in parallel, then gather the visible ones here
+				float offset = SDL_GetTicks() / 20.f;
+				gJobSystem.parallelFor(0, STAR_COUNT, 4096, cullStars, &offset);
+				int visibleCount = 0;
+				for (int i = 0; i < STAR_COUNT; ++i)
+				{
+					if (gStarVisible[i])
+					{
+						visiblePoints[visibleCount++] = gStarPoints[i];
+					}
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render CPU written background, then the loaded textures on top
+				SDL_RenderCopy(gRenderer, gStreamingTexture, NULL, NULL);
+				SDL_Rect backgroundQuad = { SCREEN_WIDTH / 4, SCREEN_HEIGHT / 4, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
+				SDL_RenderCopy(gRenderer, gBackgroundTexture, NULL, &backgroundQuad);
+				SDL_Rect fooQuad = { 240, 190, 0, 0 };
+				SDL_QueryTexture(gFooTexture, NULL, NULL, &fooQuad.w, &fooQuad.h);
+				SDL_RenderCopy(gRenderer, gFooTexture, NULL, &fooQuad);
+
+				//Render visible stars in one call
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderDrawPoints(gRenderer, visiblePoints, visibleCount);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+
+			delete[] visiblePoints;
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
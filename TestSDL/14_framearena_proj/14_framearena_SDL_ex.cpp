@@ -0,0 +1,656 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, vectors, and math
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <new>
+#include <cmath>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Bytes each frame can allocate from the arena
+const size_t FRAME_ARENA_SIZE = 1024 * 1024;
+
+//Default alignment, enough for anything SDL hands us including SSE types
+const size_t FRAME_ARENA_ALIGNMENT = 16;
+
+//Debug builds put a header in front of and a guard pattern behind every allocation,
+//which is checked when the frame ends so overruns are caught on the frame they happen
+#ifdef _DEBUG
+#define FRAME_ARENA_GUARDS 1
+const size_t FRAME_ARENA_GUARD_SIZE = 8;
+const Uint8 FRAME_ARENA_GUARD_BYTE = 0xFD;
+#endif
+
+//Sprites in the draw list at startup, space adds more
+const int INITIAL_SPRITE_COUNT = 200;
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(const std::string& path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point
+		void render(int x, int y);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Linear allocator for data that only lives for a frame or two. Allocating is a pointer bump and
+//freeing is resetting the pointer at the start of the next frame, so nothing is ever freed one by one.
+//There are two buffers so whatever was built last frame (like the draw list being presented)
+//stays valid while the next frame is built.
+class FrameArena
+{
+	public:
+		//Initializes variables
+		FrameArena();
+
+		//Deallocates buffers
+		~FrameArena();
+
+		//Allocates both buffers, each one holds a frame's worth of allocations
+		bool init(size_t bytesPerFrame);
+
+		//Deallocates buffers
+		void free();
+
+		//Returns aligned memory that stays valid until the frame after next begins, or NULL when the frame is full
+		void* allocate(size_t size, size_t alignment = FRAME_ARENA_ALIGNMENT);
+
+		//Swaps to the other buffer and throws away everything that was allocated in it two frames ago
+		void beginFrame();
+
+		//Gets bytes used by the current frame and the most any frame has used
+		size_t getUsed();
+		size_t getPeak();
+
+		//Gets bytes per frame
+		size_t getCapacity();
+
+	private:
+#ifdef FRAME_ARENA_GUARDS
+		//Walks the allocations of the current buffer and reports any with a damaged guard
+		void checkGuards();
+
+		//Sits in front of each debug allocation
+		struct AllocationHeader
+		{
+			size_t size;
+			size_t previousHeader;
+		};
+
+		//Offset of the most recent header plus one, 0 when there is none
+		size_t mLastHeader;
+#endif
+
+		//The two buffers and which one is being filled
+		Uint8* mBuffers[2];
+		int mCurrent;
+
+		//Bump offset into the current buffer
+		size_t mOffset;
+
+		//Size of each buffer
+		size_t mCapacity;
+
+		//High-water mark over all frames
+		size_t mPeak;
+};
+
+//Allocator adapter so STL containers can live in the frame arena. Deallocation does nothing,
+//the memory comes back when the arena resets, so these containers must not outlive the frame.
+template <typename T>
+class FrameAllocator
+{
+	public:
+		typedef T value_type;
+
+		//Binds the allocator to an arena
+		FrameAllocator(FrameArena* arena) : mArena(arena) {}
+
+		//Rebinding constructor the containers use for their internal node types
+		template <typename U>
+		FrameAllocator(const FrameAllocator<U>& other) : mArena(other.getArena()) {}
+
+		//Takes memory from the arena, throws like operator new when the frame is out of space
+		T* allocate(size_t count)
+		{
+			void* memory = mArena->allocate(count * sizeof(T), SDL_max(sizeof(void*), alignof(T)));
+			if (memory == NULL)
+			{
+				throw std::bad_alloc();
+			}
+			return (T*)memory;
+		}
+
+		//Nothing to do, see above
+		void deallocate(T* pointer, size_t count) {}
+
+		//Gets arena this allocator takes from
+		FrameArena* getArena() const { return mArena; }
+
+	private:
+		FrameArena* mArena;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b) { return a.getArena() == b.getArena(); }
+
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b) { return a.getArena() != b.getArena(); }
+
+//One sprite to draw this frame
+struct DrawCommand
+{
+	LTexture* texture;
+	int x;
+	int y;
+};
+
+//Per frame containers
+typedef std::vector<SDL_Event, FrameAllocator<SDL_Event> > FrameEventList;
+typedef std::vector<DrawCommand, FrameAllocator<DrawCommand> > FrameDrawList;
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+
+//Transient frame data lives here
+FrameArena gFrameArena;
+
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(const std::string& path) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL_Image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else {
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else {
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+// implementation of FrameArena class
+FrameArena::FrameArena()
+{
+	//Initialize
+	mBuffers[0] = NULL;
+	mBuffers[1] = NULL;
+	mCurrent = 0;
+	mOffset = 0;
+	mCapacity = 0;
+	mPeak = 0;
+#ifdef FRAME_ARENA_GUARDS
+	mLastHeader = 0;
+#endif
+}
+
+FrameArena::~FrameArena()
+{
+	//Deallocate
+	free();
+}
+
+bool FrameArena::init(size_t bytesPerFrame)
+{
+	//Get rid of preexisting buffers
+	free();
+
+	mBuffers[0] = (Uint8*)SDL_malloc(bytesPerFrame);
+	mBuffers[1] = (Uint8*)SDL_malloc(bytesPerFrame);
+	if (mBuffers[0] == NULL || mBuffers[1] == NULL)
+	{
+		printf("Unable to allocate %u byte frame arena!\n", (unsigned)bytesPerFrame);
+		free();
+		return false;
+	}
+
+	mCapacity = bytesPerFrame;
+	return true;
+}
+
+void FrameArena::free()
+{
+	SDL_free(mBuffers[0]);
+	SDL_free(mBuffers[1]);
+	mBuffers[0] = NULL;
+	mBuffers[1] = NULL;
+	mCurrent = 0;
+	mOffset = 0;
+	mCapacity = 0;
+#ifdef FRAME_ARENA_GUARDS
+	mLastHeader = 0;
+#endif
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+	size_t start = mOffset;
+
+#ifdef FRAME_ARENA_GUARDS
+	//Leave room for the header right in front of the aligned block
+	start += sizeof(AllocationHeader);
+#endif
+
+	//Round the address up to the alignment, which has to be a power of two
+	size_t base = (size_t)mBuffers[mCurrent];
+	start = ((base + start + alignment - 1) & ~(alignment - 1)) - base;
+	size_t end = start + size;
+
+#ifdef FRAME_ARENA_GUARDS
+	end += FRAME_ARENA_GUARD_SIZE;
+#endif
+
+	if (mBuffers[mCurrent] == NULL || end > mCapacity)
+	{
+		//Callers are expected to recover from NULL, so this only reports
+		printf("Frame arena out of memory! %u of %u bytes used, %u more requested\n", (unsigned)mOffset, (unsigned)mCapacity, (unsigned)size);
+		return NULL;
+	}
+
+	Uint8* memory = mBuffers[mCurrent] + start;
+
+#ifdef FRAME_ARENA_GUARDS
+	//Chain the headers backwards so checkGuards() can find every allocation
+	size_t headerOffset = start - sizeof(AllocationHeader);
+	AllocationHeader* header = (AllocationHeader*)(mBuffers[mCurrent] + headerOffset);
+	header->size = size;
+	header->previousHeader = mLastHeader;
+	mLastHeader = headerOffset + 1;
+	SDL_memset(memory + size, FRAME_ARENA_GUARD_BYTE, FRAME_ARENA_GUARD_SIZE);
+#endif
+
+	mOffset = end;
+	if (mOffset > mPeak)
+	{
+		mPeak = mOffset;
+	}
+
+	return memory;
+}
+
+void FrameArena::beginFrame()
+{
+#ifdef FRAME_ARENA_GUARDS
+	//Anything that overran its block last frame is reported before the memory is reused
+	checkGuards();
+	mLastHeader = 0;
+#endif
+
+	//The buffer we switch to held the frame before last, nothing can still be using it
+	mCurrent = 1 - mCurrent;
+	mOffset = 0;
+}
+
+#ifdef FRAME_ARENA_GUARDS
+void FrameArena::checkGuards()
+{
+	size_t headerOffset = mLastHeader;
+	while (headerOffset != 0)
+	{
+		//allocate() puts each header right in front of its block and the guard right behind it
+		AllocationHeader* header = (AllocationHeader*)(mBuffers[mCurrent] + headerOffset - 1);
+		Uint8* memory = (Uint8*)(header + 1);
+		Uint8* guard = memory + header->size;
+		for (size_t i = 0; i < FRAME_ARENA_GUARD_SIZE; ++i)
+		{
+			if (guard[i] != FRAME_ARENA_GUARD_BYTE)
+			{
+				printf("Frame arena overrun! A %u byte block at offset %u was written past its end\n", (unsigned)header->size, (unsigned)(memory - mBuffers[mCurrent]));
+				SDL_assert(guard[i] == FRAME_ARENA_GUARD_BYTE);
+				break;
+			}
+		}
+
+		headerOffset = header->previousHeader;
+	}
+}
+#endif
+
+size_t FrameArena::getUsed()
+{
+	return mOffset;
+}
+
+size_t FrameArena::getPeak()
+{
+	return mPeak;
+}
+
+size_t FrameArena::getCapacity()
+{
+	return mCapacity;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+
+		//Create the frame arena
+		if (!gFrameArena.init(FRAME_ARENA_SIZE))
+		{
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' texture
+	if (!gFooTexture.loadFromFile("Images/foo.png"))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Load background texture
+	if (!gBackgroundTexture.loadFromFile("Images/background.png"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Report how much of the arena we needed so FRAME_ARENA_SIZE can be tuned
+	printf("Frame arena peak usage: %u of %u bytes\n", (unsigned)gFrameArena.getPeak(), (unsigned)gFrameArena.getCapacity());
+	gFrameArena.free();
+
+	//Free loaded images
+	gFooTexture.free();
+	gBackgroundTexture.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Number of sprites in the draw list
+			int spriteCount = INITIAL_SPRITE_COUNT;
+
+			//Whether the current cap has been printed, reset when Space asks for more
+			bool capReported = false;
+
+			//While application is running
+			while (!quit)
+			{
+				//Everything from the frame before last goes away here
+				gFrameArena.beginFrame();
+				FrameAllocator<char> frameAllocator(&gFrameArena);
+
+				//Gather this frame's events first so every system sees the same list
+				FrameEventList events(frameAllocator);
+				while (SDL_PollEvent(&e) != 0)
+				{
+					events.push_back(e);
+				}
+
+				//Handle events
+				for (size_t i = 0; i < events.size(); ++i)
+				{
+					//User requests quit
+					if (events[i].type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					//Space doubles the sprites so arena growth is easy to watch
+					else if (events[i].type == SDL_KEYDOWN && events[i].key.keysym.sym == SDLK_SPACE)
+					{
+						spriteCount *= 2;
+						capReported = false;
+					}
+				}
+
+				//Split the screen into viewports like in the viewports lesson, the rects are frame data too
+				SDL_Rect* viewports = (SDL_Rect*)gFrameArena.allocate(sizeof(SDL_Rect) * 2);
+				if (viewports == NULL)
+				{
+					break;
+				}
+				SDL_Rect topViewport = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT / 2 };
+				SDL_Rect bottomViewport = { 0, SCREEN_HEIGHT / 2, SCREEN_WIDTH, SCREEN_HEIGHT / 2 };
+				viewports[0] = topViewport;
+				viewports[1] = bottomViewport;
+
+				//Build the draw list
+				FrameDrawList drawList(frameAllocator);
+				try
+				{
+					drawList.reserve(spriteCount);
+					float time = SDL_GetTicks() / 1000.f;
+					for (int i = 0; i < spriteCount; ++i)
+					{
+						DrawCommand command;
+						command.texture = &gFooTexture;
+						command.x = (int)(SCREEN_WIDTH / 2 + std::cos(time + i * 0.37f) * (SCREEN_WIDTH / 2 - 32)) - gFooTexture.getWidth() / 2;
+						command.y = (int)(SCREEN_HEIGHT / 4 + std::sin(time * 1.3f + i * 0.11f) * (SCREEN_HEIGHT / 4 - 32)) - gFooTexture.getHeight() / 2;
+						drawList.push_back(command);
+					}
+				}
+				catch (const std::bad_alloc&)
+				{
+					//Out of frame memory, shrink to what the rest of the arena can hold but keep drawing something.
+					//The cap only takes effect next frame, this one shows whatever made it into the list.
+					int fit = (int)((gFrameArena.getCapacity() - gFrameArena.getUsed()) / sizeof(DrawCommand));
+					spriteCount = SDL_max(SDL_min(spriteCount / 2, fit), 1);
+					if (!capReported)
+					{
+						printf("Draw list capped at %d sprites\n", spriteCount);
+						capReported = true;
+					}
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render background and sprites into both viewports
+				for (int v = 0; v < 2; ++v)
+				{
+					SDL_RenderSetViewport(gRenderer, &viewports[v]);
+					gBackgroundTexture.render(0, 0);
+					for (size_t i = 0; i < drawList.size(); ++i)
+					{
+						drawList[i].texture->render(drawList[i].x, drawList[i].y);
+					}
+				}
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,804 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, vectors, and atomics
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <atomic>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Subsystems allocations get charged to. Anything SDL allocates outside a MemoryScope lands in MEMORY_TAG_SDL.
+//MEMORY_TAG_GPU_TEXTURES isn't heap memory, it's the estimated size of texture storage owned by the renderer.
+enum MemoryTag
+{
+	MEMORY_TAG_SDL,
+	MEMORY_TAG_WINDOW,
+	MEMORY_TAG_RENDERER,
+	MEMORY_TAG_SURFACES,
+	MEMORY_TAG_TEXTURES,
+	MEMORY_TAG_GPU_TEXTURES,
+	MEMORY_TAG_TOTAL
+};
+
+//Names used in reports, in MemoryTag order
+const char* MEMORY_TAG_NAMES[MEMORY_TAG_TOTAL] = { "sdl", "window", "renderer", "surfaces", "textures", "gpu textures" };
+
+//Assets that can be told apart in reports, asset 0 collects allocations made without one
+const int MAX_TRACKED_ASSETS = 256;
+
+//Every tracked block starts with this, 16 bytes keeps the user pointer as aligned as malloc's
+union MemoryHeader
+{
+	struct
+	{
+		size_t size;
+		Uint16 tag;
+		Uint16 asset;
+		Uint32 magic;
+	} info;
+	Uint8 padding[16];
+};
+
+//Marks blocks that went through trackingMalloc so stray frees are caught
+const Uint32 MEMORY_HEADER_MAGIC = 0x4D454D54;
+
+//Running totals for one tag or asset
+struct MemoryCounters
+{
+	std::atomic<long long> liveBytes;
+	std::atomic<long long> peakBytes;
+	std::atomic<long long> allocations;
+	std::atomic<long long> frees;
+	std::atomic<long long> frameAllocations;
+	long long lastFrameAllocations;
+};
+
+//Copy of a MemoryCounters that is safe to hand out
+struct MemoryStats
+{
+	long long liveBytes;
+	long long peakBytes;
+	long long allocations;
+	long long frees;
+	long long lastFrameAllocations;
+};
+
+//Charges every allocation made on this thread while it is alive to the given tag and asset
+class MemoryScope
+{
+	public:
+		//Sets the current tag and asset
+		MemoryScope(MemoryTag tag, const std::string& asset = "");
+
+		//Restores the previous tag and asset
+		~MemoryScope();
+
+	private:
+		int mPreviousTag;
+		int mPreviousAsset;
+};
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point
+		void render(int x, int y);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Routes SDL's allocations through the tracking functions, has to run before any other SDL call
+bool initMemoryTracking();
+
+//Rolls the per frame allocation counts over, call once per frame
+void beginMemoryFrame();
+
+//Gets a snapshot of a tag's counters
+MemoryStats getMemoryStats(MemoryTag tag);
+
+//Prints live/peak bytes and allocation counts for every tag and asset
+void printMemoryReport();
+
+//Records a texture created for an asset and charges its estimated size to MEMORY_TAG_GPU_TEXTURES
+void trackTexture(SDL_Texture* texture, const std::string& asset);
+
+//Forgets a texture, call right before destroying it
+void untrackTexture(SDL_Texture* texture);
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Loads individual image as surface
+SDL_Surface* loadSurface(std::string path);
+
+//Loads individual image as texture
+SDL_Texture* loadTexture(std::string path);
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+SDL_Texture* gViewportTexture = NULL;
+
+//Kept around on the CPU to show up in the surface numbers
+SDL_Surface* gViewportSurface = NULL;
+
+//Allocator SDL was using before we hooked it
+SDL_malloc_func gOriginalMalloc = NULL;
+SDL_calloc_func gOriginalCalloc = NULL;
+SDL_realloc_func gOriginalRealloc = NULL;
+SDL_free_func gOriginalFree = NULL;
+
+//Counters per tag and per asset
+MemoryCounters gTagCounters[MEMORY_TAG_TOTAL];
+MemoryCounters gAssetCounters[MAX_TRACKED_ASSETS];
+MemoryCounters gAssetTextureCounters[MAX_TRACKED_ASSETS];
+
+//Asset names, index 0 is the catch-all. Only the main thread registers names.
+std::string gAssetNames[MAX_TRACKED_ASSETS];
+int gAssetCount = 1;
+
+//Live textures and what they were charged as
+struct TextureRecord
+{
+	SDL_Texture* texture;
+	int asset;
+	long long bytes;
+};
+std::vector<TextureRecord> gTextureRecords;
+
+//Tag and asset new allocations on this thread are charged to
+static thread_local int tMemoryTag = MEMORY_TAG_SDL;
+static thread_local int tMemoryAsset = 0;
+
+
+//Raises peak to value if it is higher, other threads may be doing the same
+static void updatePeak(std::atomic<long long>& peak, long long value)
+{
+	long long current = peak.load(std::memory_order_relaxed);
+	while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+	{
+	}
+}
+
+//Adds a block to its tag and asset
+static void countAllocation(int tag, int asset, long long size)
+{
+	MemoryCounters& counters = gTagCounters[tag];
+	updatePeak(counters.peakBytes, counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+	counters.allocations.fetch_add(1, std::memory_order_relaxed);
+	counters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+
+	MemoryCounters& assetCounters = gAssetCounters[asset];
+	updatePeak(assetCounters.peakBytes, assetCounters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+	assetCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+//Removes a block from its tag and asset
+static void countFree(int tag, int asset, long long size)
+{
+	gTagCounters[tag].liveBytes.fetch_sub(size, std::memory_order_relaxed);
+	gTagCounters[tag].frees.fetch_add(1, std::memory_order_relaxed);
+	gAssetCounters[asset].liveBytes.fetch_sub(size, std::memory_order_relaxed);
+	gAssetCounters[asset].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void* SDLCALL trackingMalloc(size_t size)
+{
+	MemoryHeader* header = (MemoryHeader*)gOriginalMalloc(size + sizeof(MemoryHeader));
+	if (header == NULL)
+	{
+		return NULL;
+	}
+
+	header->info.size = size;
+	header->info.tag = (Uint16)tMemoryTag;
+	header->info.asset = (Uint16)tMemoryAsset;
+	header->info.magic = MEMORY_HEADER_MAGIC;
+	countAllocation(tMemoryTag, tMemoryAsset, (long long)size);
+
+	return header + 1;
+}
+
+static void* SDLCALL trackingCalloc(size_t count, size_t size)
+{
+	//Refuse sizes that would overflow, like calloc does
+	if (size != 0 && count > ((size_t)-1 - sizeof(MemoryHeader)) / size)
+	{
+		return NULL;
+	}
+
+	void* memory = trackingMalloc(count * size);
+	if (memory != NULL)
+	{
+		SDL_memset(memory, 0, count * size);
+	}
+	return memory;
+}
+
+static void SDLCALL trackingFree(void* memory)
+{
+	if (memory == NULL)
+	{
+		return;
+	}
+
+	MemoryHeader* header = (MemoryHeader*)memory - 1;
+	SDL_assert(header->info.magic == MEMORY_HEADER_MAGIC);
+	header->info.magic = 0;
+	countFree(header->info.tag, header->info.asset, (long long)header->info.size);
+
+	gOriginalFree(header);
+}
+
+static void* SDLCALL trackingRealloc(void* memory, size_t size)
+{
+	if (memory == NULL)
+	{
+		return trackingMalloc(size);
+	}
+
+	//A resized block stays charged to whoever allocated it first
+	MemoryHeader* header = (MemoryHeader*)memory - 1;
+	SDL_assert(header->info.magic == MEMORY_HEADER_MAGIC);
+	int tag = header->info.tag;
+	int asset = header->info.asset;
+	size_t oldSize = header->info.size;
+
+	MemoryHeader* newHeader = (MemoryHeader*)gOriginalRealloc(header, size + sizeof(MemoryHeader));
+	if (newHeader == NULL)
+	{
+		return NULL;
+	}
+
+	newHeader->info.size = size;
+	countFree(tag, asset, (long long)oldSize);
+	countAllocation(tag, asset, (long long)size);
+
+	return newHeader + 1;
+}
+
+bool initMemoryTracking()
+{
+	gAssetNames[0] = "(untagged)";
+
+#if SDL_VERSION_ATLEAST(2, 0, 7)
+	//Blocks allocated before this point would be freed through trackingFree without a header,
+	//which is why SDL wants this to be the very first call
+	if (SDL_GetNumAllocations() > 0)
+	{
+		printf("Warning: SDL allocated memory before tracking started, not hooking allocator!\n");
+		return false;
+	}
+
+	SDL_GetMemoryFunctions(&gOriginalMalloc, &gOriginalCalloc, &gOriginalRealloc, &gOriginalFree);
+	if (SDL_SetMemoryFunctions(trackingMalloc, trackingCalloc, trackingRealloc, trackingFree) < 0)
+	{
+		printf("Unable to hook SDL memory functions! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+	return true;
+#else
+	printf("Warning: SDL_SetMemoryFunctions needs SDL 2.0.7, heap memory won't be tracked!\n");
+	return false;
+#endif
+}
+
+//Finds or registers an asset name
+static int findAsset(const std::string& asset)
+{
+	if (asset.empty())
+	{
+		return 0;
+	}
+
+	for (int i = 1; i < gAssetCount; ++i)
+	{
+		if (gAssetNames[i] == asset)
+		{
+			return i;
+		}
+	}
+
+	//Out of slots, charge it to the catch-all
+	if (gAssetCount == MAX_TRACKED_ASSETS)
+	{
+		return 0;
+	}
+
+	gAssetNames[gAssetCount] = asset;
+	return gAssetCount++;
+}
+
+// implementation of MemoryScope class
+MemoryScope::MemoryScope(MemoryTag tag, const std::string& asset)
+{
+	mPreviousTag = tMemoryTag;
+	mPreviousAsset = tMemoryAsset;
+
+	//Look the asset up before switching tags so registering it isn't charged to the asset itself
+	int assetIndex = asset.empty() ? mPreviousAsset : findAsset(asset);
+	tMemoryTag = tag;
+	tMemoryAsset = assetIndex;
+}
+
+MemoryScope::~MemoryScope()
+{
+	tMemoryTag = mPreviousTag;
+	tMemoryAsset = mPreviousAsset;
+}
+
+void beginMemoryFrame()
+{
+	for (int i = 0; i < MEMORY_TAG_TOTAL; ++i)
+	{
+		gTagCounters[i].lastFrameAllocations = gTagCounters[i].frameAllocations.exchange(0, std::memory_order_relaxed);
+	}
+}
+
+MemoryStats getMemoryStats(MemoryTag tag)
+{
+	MemoryStats stats;
+	stats.liveBytes = gTagCounters[tag].liveBytes.load(std::memory_order_relaxed);
+	stats.peakBytes = gTagCounters[tag].peakBytes.load(std::memory_order_relaxed);
+	stats.allocations = gTagCounters[tag].allocations.load(std::memory_order_relaxed);
+	stats.frees = gTagCounters[tag].frees.load(std::memory_order_relaxed);
+	stats.lastFrameAllocations = gTagCounters[tag].lastFrameAllocations;
+	return stats;
+}
+
+void printMemoryReport()
+{
+	printf("%-14s %12s %12s %10s %10s %12s\n", "tag", "live bytes", "peak bytes", "allocs", "frees", "last frame");
+	long long heapLive = 0;
+	for (int i = 0; i < MEMORY_TAG_TOTAL; ++i)
+	{
+		MemoryStats stats = getMemoryStats((MemoryTag)i);
+		printf("%-14s %12lld %12lld %10lld %10lld %12lld\n", MEMORY_TAG_NAMES[i], stats.liveBytes, stats.peakBytes, stats.allocations, stats.frees, stats.lastFrameAllocations);
+		if (i != MEMORY_TAG_GPU_TEXTURES)
+		{
+			heapLive += stats.liveBytes;
+		}
+	}
+	printf("%-14s %12lld\n", "heap total", heapLive);
+
+	printf("%-28s %12s %12s %12s %12s\n", "asset", "heap live", "heap peak", "gpu live", "gpu peak");
+	for (int i = 0; i < gAssetCount; ++i)
+	{
+		printf("%-28s %12lld %12lld %12lld %12lld\n", gAssetNames[i].c_str(),
+			gAssetCounters[i].liveBytes.load(), gAssetCounters[i].peakBytes.load(),
+			gAssetTextureCounters[i].liveBytes.load(), gAssetTextureCounters[i].peakBytes.load());
+	}
+}
+
+void trackTexture(SDL_Texture* texture, const std::string& asset)
+{
+	if (texture == NULL)
+	{
+		return;
+	}
+
+	//The renderer doesn't tell us what it really allocated, width * height * bytes per pixel is the best estimate
+	Uint32 format = 0;
+	int width = 0;
+	int height = 0;
+	SDL_QueryTexture(texture, &format, NULL, &width, &height);
+	int bytesPerPixel = SDL_BYTESPERPIXEL(format) > 0 ? SDL_BYTESPERPIXEL(format) : 4;
+
+	TextureRecord record;
+	record.texture = texture;
+	record.asset = findAsset(asset);
+	record.bytes = (long long)width * height * bytesPerPixel;
+	gTextureRecords.push_back(record);
+
+	MemoryCounters& counters = gTagCounters[MEMORY_TAG_GPU_TEXTURES];
+	updatePeak(counters.peakBytes, counters.liveBytes.fetch_add(record.bytes) + record.bytes);
+	counters.allocations.fetch_add(1);
+	counters.frameAllocations.fetch_add(1);
+
+	MemoryCounters& assetCounters = gAssetTextureCounters[record.asset];
+	updatePeak(assetCounters.peakBytes, assetCounters.liveBytes.fetch_add(record.bytes) + record.bytes);
+	assetCounters.allocations.fetch_add(1);
+}
+
+void untrackTexture(SDL_Texture* texture)
+{
+	for (size_t i = 0; i < gTextureRecords.size(); ++i)
+	{
+		if (gTextureRecords[i].texture == texture)
+		{
+			gTagCounters[MEMORY_TAG_GPU_TEXTURES].liveBytes.fetch_sub(gTextureRecords[i].bytes);
+			gTagCounters[MEMORY_TAG_GPU_TEXTURES].frees.fetch_add(1);
+			gAssetTextureCounters[gTextureRecords[i].asset].liveBytes.fetch_sub(gTextureRecords[i].bytes);
+			gAssetTextureCounters[gTextureRecords[i].asset].frees.fetch_add(1);
+
+			gTextureRecords[i] = gTextureRecords.back();
+			gTextureRecords.pop_back();
+			return;
+		}
+	}
+}
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path
+	SDL_Surface* loadedSurface = loadSurface(path);
+	if (loadedSurface != NULL) {
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels, whatever the renderer allocates on the heap is charged to the asset
+		{
+			MemoryScope scope(MEMORY_TAG_TEXTURES, path);
+			newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		}
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else {
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+			trackTexture(newTexture, path);
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		untrackTexture(mTexture);
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+SDL_Surface* loadSurface(std::string path)
+{
+	//Pixels and format of the surface are charged to the image they came from.
+	//Decoder scratch memory from libpng doesn't go through SDL_malloc and isn't seen here.
+	MemoryScope scope(MEMORY_TAG_SURFACES, path);
+
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL)
+	{
+		printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+
+	return loadedSurface;
+}
+
+SDL_Texture* loadTexture(std::string path)
+{
+	//The final texture
+	SDL_Texture* newTexture = NULL;
+
+	//Load image at specified path
+	SDL_Surface* loadedSurface = loadSurface(path);
+	if (loadedSurface != NULL)
+	{
+		//Create texture from surface pixels
+		{
+			MemoryScope scope(MEMORY_TAG_TEXTURES, path);
+			newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		}
+		if (newTexture == NULL)
+		{
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else
+		{
+			trackTexture(newTexture, path);
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	return newTexture;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		{
+			MemoryScope scope(MEMORY_TAG_WINDOW);
+			gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		}
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			{
+				MemoryScope scope(MEMORY_TAG_RENDERER);
+				gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
+			}
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' texture
+	if (!gFooTexture.loadFromFile("Images/foo.png"))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Load background texture
+	if (!gBackgroundTexture.loadFromFile("Images/background.png"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	//Load viewport texture
+	gViewportTexture = loadTexture("Images/viewport.png");
+	if (gViewportTexture == NULL)
+	{
+		printf("Failed to load viewport texture image!\n");
+		success = false;
+	}
+
+	//Keep a CPU copy of the viewport image too
+	gViewportSurface = loadSurface("Images/viewport.png");
+	if (gViewportSurface == NULL)
+	{
+		printf("Failed to load viewport surface image!\n");
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images
+	gFooTexture.free();
+	gBackgroundTexture.free();
+	untrackTexture(gViewportTexture);
+	SDL_DestroyTexture(gViewportTexture);
+	gViewportTexture = NULL;
+	SDL_FreeSurface(gViewportSurface);
+	gViewportSurface = NULL;
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Anything still live here is a leak or memory SDL keeps until SDL_Quit
+	printf("Memory at exit:\n");
+	printMemoryReport();
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Hook the allocator before SDL gets a chance to allocate anything
+	initMemoryTracking();
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			printf("Memory after loading:\n");
+			printMemoryReport();
+
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Next time the window title gets the current numbers
+			Uint32 nextTitleUpdate = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				beginMemoryFrame();
+
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					//F1 dumps the full report
+					else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F1)
+					{
+						printMemoryReport();
+					}
+				}
+
+				//Show heap and texture memory in the title once a second
+				if (SDL_GetTicks() >= nextTitleUpdate)
+				{
+					long long heapLive = 0;
+					long long frameAllocations = 0;
+					for (int i = 0; i < MEMORY_TAG_TOTAL; ++i)
+					{
+						if (i != MEMORY_TAG_GPU_TEXTURES)
+						{
+							MemoryStats stats = getMemoryStats((MemoryTag)i);
+							heapLive += stats.liveBytes;
+							frameAllocations += stats.lastFrameAllocations;
+						}
+					}
+					MemoryStats textures = getMemoryStats(MEMORY_TAG_GPU_TEXTURES);
+
+					char title[128];
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - heap %lld KB, textures %lld KB, %lld allocs/frame", heapLive / 1024, textures.liveBytes / 1024, frameAllocations);
+					SDL_SetWindowTitle(gWindow, title);
+					nextTitleUpdate = SDL_GetTicks() + 1000;
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render background texture to screen
+				gBackgroundTexture.render(0, 0);
+
+				//Render viewport texture in the corner
+				SDL_Rect viewportQuad = { SCREEN_WIDTH * 3 / 4, 0, SCREEN_WIDTH / 4, SCREEN_HEIGHT / 4 };
+				SDL_RenderCopy(gRenderer, gViewportTexture, NULL, &viewportQuad);
+
+				//Render Foo' to the screen
+				gFooTexture.render(240, 190);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
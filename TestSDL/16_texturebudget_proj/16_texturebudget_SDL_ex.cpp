@@ -0,0 +1,708 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Texture memory allowed by default, enough for two full screen images and Foo'
+const size_t DEFAULT_TEXTURE_BUDGET = 2560 * 1024;
+
+//Number of full screen images the scene cycles through
+const int TOTAL_ROOMS = 4;
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path, the texture can be evicted and will be reloaded when rendered
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point, reloading it first if it was evicted
+		void render(int x, int y);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+		//Destroys the hardware texture but keeps what's needed to bring it back
+		void evict();
+
+		//Recreates the hardware texture from the cached file or from disk
+		bool reload();
+
+		//Whether the hardware texture currently exists
+		bool isResident();
+
+		//Estimated texture memory while resident
+		size_t getBytes();
+
+		//Frame the texture was last rendered in
+		Uint32 getLastUsedFrame();
+
+		//Bytes of the cached compressed file
+		size_t getSourceBytes();
+
+	private:
+		//Decodes the image and creates the hardware texture
+		bool createTexture();
+
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+
+		//Where the image came from and its file contents, mSource is empty when sources aren't cached
+		std::string mPath;
+		std::vector<Uint8> mSource;
+
+		//Estimated texture memory and when it was last drawn
+		size_t mBytes;
+		Uint32 mLastUsedFrame;
+};
+
+//Keeps resident texture memory under a budget by evicting the least recently rendered textures
+class TextureResidency
+{
+	public:
+		//Initializes variables
+		TextureResidency();
+
+		//Sets the byte budget, evicting right away if it shrank
+		void setBudget(size_t bytes);
+		size_t getBudget();
+
+		//Whether loadFromFile keeps a copy of the compressed file so reloads skip the disk
+		void setCacheSources(bool cacheSources);
+		bool getCacheSources();
+
+		//Starts tracking a texture, called by LTexture
+		void add(LTexture* texture);
+
+		//Stops tracking a texture, called by LTexture
+		void remove(LTexture* texture);
+
+		//Advances the frame counter, call once per frame before rendering
+		void beginFrame();
+		Uint32 getFrame();
+
+		//Makes room for a texture of the given size, never evicting anything rendered this frame
+		void reserve(size_t bytes);
+
+		//Bookkeeping for textures that became resident or were evicted
+		void onResident(LTexture* texture);
+		void onEvicted(LTexture* texture);
+		void onFreed(LTexture* texture);
+
+		//Statistics
+		size_t getResidentBytes();
+		size_t getSourceBytes();
+		int getEvictionCount();
+		int getReloadCount();
+		void onReload();
+
+	private:
+		//Every texture that can be evicted
+		std::vector<LTexture*> mTextures;
+
+		//Budget and what's resident right now
+		size_t mBudget;
+		size_t mResidentBytes;
+
+		//Current frame, starts at 1 so textures that were never rendered are oldest
+		Uint32 mFrame;
+
+		//Whether compressed files are kept in memory
+		bool mCacheSources;
+
+		//Whether going over budget has been reported already
+		bool mReportedOverBudget;
+
+		//Statistics
+		int mEvictionCount;
+		int mReloadCount;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Reads a whole file into memory
+bool loadFile(std::string path, std::vector<Uint8>& data);
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//The residency manager every LTexture registers with
+TextureResidency gTextureResidency;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gRoomTextures[TOTAL_ROOMS];
+
+//Files for each room
+const char* ROOM_PATHS[TOTAL_ROOMS] = { "Images/background.png", "Images/loaded.png", "Images/texture.png", "Images/viewport.png" };
+
+
+bool loadFile(std::string path, std::vector<Uint8>& data)
+{
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == NULL)
+	{
+		printf("Unable to open %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return false;
+	}
+
+	Sint64 size = SDL_RWsize(file);
+	bool success = size > 0;
+	if (success)
+	{
+		data.resize((size_t)size);
+		success = SDL_RWread(file, &data[0], 1, (size_t)size) == (size_t)size;
+	}
+	if (!success)
+	{
+		printf("Unable to read %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		data.clear();
+	}
+
+	SDL_RWclose(file);
+	return success;
+}
+
+// implementation of TextureResidency class
+TextureResidency::TextureResidency()
+{
+	mBudget = DEFAULT_TEXTURE_BUDGET;
+	mResidentBytes = 0;
+	mFrame = 1;
+	mCacheSources = true;
+	mReportedOverBudget = false;
+	mEvictionCount = 0;
+	mReloadCount = 0;
+}
+
+void TextureResidency::setBudget(size_t bytes)
+{
+	mBudget = bytes;
+	mReportedOverBudget = false;
+	reserve(0);
+}
+
+size_t TextureResidency::getBudget()
+{
+	return mBudget;
+}
+
+void TextureResidency::setCacheSources(bool cacheSources)
+{
+	mCacheSources = cacheSources;
+}
+
+bool TextureResidency::getCacheSources()
+{
+	return mCacheSources;
+}
+
+void TextureResidency::add(LTexture* texture)
+{
+	mTextures.push_back(texture);
+}
+
+void TextureResidency::remove(LTexture* texture)
+{
+	for (size_t i = 0; i < mTextures.size(); ++i)
+	{
+		if (mTextures[i] == texture)
+		{
+			mTextures[i] = mTextures.back();
+			mTextures.pop_back();
+			return;
+		}
+	}
+}
+
+void TextureResidency::beginFrame()
+{
+	++mFrame;
+}
+
+Uint32 TextureResidency::getFrame()
+{
+	return mFrame;
+}
+
+void TextureResidency::reserve(size_t bytes)
+{
+	while (mResidentBytes + bytes > mBudget)
+	{
+		//Find the resident texture that went longest without being rendered
+		LTexture* oldest = NULL;
+		for (size_t i = 0; i < mTextures.size(); ++i)
+		{
+			LTexture* texture = mTextures[i];
+			if (texture->isResident() && texture->getLastUsedFrame() < mFrame && (oldest == NULL || texture->getLastUsedFrame() < oldest->getLastUsedFrame()))
+			{
+				oldest = texture;
+			}
+		}
+
+		//Everything left was drawn this frame, evicting it would only make us reload it next frame
+		if (oldest == NULL)
+		{
+			if (!mReportedOverBudget)
+			{
+				printf("Warning: frame needs %u KB of textures, over the %u KB budget!\n", (unsigned)((mResidentBytes + bytes) / 1024), (unsigned)(mBudget / 1024));
+				mReportedOverBudget = true;
+			}
+			return;
+		}
+
+		oldest->evict();
+	}
+}
+
+void TextureResidency::onResident(LTexture* texture)
+{
+	mResidentBytes += texture->getBytes();
+}
+
+void TextureResidency::onEvicted(LTexture* texture)
+{
+	mResidentBytes -= texture->getBytes();
+	++mEvictionCount;
+}
+
+void TextureResidency::onFreed(LTexture* texture)
+{
+	mResidentBytes -= texture->getBytes();
+}
+
+size_t TextureResidency::getResidentBytes()
+{
+	return mResidentBytes;
+}
+
+size_t TextureResidency::getSourceBytes()
+{
+	size_t bytes = 0;
+	for (size_t i = 0; i < mTextures.size(); ++i)
+	{
+		bytes += mTextures[i]->getSourceBytes();
+	}
+	return bytes;
+}
+
+int TextureResidency::getEvictionCount()
+{
+	return mEvictionCount;
+}
+
+int TextureResidency::getReloadCount()
+{
+	return mReloadCount;
+}
+
+void TextureResidency::onReload()
+{
+	++mReloadCount;
+}
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+	mBytes = 0;
+	mLastUsedFrame = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path) {
+	//Get rid of preexisting texture
+	free();
+
+	//Keep the compressed file around so reloading doesn't touch the disk
+	mPath = path;
+	if (gTextureResidency.getCacheSources() && !loadFile(path, mSource))
+	{
+		mPath.clear();
+		return false;
+	}
+
+	if (!createTexture())
+	{
+		mPath.clear();
+		mSource.clear();
+		return false;
+	}
+
+	//Not rendered yet, among textures that never were the earliest loaded goes first
+	mLastUsedFrame = 0;
+	gTextureResidency.add(this);
+	gTextureResidency.onResident(this);
+	return true;
+}
+
+bool LTexture::createTexture() {
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image from the cached file if there is one, from disk otherwise
+	SDL_Surface* loadedSurface = NULL;
+	if (!mSource.empty())
+	{
+		loadedSurface = IMG_Load_RW(SDL_RWFromConstMem(&mSource[0], (int)mSource.size()), 1);
+	}
+	else
+	{
+		loadedSurface = IMG_Load(mPath.c_str());
+	}
+
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL_image Error: %s\n", mPath.c_str(), IMG_GetError());
+	}
+	else {
+		//Make room before the new texture is created
+		size_t bytes = (size_t)loadedSurface->w * loadedSurface->h * 4;
+		gTextureResidency.reserve(bytes);
+
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", mPath.c_str(), SDL_GetError());
+		}
+		else {
+			//Get image dimensions and estimated size
+			Uint32 format = 0;
+			SDL_QueryTexture(newTexture, &format, NULL, &mWidth, &mHeight);
+			mBytes = (size_t)mWidth * mHeight * (SDL_BYTESPERPIXEL(format) > 0 ? SDL_BYTESPERPIXEL(format) : 4);
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		gTextureResidency.onFreed(this);
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+	}
+
+	if (!mPath.empty()) {
+		gTextureResidency.remove(this);
+	}
+
+	mWidth = 0;
+	mHeight = 0;
+	mBytes = 0;
+	mPath.clear();
+	mSource.clear();
+}
+
+void LTexture::evict() {
+	if (mTexture != NULL) {
+		gTextureResidency.onEvicted(this);
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+	}
+}
+
+bool LTexture::reload() {
+	if (mTexture != NULL) {
+		return true;
+	}
+	if (mPath.empty() || !createTexture()) {
+		return false;
+	}
+
+	gTextureResidency.onResident(this);
+	gTextureResidency.onReload();
+	return true;
+}
+
+void LTexture::render(int x, int y) {
+	//Mark as used first so making room for it can't evict it
+	mLastUsedFrame = gTextureResidency.getFrame();
+
+	//Bring the texture back if it was evicted
+	if (mTexture == NULL && !reload()) {
+		return;
+	}
+
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+bool LTexture::isResident()
+{
+	return mTexture != NULL;
+}
+
+size_t LTexture::getBytes()
+{
+	return mBytes;
+}
+
+Uint32 LTexture::getLastUsedFrame()
+{
+	return mLastUsedFrame;
+}
+
+size_t LTexture::getSourceBytes()
+{
+	return mSource.size();
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' texture
+	if (!gFooTexture.loadFromFile("Images/foo.png"))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Load room textures, the budget evicts the early ones while the later ones load
+	for (int i = 0; i < TOTAL_ROOMS; ++i)
+	{
+		if (!gRoomTextures[i].loadFromFile(ROOM_PATHS[i]))
+		{
+			printf("Failed to load room texture %s!\n", ROOM_PATHS[i]);
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+void close()
+{
+	printf("Evictions: %d, reloads: %d\n", gTextureResidency.getEvictionCount(), gTextureResidency.getReloadCount());
+
+	//Free loaded images
+	gFooTexture.free();
+	for (int i = 0; i < TOTAL_ROOMS; ++i)
+	{
+		gRoomTextures[i].free();
+	}
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Budget in KB and "nocache" to reload from disk can be given on the command line
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(args[i], "nocache") == 0)
+		{
+			gTextureResidency.setCacheSources(false);
+		}
+		else if (atoi(args[i]) > 0)
+		{
+			gTextureResidency.setBudget((size_t)atoi(args[i]) * 1024);
+		}
+	}
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Room being shown
+			int currentRoom = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				gTextureResidency.beginFrame();
+
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_KEYDOWN)
+					{
+						switch (e.key.keysym.sym)
+						{
+							//Number keys switch rooms
+							case SDLK_1: currentRoom = 0; break;
+							case SDLK_2: currentRoom = 1; break;
+							case SDLK_3: currentRoom = 2; break;
+							case SDLK_4: currentRoom = 3; break;
+
+							//Up and down double and halve the budget
+							case SDLK_UP:
+							gTextureResidency.setBudget(gTextureResidency.getBudget() * 2);
+							break;
+
+							case SDLK_DOWN:
+							gTextureResidency.setBudget(gTextureResidency.getBudget() / 2);
+							break;
+						}
+					}
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render the current room, then Foo' on top
+				gRoomTextures[currentRoom].render(0, 0);
+				gFooTexture.render(240, 190);
+
+				//Show residency in the title
+				char title[160];
+				SDL_snprintf(title, sizeof(title), "SDL Tutorial - textures %u/%u KB, sources %u KB, %d evictions, %d reloads",
+					(unsigned)(gTextureResidency.getResidentBytes() / 1024), (unsigned)(gTextureResidency.getBudget() / 1024),
+					(unsigned)(gTextureResidency.getSourceBytes() / 1024), gTextureResidency.getEvictionCount(), gTextureResidency.getReloadCount());
+				SDL_SetWindowTitle(gWindow, title);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
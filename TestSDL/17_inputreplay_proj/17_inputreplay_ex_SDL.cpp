@@ -0,0 +1,502 @@
+#include <stdio.h>
+#include <string.h>
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// screen size
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+// recording and frame-locked replay both run at this rate so frame indices mean the same thing in both
+const Uint32 FRAME_TICKS = 1000 / 60;
+
+// input log header, "SDLR" followed by the format version
+const Uint32 INPUT_LOG_MAGIC = 0x524C4453;
+const Uint32 INPUT_LOG_VERSION = 1;
+
+// key press surface constants
+enum KeyPressSurfaces {
+	KEY_PRESS_SURFACE_DEFAULT,
+	KEY_PRESS_SURFACE_UP,
+	KEY_PRESS_SURFACE_DOWN,
+	KEY_PRESS_SURFACE_LEFT,
+	KEY_PRESS_SURFACE_RIGHT,
+	KEY_PRESS_SURFACE_TOTAL
+};
+
+// how the main loop gets its input
+enum RunMode {
+	RUN_MODE_LIVE,
+	RUN_MODE_RECORD,
+	RUN_MODE_REPLAY
+};
+
+// Writes input events to a log as they are handled.
+// Each entry is the frame delta and event type as variable length integers followed by the raw event struct,
+// so a log only replays on a build with the same SDL_Event layout and byte order.
+class InputRecorder {
+	public:
+		// initialize variables
+		InputRecorder();
+
+		// closes the log if it's still open
+		~InputRecorder();
+
+		// creates the log file
+		bool open(string path);
+
+		// appends an event if it's one we replay, other events are ignored
+		void record(Uint32 frame, const SDL_Event& e);
+
+		// writes the end marker and closes the file
+		void close(Uint32 frame);
+
+	private:
+		// writes an unsigned integer 7 bits at a time
+		void writeVarint(Uint32 value);
+
+		SDL_RWops* mFile;
+		Uint32 mLastFrame;
+		int mEventCount;
+};
+
+// Reads a log written by InputRecorder and pushes each frame's events back into the SDL queue
+class InputReplayer {
+	public:
+		// initialize variables
+		InputReplayer();
+
+		// reads the whole log into memory
+		bool open(string path);
+
+		// pushes every event recorded for this frame, returns false once the recording has ended
+		bool pushEvents(Uint32 frame);
+
+		// frame the recording ended on
+		Uint32 getLastFrame();
+
+	private:
+		// reads the next entry's frame and type, false at the end of the data
+		bool readHeader();
+
+		// reads an unsigned integer written by writeVarint
+		bool readVarint(Uint32& value);
+
+		vector<Uint8> mData;
+		size_t mPosition;
+
+		// next entry to push, type 0 is the end marker
+		Uint32 mNextFrame;
+		Uint32 mNextType;
+		bool mHasNext;
+};
+
+// Starts up SDL and creates a window
+bool init(bool hidden);
+
+// Loads media
+bool loadMedia();
+
+// Frees media and shuts down SDL
+void close();
+
+// Gets how many bytes of an event type are stored in a log, 0 for events that aren't recorded
+size_t getRecordedEventSize(Uint32 type);
+
+// Global variables:
+
+// Loads individual image
+SDL_Surface* loadSurface(string path);
+
+// The window we will be drawing to
+SDL_Window* gWindow = NULL;
+
+// The surface we will be adding to the window to draw to
+SDL_Surface* gScreenSurface = NULL;
+
+// The images that correspond to a keypress
+SDL_Surface* gKeyPressSurfaces[KEY_PRESS_SURFACE_TOTAL];
+
+// Current displayed image
+SDL_Surface* gCurrentSurface = NULL;
+
+size_t getRecordedEventSize(Uint32 type) {
+	// only user input is recorded, window and device events depend on the machine the log is replayed on
+	switch (type) {
+		case SDL_QUIT:
+			return sizeof(SDL_QuitEvent);
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+			return sizeof(SDL_KeyboardEvent);
+		case SDL_TEXTINPUT:
+			return sizeof(SDL_TextInputEvent);
+		case SDL_MOUSEMOTION:
+			return sizeof(SDL_MouseMotionEvent);
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			return sizeof(SDL_MouseButtonEvent);
+		case SDL_MOUSEWHEEL:
+			return sizeof(SDL_MouseWheelEvent);
+		default:
+			return 0;
+	}
+}
+
+// implementation of InputRecorder class
+InputRecorder::InputRecorder() {
+	mFile = NULL;
+	mLastFrame = 0;
+	mEventCount = 0;
+}
+
+InputRecorder::~InputRecorder() {
+	close(mLastFrame);
+}
+
+bool InputRecorder::open(string path) {
+	mFile = SDL_RWFromFile(path.c_str(), "wb");
+	if (mFile == NULL) {
+		printf("Unable to create input log %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return false;
+	}
+
+	// header lets replay reject logs from a different build layout
+	SDL_WriteLE32(mFile, INPUT_LOG_MAGIC);
+	SDL_WriteLE32(mFile, INPUT_LOG_VERSION);
+	SDL_WriteLE32(mFile, (Uint32)sizeof(SDL_Event));
+	mLastFrame = 0;
+	mEventCount = 0;
+	return true;
+}
+
+void InputRecorder::record(Uint32 frame, const SDL_Event& e) {
+	size_t size = getRecordedEventSize(e.type);
+	if (mFile == NULL || size == 0) {
+		return;
+	}
+
+	writeVarint(frame - mLastFrame);
+	writeVarint(e.type);
+	SDL_RWwrite(mFile, &e, size, 1);
+	mLastFrame = frame;
+	++mEventCount;
+}
+
+void InputRecorder::close(Uint32 frame) {
+	if (mFile == NULL) {
+		return;
+	}
+
+	// the end marker records how many frames the session ran
+	writeVarint(frame - mLastFrame);
+	writeVarint(SDL_FIRSTEVENT);
+	mLastFrame = frame;
+
+	printf("Recorded %d events over %u frames\n", mEventCount, (unsigned)frame);
+	SDL_RWclose(mFile);
+	mFile = NULL;
+}
+
+void InputRecorder::writeVarint(Uint32 value) {
+	Uint8 bytes[5];
+	int count = 0;
+	while (value >= 0x80) {
+		bytes[count++] = (Uint8)(value | 0x80);
+		value >>= 7;
+	}
+	bytes[count++] = (Uint8)value;
+	SDL_RWwrite(mFile, bytes, 1, count);
+}
+
+// implementation of InputReplayer class
+InputReplayer::InputReplayer() {
+	mPosition = 0;
+	mNextFrame = 0;
+	mNextType = SDL_FIRSTEVENT;
+	mHasNext = false;
+}
+
+bool InputReplayer::open(string path) {
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == NULL) {
+		printf("Unable to open input log %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return false;
+	}
+
+	Uint32 magic = SDL_ReadLE32(file);
+	Uint32 version = SDL_ReadLE32(file);
+	Uint32 eventSize = SDL_ReadLE32(file);
+	if (magic != INPUT_LOG_MAGIC || version != INPUT_LOG_VERSION || eventSize != sizeof(SDL_Event)) {
+		printf("%s is not an input log this build can replay!\n", path.c_str());
+		SDL_RWclose(file);
+		return false;
+	}
+
+	// the rest is small enough to keep in memory so replay never waits on the disk
+	Sint64 size = SDL_RWsize(file) - SDL_RWtell(file);
+	if (size > 0) {
+		mData.resize((size_t)size);
+		if (SDL_RWread(file, &mData[0], 1, (size_t)size) != (size_t)size) {
+			mData.clear();
+		}
+	}
+	SDL_RWclose(file);
+
+	mPosition = 0;
+	mNextFrame = 0;
+	mHasNext = readHeader();
+	if (!mHasNext) {
+		printf("Input log %s is empty or truncated!\n", path.c_str());
+	}
+	return mHasNext;
+}
+
+bool InputReplayer::pushEvents(Uint32 frame) {
+	while (mHasNext && mNextFrame == frame) {
+		// end marker
+		if (mNextType == SDL_FIRSTEVENT) {
+			mHasNext = false;
+			return false;
+		}
+
+		size_t size = getRecordedEventSize(mNextType);
+		if (size == 0 || mPosition + size > mData.size()) {
+			printf("Input log is corrupt at byte %u!\n", (unsigned)mPosition);
+			mHasNext = false;
+			return false;
+		}
+
+		SDL_Event e;
+		SDL_zero(e);
+		memcpy(&e, &mData[mPosition], size);
+		mPosition += size;
+		SDL_PushEvent(&e);
+
+		mHasNext = readHeader();
+	}
+
+	return mHasNext;
+}
+
+Uint32 InputReplayer::getLastFrame() {
+	return mNextFrame;
+}
+
+bool InputReplayer::readHeader() {
+	Uint32 delta = 0;
+	if (!readVarint(delta) || !readVarint(mNextType)) {
+		return false;
+	}
+	mNextFrame += delta;
+	return true;
+}
+
+bool InputReplayer::readVarint(Uint32& value) {
+	value = 0;
+	for (int shift = 0; shift < 35; shift += 7) {
+		if (mPosition >= mData.size()) {
+			return false;
+		}
+		Uint8 byte = mData[mPosition++];
+		value |= (Uint32)(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool init(bool hidden) {
+	// Initialization flag; this will be returned as it is if everything is successful
+	bool success = true;
+
+	// Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else {
+		// Create window, replays keep it hidden so nothing on the desktop can interfere
+		gWindow = SDL_CreateWindow("SDL_Tutorial_2", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
+		if (gWindow == NULL) {
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else {
+			// Get the window surface
+			gScreenSurface = SDL_GetWindowSurface(gWindow);
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia() {
+	// Loading succes flag
+	bool success = true;
+
+	// the files for each key, in KeyPressSurfaces order
+	const char* paths[KEY_PRESS_SURFACE_TOTAL] = { "Images/press.bmp", "Images/up.bmp", "Images/down.bmp", "Images/left.bmp", "Images/right.bmp" };
+
+	for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; i++) {
+		gKeyPressSurfaces[i] = loadSurface(paths[i]);
+		if (gKeyPressSurfaces[i] == NULL) {
+			printf("Failed to load %s!\n", paths[i]);
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+
+void close() {
+	// Deallocate surfaces
+	for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; i++) {
+		SDL_FreeSurface(gKeyPressSurfaces[i]);
+		gKeyPressSurfaces[i] = NULL;
+	}
+
+	// Destroy window
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+
+	// Quit SDL subsystems
+	SDL_Quit();
+}
+
+// generalized function to load a surface in the future
+SDL_Surface* loadSurface(string path) {
+	// Load image at specified path
+	SDL_Surface* loadedSurface = SDL_LoadBMP(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL Error: %s", path.c_str(), SDL_GetError());
+	}
+
+	return loadedSurface;
+}
+
+int main(int argc, char* args[]) {
+	// "record <log>" saves the session, "replay <log> [fast]" plays one back without a visible window
+	RunMode mode = RUN_MODE_LIVE;
+	bool frameLocked = true;
+	string logPath;
+	if (argc >= 3 && strcmp(args[1], "record") == 0) {
+		mode = RUN_MODE_RECORD;
+		logPath = args[2];
+	}
+	else if (argc >= 3 && strcmp(args[1], "replay") == 0) {
+		mode = RUN_MODE_REPLAY;
+		logPath = args[2];
+		frameLocked = !(argc >= 4 && strcmp(args[3], "fast") == 0);
+	}
+
+	InputRecorder recorder;
+	InputReplayer replayer;
+
+	if (!init(mode == RUN_MODE_REPLAY)) {
+		printf("Cannot initialize!");
+	}
+	else if ((mode == RUN_MODE_RECORD && !recorder.open(logPath)) || (mode == RUN_MODE_REPLAY && !replayer.open(logPath))) {
+		printf("Cannot open input log!");
+	}
+	else {
+		if (!loadMedia()) {
+			printf("Cannot load media!");
+		}
+		else {
+			// Main loop flag for quitting the application
+			bool quit = false;
+
+			// Event handler- it handles events like key presses, mouse motion, joy button presses, etc.
+			SDL_Event e;
+
+			// Set default current surface
+			gCurrentSurface = gKeyPressSurfaces[KEY_PRESS_SURFACE_DEFAULT];
+
+			// Frame index the log is keyed on, and timing for the replay report
+			Uint32 frame = 0;
+			Uint64 startCounter = SDL_GetPerformanceCounter();
+
+			// While the application runs; initiating the game loop
+			while (!quit) {
+				Uint32 frameStart = SDL_GetTicks();
+
+				// During replay live input is thrown away and this frame's recorded events take its place
+				if (mode == RUN_MODE_REPLAY) {
+					SDL_PumpEvents();
+					SDL_FlushEvents(SDL_KEYDOWN, SDL_MULTIGESTURE);
+					if (!replayer.pushEvents(frame)) {
+						quit = true;
+					}
+				}
+
+				// handles events on the *event queue*
+				while (SDL_PollEvent(&e) != 0) {
+					if (mode == RUN_MODE_RECORD) {
+						recorder.record(frame, e);
+					}
+
+					// User requests to quit by pressing the X button outside the window.
+					if (e.type == SDL_QUIT) {
+						quit = true;
+					}
+					// User presses a keyboard key
+					else if (e.type == SDL_KEYDOWN) {
+						// select surface based on the keypress
+						switch (e.key.keysym.sym) {
+							case SDLK_UP:
+								gCurrentSurface = gKeyPressSurfaces[KEY_PRESS_SURFACE_UP];
+								break;
+							case SDLK_DOWN:
+								gCurrentSurface = gKeyPressSurfaces[KEY_PRESS_SURFACE_DOWN];
+								break;
+							case SDLK_LEFT:
+								gCurrentSurface = gKeyPressSurfaces[KEY_PRESS_SURFACE_LEFT];
+								break;
+							case SDLK_RIGHT:
+								gCurrentSurface = gKeyPressSurfaces[KEY_PRESS_SURFACE_RIGHT];
+								break;
+							default:
+								gCurrentSurface = gKeyPressSurfaces[KEY_PRESS_SURFACE_DEFAULT];
+								break;
+						}
+					}
+				}
+
+				// apply the image through blitting
+				SDL_BlitSurface(gCurrentSurface, NULL, gScreenSurface, NULL);
+
+				// Always need to update surface to see the image on the screen
+				SDL_UpdateWindowSurface(gWindow);
+
+				// hold the frame rate unless replaying as fast as possible
+				if (frameLocked) {
+					Uint32 elapsed = SDL_GetTicks() - frameStart;
+					if (elapsed < FRAME_TICKS) {
+						SDL_Delay(FRAME_TICKS - elapsed);
+					}
+				}
+
+				++frame;
+			}
+
+			// frame count and time are what two builds get compared on
+			if (mode == RUN_MODE_REPLAY) {
+				double seconds = (double)(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency();
+				printf("Replayed %u frames in %.3f s, %.3f ms per frame (%s)\n", (unsigned)frame, seconds, seconds * 1000.0 / (frame > 0 ? frame : 1), frameLocked ? "frame-locked" : "fast");
+			}
+			else if (mode == RUN_MODE_RECORD) {
+				recorder.close(frame);
+			}
+		}
+	}
+
+	// Free resources and close SDL
+	close();
+
+	return 0;
+}
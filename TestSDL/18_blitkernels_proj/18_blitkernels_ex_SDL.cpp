@@ -0,0 +1,638 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+#include <string>
+
+using namespace std;
+
+// screen size
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+// blits timed per pair in benchmark mode
+const int BENCHMARK_ITERATIONS = 500;
+
+// key press surface constants
+enum KeyPressSurfaces {
+	KEY_PRESS_SURFACE_DEFAULT,
+	KEY_PRESS_SURFACE_UP,
+	KEY_PRESS_SURFACE_DOWN,
+	KEY_PRESS_SURFACE_LEFT,
+	KEY_PRESS_SURFACE_RIGHT,
+	KEY_PRESS_SURFACE_TOTAL
+};
+
+// pixel formats the specialized blitters are generated for
+enum BlitFormat {
+	BLIT_FORMAT_RGB24,
+	BLIT_FORMAT_BGR24,
+	BLIT_FORMAT_XRGB8888,
+	BLIT_FORMAT_XBGR8888,
+	BLIT_FORMAT_ARGB8888,
+	BLIT_FORMAT_ABGR8888,
+	BLIT_FORMAT_TOTAL
+};
+
+// how source alpha is applied
+enum BlitAlpha {
+	BLIT_ALPHA_NONE,
+	BLIT_ALPHA_BLEND,
+	BLIT_ALPHA_TOTAL
+};
+
+// Everything a kernel needs for one blit, already clipped
+struct BlitParams {
+	const Uint8* src;
+	int srcPitch;
+	Uint8* dst;
+	int dstPitch;
+	int width;
+	int height;
+
+	// color key as 0x00RRGGBB
+	Uint32 key;
+};
+
+typedef void(*BlitFunc)(const BlitParams& params);
+
+// Kernel picked for a surface pair, func is NULL when the pair isn't covered and SDL_BlitSurface has to do it
+struct BlitPlan {
+	BlitFunc func;
+	Uint32 key;
+	const SDL_Surface* src;
+	const SDL_Surface* dst;
+};
+
+// Format traits. Each one moves a pixel between memory and 0xAARRGGBB in a register,
+// the kernels are written once against these and the compiler flattens them per pair.
+struct FormatRGB24 {
+	enum { BYTES = 3 };
+	static Uint32 load(const Uint8* p) { return 0xFF000000 | ((Uint32)p[0] << 16) | ((Uint32)p[1] << 8) | p[2]; }
+	static void store(Uint8* p, Uint32 c) { p[0] = (Uint8)(c >> 16); p[1] = (Uint8)(c >> 8); p[2] = (Uint8)c; }
+};
+
+struct FormatBGR24 {
+	enum { BYTES = 3 };
+	static Uint32 load(const Uint8* p) { return 0xFF000000 | ((Uint32)p[2] << 16) | ((Uint32)p[1] << 8) | p[0]; }
+	static void store(Uint8* p, Uint32 c) { p[2] = (Uint8)(c >> 16); p[1] = (Uint8)(c >> 8); p[0] = (Uint8)c; }
+};
+
+struct FormatXRGB8888 {
+	enum { BYTES = 4 };
+	static Uint32 load(const Uint8* p) { return *(const Uint32*)p | 0xFF000000; }
+	static void store(Uint8* p, Uint32 c) { *(Uint32*)p = c; }
+};
+
+struct FormatXBGR8888 {
+	enum { BYTES = 4 };
+	static Uint32 load(const Uint8* p) { Uint32 c = *(const Uint32*)p; return 0xFF000000 | (c & 0x0000FF00) | ((c & 0xFF) << 16) | ((c >> 16) & 0xFF); }
+	static void store(Uint8* p, Uint32 c) { *(Uint32*)p = (c & 0xFF00FF00) | ((c & 0xFF) << 16) | ((c >> 16) & 0xFF); }
+};
+
+struct FormatARGB8888 {
+	enum { BYTES = 4 };
+	static Uint32 load(const Uint8* p) { return *(const Uint32*)p; }
+	static void store(Uint8* p, Uint32 c) { *(Uint32*)p = c; }
+};
+
+struct FormatABGR8888 {
+	enum { BYTES = 4 };
+	static Uint32 load(const Uint8* p) { Uint32 c = *(const Uint32*)p; return (c & 0xFF00FF00) | ((c & 0xFF) << 16) | ((c >> 16) & 0xFF); }
+	static void store(Uint8* p, Uint32 c) { *(Uint32*)p = (c & 0xFF00FF00) | ((c & 0xFF) << 16) | ((c >> 16) & 0xFF); }
+};
+
+// Starts up SDL and creates a window
+bool init();
+
+// Loads media
+bool loadMedia();
+
+// Frees media and shuts down SDL
+void close();
+
+// Fills the kernel table, called once before any planBlit
+void initBlitTable();
+
+// Picks the kernel for blitting src onto dst with src's current color key and blend mode
+BlitPlan planBlit(SDL_Surface* src, SDL_Surface* dst);
+
+// Blits all of src to (x, y) on dst using a plan from planBlit, falls back to SDL_BlitSurface without a kernel
+int blitPlanned(const BlitPlan& plan, SDL_Surface* src, SDL_Surface* dst, int x, int y);
+
+// Times and checks every specialized kernel against SDL_BlitSurface, false if any is missing or out of tolerance
+bool runBenchmark();
+
+// Global variables:
+
+// Loads individual image
+SDL_Surface* loadSurface(string path);
+
+// The window we will be drawing to
+SDL_Window* gWindow = NULL;
+
+// The surface we will be adding to the window to draw to
+SDL_Surface* gScreenSurface = NULL;
+
+// The images that correspond to a keypress
+SDL_Surface* gKeyPressSurfaces[KEY_PRESS_SURFACE_TOTAL];
+
+// Blit plan for each image onto the screen surface
+BlitPlan gKeyPressPlans[KEY_PRESS_SURFACE_TOTAL];
+
+// Current displayed image
+int gCurrentSurface = KEY_PRESS_SURFACE_DEFAULT;
+
+// Kernel for every (source, destination, color key, alpha) combination
+BlitFunc gBlitTable[BLIT_FORMAT_TOTAL][BLIT_FORMAT_TOTAL][2][BLIT_ALPHA_TOTAL];
+
+// Blends c over d with alpha a, 0xAARRGGBB in and out. Red and blue share one multiply, green and alpha the other.
+static inline Uint32 blendPixel(Uint32 c, Uint32 d) {
+	Uint32 a = c >> 24;
+	Uint32 ia = 255 - a;
+
+	Uint32 rb = (c & 0x00FF00FF) * a + (d & 0x00FF00FF) * ia + 0x00800080;
+	rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+
+	// green in the low lane, destination alpha scaled by 1 - a in the high lane, then source alpha is added back
+	Uint32 ga = ((c >> 8) & 0xFF) * a + ((d >> 8) & 0x00FF00FF) * ia + 0x00800080;
+	ga = (ga + ((ga >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+
+	return (rb | ga) + (a << 24);
+}
+
+// The kernel family. ColorKey and Alpha are compile time so the per pixel loop has no format lookups,
+// and the color key is a mask select rather than a branch.
+template<class Src, class Dst, bool ColorKey, int Alpha>
+static void blitKernel(const BlitParams& params) {
+	const Uint8* srcRow = params.src;
+	Uint8* dstRow = params.dst;
+
+	for (int y = 0; y < params.height; ++y) {
+		const Uint8* s = srcRow;
+		Uint8* d = dstRow;
+
+		for (int x = 0; x < params.width; ++x) {
+			Uint32 c = Src::load(s);
+			Uint32 out = c;
+
+			if (Alpha == BLIT_ALPHA_BLEND || ColorKey) {
+				Uint32 under = Dst::load(d);
+
+				if (Alpha == BLIT_ALPHA_BLEND) {
+					out = blendPixel(c, under);
+				}
+				if (ColorKey) {
+					Uint32 keep = (Uint32)0 - (Uint32)((c & 0x00FFFFFF) != params.key);
+					out = (out & keep) | (under & ~keep);
+				}
+			}
+
+			Dst::store(d, out);
+			s += Src::BYTES;
+			d += Dst::BYTES;
+		}
+
+		srcRow += params.srcPitch;
+		dstRow += params.dstPitch;
+	}
+}
+
+// Fills the four kernels of one format pair
+template<class Src, class Dst>
+static void fillBlitPair(int src, int dst) {
+	gBlitTable[src][dst][0][BLIT_ALPHA_NONE] = &blitKernel<Src, Dst, false, BLIT_ALPHA_NONE>;
+	gBlitTable[src][dst][0][BLIT_ALPHA_BLEND] = &blitKernel<Src, Dst, false, BLIT_ALPHA_BLEND>;
+	gBlitTable[src][dst][1][BLIT_ALPHA_NONE] = &blitKernel<Src, Dst, true, BLIT_ALPHA_NONE>;
+	gBlitTable[src][dst][1][BLIT_ALPHA_BLEND] = &blitKernel<Src, Dst, true, BLIT_ALPHA_BLEND>;
+}
+
+// Fills every destination for one source format
+template<class Src>
+static void fillBlitSource(int src) {
+	fillBlitPair<Src, FormatRGB24>(src, BLIT_FORMAT_RGB24);
+	fillBlitPair<Src, FormatBGR24>(src, BLIT_FORMAT_BGR24);
+	fillBlitPair<Src, FormatXRGB8888>(src, BLIT_FORMAT_XRGB8888);
+	fillBlitPair<Src, FormatXBGR8888>(src, BLIT_FORMAT_XBGR8888);
+	fillBlitPair<Src, FormatARGB8888>(src, BLIT_FORMAT_ARGB8888);
+	fillBlitPair<Src, FormatABGR8888>(src, BLIT_FORMAT_ABGR8888);
+}
+
+void initBlitTable() {
+	fillBlitSource<FormatRGB24>(BLIT_FORMAT_RGB24);
+	fillBlitSource<FormatBGR24>(BLIT_FORMAT_BGR24);
+	fillBlitSource<FormatXRGB8888>(BLIT_FORMAT_XRGB8888);
+	fillBlitSource<FormatXBGR8888>(BLIT_FORMAT_XBGR8888);
+	fillBlitSource<FormatARGB8888>(BLIT_FORMAT_ARGB8888);
+	fillBlitSource<FormatABGR8888>(BLIT_FORMAT_ABGR8888);
+}
+
+// Maps an SDL pixel format to a BlitFormat, -1 if there are no kernels for it
+static int getBlitFormat(Uint32 format) {
+	switch (format) {
+		case SDL_PIXELFORMAT_RGB24: return BLIT_FORMAT_RGB24;
+		case SDL_PIXELFORMAT_BGR24: return BLIT_FORMAT_BGR24;
+		case SDL_PIXELFORMAT_RGB888: return BLIT_FORMAT_XRGB8888;
+		case SDL_PIXELFORMAT_BGR888: return BLIT_FORMAT_XBGR8888;
+		case SDL_PIXELFORMAT_ARGB8888: return BLIT_FORMAT_ARGB8888;
+		case SDL_PIXELFORMAT_ABGR8888: return BLIT_FORMAT_ABGR8888;
+		default: return -1;
+	}
+}
+
+BlitPlan planBlit(SDL_Surface* src, SDL_Surface* dst) {
+	BlitPlan plan;
+	plan.func = NULL;
+	plan.key = 0;
+	plan.src = src;
+	plan.dst = dst;
+
+	int srcFormat = getBlitFormat(src->format->format);
+	int dstFormat = getBlitFormat(dst->format->format);
+	if (srcFormat < 0 || dstFormat < 0) {
+		return plan;
+	}
+
+	// color key goes to 0x00RRGGBB so it compares against what the loader returns
+	Uint32 keyPixel = 0;
+	bool colorKey = SDL_GetColorKey(src, &keyPixel) == 0;
+	if (colorKey) {
+		Uint8 r, g, b;
+		SDL_GetRGB(keyPixel, src->format, &r, &g, &b);
+		plan.key = ((Uint32)r << 16) | ((Uint32)g << 8) | b;
+	}
+
+	// blending only means something when the source has alpha
+	SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+	SDL_GetSurfaceBlendMode(src, &blendMode);
+	int alpha = BLIT_ALPHA_NONE;
+	if (blendMode == SDL_BLENDMODE_BLEND && src->format->Amask != 0) {
+		alpha = BLIT_ALPHA_BLEND;
+	}
+	else if (blendMode != SDL_BLENDMODE_NONE && blendMode != SDL_BLENDMODE_BLEND) {
+		return plan;
+	}
+
+	// per surface color and alpha modulation aren't covered
+	Uint8 alphaMod = 0xFF;
+	Uint8 r = 0xFF, g = 0xFF, b = 0xFF;
+	SDL_GetSurfaceAlphaMod(src, &alphaMod);
+	SDL_GetSurfaceColorMod(src, &r, &g, &b);
+	if (alphaMod != 0xFF || r != 0xFF || g != 0xFF || b != 0xFF) {
+		return plan;
+	}
+
+	plan.func = gBlitTable[srcFormat][dstFormat][colorKey ? 1 : 0][alpha];
+	return plan;
+}
+
+int blitPlanned(const BlitPlan& plan, SDL_Surface* src, SDL_Surface* dst, int x, int y) {
+	// a plan is only good for the surfaces it was made for
+	if (plan.func == NULL || plan.src != src || plan.dst != dst) {
+		SDL_Rect dstRect = { x, y, src->w, src->h };
+		return SDL_BlitSurface(src, NULL, dst, &dstRect);
+	}
+
+	// clip against the destination's clip rectangle
+	SDL_Rect clip = dst->clip_rect;
+	int srcX = 0;
+	int srcY = 0;
+	int width = src->w;
+	int height = src->h;
+	if (x < clip.x) {
+		srcX = clip.x - x;
+		width -= srcX;
+		x = clip.x;
+	}
+	if (y < clip.y) {
+		srcY = clip.y - y;
+		height -= srcY;
+		y = clip.y;
+	}
+	if (x + width > clip.x + clip.w) {
+		width = clip.x + clip.w - x;
+	}
+	if (y + height > clip.y + clip.h) {
+		height = clip.y + clip.h - y;
+	}
+	if (width <= 0 || height <= 0) {
+		return 0;
+	}
+
+	if ((SDL_MUSTLOCK(src) && SDL_LockSurface(src) < 0) || (SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) < 0)) {
+		return -1;
+	}
+
+	BlitParams params;
+	params.src = (const Uint8*)src->pixels + srcY * src->pitch + srcX * src->format->BytesPerPixel;
+	params.srcPitch = src->pitch;
+	params.dst = (Uint8*)dst->pixels + y * dst->pitch + x * dst->format->BytesPerPixel;
+	params.dstPitch = dst->pitch;
+	params.width = width;
+	params.height = height;
+	params.key = plan.key;
+	plan.func(params);
+
+	if (SDL_MUSTLOCK(dst)) {
+		SDL_UnlockSurface(dst);
+	}
+	if (SDL_MUSTLOCK(src)) {
+		SDL_UnlockSurface(src);
+	}
+	return 0;
+}
+
+// Creates a surface in the given format filled with random pixels
+static SDL_Surface* createRandomSurface(Uint32 format, int width, int height) {
+	int bpp;
+	Uint32 rmask, gmask, bmask, amask;
+	SDL_PixelFormatEnumToMasks(format, &bpp, &rmask, &gmask, &bmask, &amask);
+	SDL_Surface* surface = SDL_CreateRGBSurface(0, width, height, bpp, rmask, gmask, bmask, amask);
+	if (surface != NULL) {
+		for (int y = 0; y < height; ++y) {
+			Uint8* row = (Uint8*)surface->pixels + y * surface->pitch;
+			for (int x = 0; x < width * surface->format->BytesPerPixel; ++x) {
+				row[x] = (Uint8)rand();
+			}
+		}
+	}
+	return surface;
+}
+
+bool runBenchmark() {
+	initBlitTable();
+	bool success = true;
+
+	// the pairs that matter, the last column is the largest per channel difference allowed against SDL
+	struct BenchmarkCase {
+		const char* name;
+		Uint32 srcFormat;
+		Uint32 dstFormat;
+		bool colorKey;
+		bool blend;
+		int tolerance;
+	};
+	const BenchmarkCase cases[] = {
+		{ "BGR24 -> XRGB8888", SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_RGB888, false, false, 0 },
+		{ "RGB24 -> XRGB8888", SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_RGB888, false, false, 0 },
+		{ "BGR24 -> XRGB8888 keyed", SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_RGB888, true, false, 0 },
+		{ "ARGB8888 -> XRGB8888 keyed", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, true, false, 0 },
+		{ "ABGR8888 -> XRGB8888", SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, false, false, 0 },
+		{ "ARGB8888 -> XRGB8888 blend", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, false, true, 2 },
+	};
+
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+		const BenchmarkCase& c = cases[i];
+		SDL_Surface* src = createRandomSurface(c.srcFormat, SCREEN_WIDTH, SCREEN_HEIGHT);
+		SDL_Surface* background = createRandomSurface(c.dstFormat, SCREEN_WIDTH, SCREEN_HEIGHT);
+		SDL_Surface* expected = createRandomSurface(c.dstFormat, SCREEN_WIDTH, SCREEN_HEIGHT);
+		SDL_Surface* actual = createRandomSurface(c.dstFormat, SCREEN_WIDTH, SCREEN_HEIGHT);
+		if (src == NULL || background == NULL || expected == NULL || actual == NULL) {
+			printf("Unable to create benchmark surfaces! SDL Error: %s\n", SDL_GetError());
+			SDL_FreeSurface(src);
+			SDL_FreeSurface(background);
+			SDL_FreeSurface(expected);
+			SDL_FreeSurface(actual);
+			return false;
+		}
+
+		// key a colour that actually occurs, a quarter of the rows use it
+		if (c.colorKey) {
+			Uint8* first = (Uint8*)src->pixels;
+			for (int y = 0; y < src->h; y += 4) {
+				memcpy((Uint8*)src->pixels + y * src->pitch, first, src->w * src->format->BytesPerPixel);
+			}
+			Uint32 keyPixel = 0;
+			memcpy(&keyPixel, first, src->format->BytesPerPixel);
+			SDL_SetColorKey(src, SDL_TRUE, keyPixel & ~src->format->Amask);
+		}
+		SDL_SetSurfaceBlendMode(src, c.blend ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+
+		// compare on the same background
+		SDL_BlitSurface(background, NULL, expected, NULL);
+		SDL_BlitSurface(background, NULL, actual, NULL);
+		SDL_BlitSurface(src, NULL, expected, NULL);
+		BlitPlan plan = planBlit(src, actual);
+		blitPlanned(plan, src, actual, 0, 0);
+
+		// the unused byte of XRGB doesn't count
+		int worst = 0;
+		for (int y = 0; y < actual->h; ++y) {
+			const Uint32* e = (const Uint32*)((const Uint8*)expected->pixels + y * expected->pitch);
+			const Uint32* a = (const Uint32*)((const Uint8*)actual->pixels + y * actual->pitch);
+			for (int x = 0; x < actual->w; ++x) {
+				for (int shift = 0; shift < 24; shift += 8) {
+					int difference = abs((int)((e[x] >> shift) & 0xFF) - (int)((a[x] >> shift) & 0xFF));
+					worst = difference > worst ? difference : worst;
+				}
+			}
+		}
+
+		// time SDL's generic path against the kernel
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (int n = 0; n < BENCHMARK_ITERATIONS; ++n) {
+			SDL_BlitSurface(src, NULL, expected, NULL);
+		}
+		Uint64 middle = SDL_GetPerformanceCounter();
+		for (int n = 0; n < BENCHMARK_ITERATIONS; ++n) {
+			blitPlanned(plan, src, actual, 0, 0);
+		}
+		Uint64 end = SDL_GetPerformanceCounter();
+
+		double frequency = (double)SDL_GetPerformanceFrequency();
+		double sdlMs = (middle - start) * 1000.0 / frequency / BENCHMARK_ITERATIONS;
+		double kernelMs = (end - middle) * 1000.0 / frequency / BENCHMARK_ITERATIONS;
+		printf("%-28s SDL %7.3f ms  kernel %7.3f ms  %5.2fx  max difference %d %s\n", c.name, sdlMs, kernelMs, sdlMs / kernelMs,
+			worst, plan.func == NULL ? "(no kernel)" : worst > c.tolerance ? "MISMATCH" : "ok");
+		if (plan.func == NULL || worst > c.tolerance) {
+			success = false;
+		}
+
+		SDL_FreeSurface(src);
+		SDL_FreeSurface(background);
+		SDL_FreeSurface(expected);
+		SDL_FreeSurface(actual);
+	}
+
+	return success;
+}
+
+bool init() {
+	// Initialization flag; this will be returned as it is if everything is successful
+	bool success = true;
+
+	// Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else {
+		// Create window
+		gWindow = SDL_CreateWindow("SDL_Tutorial_2", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL) {
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else {
+			// Get the window surface
+			gScreenSurface = SDL_GetWindowSurface(gWindow);
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia() {
+	// Loading succes flag
+	bool success = true;
+
+	// the files for each key, in KeyPressSurfaces order
+	const char* paths[KEY_PRESS_SURFACE_TOTAL] = { "Images/press.bmp", "Images/up.bmp", "Images/down.bmp", "Images/left.bmp", "Images/right.bmp" };
+
+	for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; i++) {
+		gKeyPressSurfaces[i] = loadSurface(paths[i]);
+		if (gKeyPressSurfaces[i] == NULL) {
+			printf("Failed to load %s!\n", paths[i]);
+			success = false;
+		}
+		else {
+			// the kernel is chosen once here instead of SDL working it out per blit
+			gKeyPressPlans[i] = planBlit(gKeyPressSurfaces[i], gScreenSurface);
+			if (gKeyPressPlans[i].func == NULL) {
+				printf("No specialized blitter for %s onto the window, using SDL_BlitSurface\n", paths[i]);
+			}
+		}
+	}
+
+	return success;
+}
+
+
+void close() {
+	// Deallocate surfaces
+	for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; i++) {
+		SDL_FreeSurface(gKeyPressSurfaces[i]);
+		gKeyPressSurfaces[i] = NULL;
+	}
+
+	// Destroy window
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+
+	// Quit SDL subsystems
+	SDL_Quit();
+}
+
+// generalized function to load a surface in the future
+SDL_Surface* loadSurface(string path) {
+	// Load image at specified path
+	SDL_Surface* loadedSurface = SDL_LoadBMP(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL Error: %s", path.c_str(), SDL_GetError());
+	}
+
+	return loadedSurface;
+}
+
+int main(int argc, char* args[]) {
+	// "benchmark" checks and times the kernels without opening a window, nonzero exit if any kernel is missing or wrong
+	if (argc >= 2 && strcmp(args[1], "benchmark") == 0) {
+		return runBenchmark() ? 0 : 1;
+	}
+
+	initBlitTable();
+
+	if (!init()) {
+		printf("Cannot initialize!");
+	}
+	else {
+		if (!loadMedia()) {
+			printf("Cannot load media!");
+		}
+		else {
+			// Main loop flag for quitting the application
+			bool quit = false;
+
+			// Event handler- it handles events like key presses, mouse motion, joy button presses, etc.
+			SDL_Event e;
+
+			// Tab switches between the specialized kernels and SDL_BlitSurface
+			bool useKernels = true;
+
+			// blit timing shown in the title once a second
+			Uint64 blitCounter = 0;
+			int blitCount = 0;
+			Uint32 nextTitleUpdate = 0;
+
+			// While the application runs; initiating the game loop
+			while (!quit) {
+				while (SDL_PollEvent(&e) != 0) {
+					// User requests to quit by pressing the X button outside the window.
+					if (e.type == SDL_QUIT) {
+						quit = true;
+					}
+					// the window surface is recreated on resize, so are the plans that point at it
+					else if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+						gScreenSurface = SDL_GetWindowSurface(gWindow);
+						for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; i++) {
+							gKeyPressPlans[i] = planBlit(gKeyPressSurfaces[i], gScreenSurface);
+						}
+					}
+					// User presses a keyboard key
+					else if (e.type == SDL_KEYDOWN) {
+						// select surface based on the keypress
+						switch (e.key.keysym.sym) {
+							case SDLK_TAB:
+								useKernels = !useKernels;
+								break;
+							case SDLK_UP:
+								gCurrentSurface = KEY_PRESS_SURFACE_UP;
+								break;
+							case SDLK_DOWN:
+								gCurrentSurface = KEY_PRESS_SURFACE_DOWN;
+								break;
+							case SDLK_LEFT:
+								gCurrentSurface = KEY_PRESS_SURFACE_LEFT;
+								break;
+							case SDLK_RIGHT:
+								gCurrentSurface = KEY_PRESS_SURFACE_RIGHT;
+								break;
+							default:
+								gCurrentSurface = KEY_PRESS_SURFACE_DEFAULT;
+								break;
+						}
+					}
+				}
+
+				// apply the image through blitting
+				Uint64 blitStart = SDL_GetPerformanceCounter();
+				if (useKernels) {
+					blitPlanned(gKeyPressPlans[gCurrentSurface], gKeyPressSurfaces[gCurrentSurface], gScreenSurface, 0, 0);
+				}
+				else {
+					SDL_BlitSurface(gKeyPressSurfaces[gCurrentSurface], NULL, gScreenSurface, NULL);
+				}
+				blitCounter += SDL_GetPerformanceCounter() - blitStart;
+				++blitCount;
+
+				if (SDL_GetTicks() >= nextTitleUpdate) {
+					char title[128];
+					SDL_snprintf(title, sizeof(title), "SDL_Tutorial_2 - %s %.3f ms per blit", useKernels ? "kernel" : "SDL_BlitSurface",
+						blitCounter * 1000.0 / SDL_GetPerformanceFrequency() / (blitCount > 0 ? blitCount : 1));
+					SDL_SetWindowTitle(gWindow, title);
+					blitCounter = 0;
+					blitCount = 0;
+					nextTitleUpdate = SDL_GetTicks() + 1000;
+				}
+
+				// Always need to update surface to see the image on the screen
+				SDL_UpdateWindowSurface(gWindow);
+			}
+		}
+	}
+
+	// Free resources and close SDL
+	close();
+
+	return 0;
+}
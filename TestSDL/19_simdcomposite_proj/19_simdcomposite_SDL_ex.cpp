@@ -0,0 +1,738 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, and stdlib
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+//SSE2 is always there on x64 and on x86 builds compiled with /arch:SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COMPOSITE_USE_SSE2 1
+#endif
+
+//AVX2 kernels are compiled for any x86 target and only called when the CPU has it.
+//MSVC allows the intrinsics anywhere, GCC and Clang need them marked per function.
+#if defined(COMPOSITE_USE_SSE2) && defined(_MSC_VER)
+#include <immintrin.h>
+#define COMPOSITE_USE_AVX2 1
+#define COMPOSITE_TARGET_AVX2
+#elif defined(COMPOSITE_USE_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define COMPOSITE_USE_AVX2 1
+#define COMPOSITE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Sprites composited each frame
+const int TOTAL_KEYED_SPRITES = 256;
+const int TOTAL_GLOW_SPRITES = 64;
+
+//Size of the generated glow sprite
+const int GLOW_SIZE = 64;
+
+//Rows composited per kernel in the self test benchmark
+const int BENCHMARK_ITERATIONS = 200;
+
+//Kernel implementations, in the order they are tried
+enum CompositeLevel
+{
+	COMPOSITE_SCALAR,
+	COMPOSITE_SSE2,
+	COMPOSITE_AVX2,
+	COMPOSITE_TOTAL
+};
+
+//Names used in the title and the self test
+const char* COMPOSITE_LEVEL_NAMES[COMPOSITE_TOTAL] = { "scalar", "SSE2", "AVX2" };
+
+//Copies src over dst except where the RGB of src equals key. Pixels are ARGB8888.
+typedef void(*KeyRowFunc)(Uint32* dst, const Uint32* src, int count, Uint32 key);
+
+//Premultiplied alpha over: dst = src + dst * (1 - src alpha). Pixels are ARGB8888.
+typedef void(*OverRowFunc)(Uint32* dst, const Uint32* src, int count);
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Loads an image and converts it to ARGB8888
+SDL_Surface* loadSurface(std::string path);
+
+//Makes a premultiplied radial glow
+SDL_Surface* createGlowSurface(int size);
+
+//Whether a kernel level can run on this CPU
+bool isCompositeLevelSupported(int level);
+
+//Switches the kernels the composite functions use
+void setCompositeLevel(int level);
+
+//Composites a sprite onto dst at (x, y), clipped to dst
+void compositeKeyed(SDL_Surface* dst, SDL_Surface* src, int x, int y, Uint32 key);
+void compositeOver(SDL_Surface* dst, SDL_Surface* src, int x, int y);
+
+//Checks every level against the scalar kernels on random rows and times them
+bool runSelfTest();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//CPU side images, all ARGB8888
+SDL_Surface* gFooSurface = NULL;
+SDL_Surface* gBackgroundSurface = NULL;
+SDL_Surface* gGlowSurface = NULL;
+
+//Frame composited on the CPU and the texture it is shown through
+SDL_Surface* gFrameSurface = NULL;
+SDL_Texture* gFrameTexture = NULL;
+
+//Kernels in use
+KeyRowFunc gKeyRow = NULL;
+OverRowFunc gOverRow = NULL;
+int gCompositeLevel = COMPOSITE_SCALAR;
+
+
+//Scalar reference kernels, the SIMD versions have to match these exactly
+static void keyRowScalar(Uint32* dst, const Uint32* src, int count, Uint32 key)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		if ((src[i] & 0x00FFFFFF) != key)
+		{
+			dst[i] = src[i];
+		}
+	}
+}
+
+//Scales a 0-255 channel by a 0-255 factor, rounded the same way in every kernel
+static inline Uint32 mulDiv255(Uint32 channel, Uint32 factor)
+{
+	Uint32 t = channel * factor + 128;
+	return (t + (t >> 8)) >> 8;
+}
+
+static void overRowScalar(Uint32* dst, const Uint32* src, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		Uint32 s = src[i];
+		Uint32 d = dst[i];
+		Uint32 inverseAlpha = 255 - (s >> 24);
+
+		Uint32 result = 0;
+		for (int shift = 0; shift < 32; shift += 8)
+		{
+			//Saturate like the SIMD versions in case src isn't valid premultiplied alpha
+			Uint32 channel = ((s >> shift) & 0xFF) + mulDiv255((d >> shift) & 0xFF, inverseAlpha);
+			result |= (channel > 255 ? 255 : channel) << shift;
+		}
+		dst[i] = result;
+	}
+}
+
+#ifdef COMPOSITE_USE_SSE2
+static void keyRowSSE2(Uint32* dst, const Uint32* src, int count, Uint32 key)
+{
+	const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+	const __m128i keys = _mm_set1_epi32((int)key);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+
+		//All ones where the pixel is the key, those keep the destination
+		__m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(s, rgbMask), keys);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(_mm_and_si128(keyed, d), _mm_andnot_si128(keyed, s)));
+	}
+
+	keyRowScalar(dst + i, src + i, count - i, key);
+}
+
+//Multiplies eight 16 bit channels by eight 16 bit factors and divides by 255 with mulDiv255's rounding
+static inline __m128i mulDiv255SSE2(__m128i channels, __m128i factors)
+{
+	__m128i t = _mm_add_epi16(_mm_mullo_epi16(channels, factors), _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+//Widens two pixels to 16 bit channels and broadcasts 255 - alpha of each across its channels
+static inline __m128i inverseAlphaSSE2(__m128i widened)
+{
+	__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(widened, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	return _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+}
+
+static void overRowSSE2(Uint32* dst, const Uint32* src, int count)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+
+		__m128i sLow = _mm_unpacklo_epi8(s, zero);
+		__m128i sHigh = _mm_unpackhi_epi8(s, zero);
+		__m128i dLow = mulDiv255SSE2(_mm_unpacklo_epi8(d, zero), inverseAlphaSSE2(sLow));
+		__m128i dHigh = mulDiv255SSE2(_mm_unpackhi_epi8(d, zero), inverseAlphaSSE2(sHigh));
+
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_adds_epu8(s, _mm_packus_epi16(dLow, dHigh)));
+	}
+
+	overRowScalar(dst + i, src + i, count - i);
+}
+#endif
+
+#ifdef COMPOSITE_USE_AVX2
+COMPOSITE_TARGET_AVX2
+static void keyRowAVX2(Uint32* dst, const Uint32* src, int count, Uint32 key)
+{
+	const __m256i rgbMask = _mm256_set1_epi32(0x00FFFFFF);
+	const __m256i keys = _mm256_set1_epi32((int)key);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+		__m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+
+		//Eight pixels against the key at once, keyed ones take the destination
+		__m256i keyed = _mm256_cmpeq_epi32(_mm256_and_si256(s, rgbMask), keys);
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_blendv_epi8(s, d, keyed));
+	}
+
+	keyRowScalar(dst + i, src + i, count - i, key);
+}
+
+COMPOSITE_TARGET_AVX2
+static inline __m256i mulDiv255AVX2(__m256i channels, __m256i factors)
+{
+	__m256i t = _mm256_add_epi16(_mm256_mullo_epi16(channels, factors), _mm256_set1_epi16(128));
+	return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+COMPOSITE_TARGET_AVX2
+static inline __m256i inverseAlphaAVX2(__m256i widened)
+{
+	__m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(widened, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	return _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+}
+
+COMPOSITE_TARGET_AVX2
+static void overRowAVX2(Uint32* dst, const Uint32* src, int count)
+{
+	const __m256i zero = _mm256_setzero_si256();
+
+	//Unpack and pack both work within 128 bit lanes, so pixels come back out in the order they went in
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+		__m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+
+		__m256i sLow = _mm256_unpacklo_epi8(s, zero);
+		__m256i sHigh = _mm256_unpackhi_epi8(s, zero);
+		__m256i dLow = mulDiv255AVX2(_mm256_unpacklo_epi8(d, zero), inverseAlphaAVX2(sLow));
+		__m256i dHigh = mulDiv255AVX2(_mm256_unpackhi_epi8(d, zero), inverseAlphaAVX2(sHigh));
+
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_adds_epu8(s, _mm256_packus_epi16(dLow, dHigh)));
+	}
+
+	overRowScalar(dst + i, src + i, count - i);
+}
+#endif
+
+bool isCompositeLevelSupported(int level)
+{
+	switch (level)
+	{
+		case COMPOSITE_SCALAR:
+		return true;
+
+#ifdef COMPOSITE_USE_SSE2
+		case COMPOSITE_SSE2:
+		return SDL_HasSSE2() == SDL_TRUE;
+#endif
+
+#if defined(COMPOSITE_USE_AVX2) && SDL_VERSION_ATLEAST(2, 0, 4)
+		case COMPOSITE_AVX2:
+		return SDL_HasAVX2() == SDL_TRUE;
+#endif
+
+		default:
+		return false;
+	}
+}
+
+//Gets the kernels for a level, falls back to scalar for levels that weren't compiled in
+static void getCompositeKernels(int level, KeyRowFunc* keyRow, OverRowFunc* overRow)
+{
+	*keyRow = keyRowScalar;
+	*overRow = overRowScalar;
+
+#ifdef COMPOSITE_USE_SSE2
+	if (level == COMPOSITE_SSE2)
+	{
+		*keyRow = keyRowSSE2;
+		*overRow = overRowSSE2;
+	}
+#endif
+
+#ifdef COMPOSITE_USE_AVX2
+	if (level == COMPOSITE_AVX2)
+	{
+		*keyRow = keyRowAVX2;
+		*overRow = overRowAVX2;
+	}
+#endif
+}
+
+void setCompositeLevel(int level)
+{
+	gCompositeLevel = level;
+	getCompositeKernels(level, &gKeyRow, &gOverRow);
+}
+
+//Clips a sprite against dst and hands each row to the kernel
+template<class RowOp>
+static void compositeRows(SDL_Surface* dst, SDL_Surface* src, int x, int y, RowOp rowOp)
+{
+	int srcX = x < 0 ? -x : 0;
+	int srcY = y < 0 ? -y : 0;
+	int width = SDL_min(src->w, dst->w - x) - srcX;
+	int height = SDL_min(src->h, dst->h - y) - srcY;
+	if (width <= 0 || height <= 0)
+	{
+		return;
+	}
+
+	for (int row = 0; row < height; ++row)
+	{
+		const Uint32* s = (const Uint32*)((const Uint8*)src->pixels + (srcY + row) * src->pitch) + srcX;
+		Uint32* d = (Uint32*)((Uint8*)dst->pixels + (y + srcY + row) * dst->pitch) + x + srcX;
+		rowOp(d, s, width);
+	}
+}
+
+void compositeKeyed(SDL_Surface* dst, SDL_Surface* src, int x, int y, Uint32 key)
+{
+	KeyRowFunc keyRow = gKeyRow;
+	compositeRows(dst, src, x, y, [keyRow, key](Uint32* d, const Uint32* s, int count) { keyRow(d, s, count, key); });
+}
+
+void compositeOver(SDL_Surface* dst, SDL_Surface* src, int x, int y)
+{
+	compositeRows(dst, src, x, y, gOverRow);
+}
+
+bool runSelfTest()
+{
+	bool success = true;
+
+	//Odd counts and offsets so the scalar tails and unaligned loads get exercised
+	const int ROW_CAPACITY = 1024;
+	Uint32 src[ROW_CAPACITY];
+	Uint32 expected[ROW_CAPACITY];
+	Uint32 actual[ROW_CAPACITY];
+	const Uint32 key = 0x0000FFFF;
+
+	for (int level = COMPOSITE_SSE2; level < COMPOSITE_TOTAL; ++level)
+	{
+		if (!isCompositeLevelSupported(level))
+		{
+			printf("%-6s not supported on this CPU, skipped\n", COMPOSITE_LEVEL_NAMES[level]);
+			continue;
+		}
+
+		KeyRowFunc keyRow;
+		OverRowFunc overRow;
+		getCompositeKernels(level, &keyRow, &overRow);
+
+		int failures = 0;
+		for (int run = 0; run < 2000; ++run)
+		{
+			int offset = rand() % 8;
+			int count = rand() % (ROW_CAPACITY - offset);
+
+			//Random premultiplied pixels with every alpha, some of them set to the key
+			for (int i = 0; i < ROW_CAPACITY; ++i)
+			{
+				Uint32 alpha = rand() & 0xFF;
+				Uint32 pixel = alpha << 24;
+				for (int shift = 0; shift < 24; shift += 8)
+				{
+					pixel |= (Uint32)(rand() % (alpha + 1)) << shift;
+				}
+				src[i] = (rand() % 4 == 0) ? ((pixel & 0xFF000000) | key) : pixel;
+				expected[i] = actual[i] = (Uint32)rand() ^ ((Uint32)rand() << 16);
+			}
+
+			keyRowScalar(expected + offset, src + offset, count, key);
+			keyRow(actual + offset, src + offset, count, key);
+			overRowScalar(expected + offset, src + offset, count);
+			overRow(actual + offset, src + offset, count);
+
+			if (memcmp(expected, actual, sizeof(expected)) != 0)
+			{
+				++failures;
+			}
+		}
+
+		printf("%-6s %s against scalar (%d mismatched rows)\n", COMPOSITE_LEVEL_NAMES[level], failures == 0 ? "matches" : "DIFFERS", failures);
+		success = success && failures == 0;
+	}
+
+	//Time each level on full screen rows
+	for (int level = COMPOSITE_SCALAR; level < COMPOSITE_TOTAL; ++level)
+	{
+		if (!isCompositeLevelSupported(level))
+		{
+			continue;
+		}
+
+		KeyRowFunc keyRow;
+		OverRowFunc overRow;
+		getCompositeKernels(level, &keyRow, &overRow);
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (int n = 0; n < BENCHMARK_ITERATIONS; ++n)
+		{
+			for (int row = 0; row < SCREEN_HEIGHT; ++row)
+			{
+				keyRow(actual, src, SCREEN_WIDTH, key);
+			}
+		}
+		Uint64 middle = SDL_GetPerformanceCounter();
+		for (int n = 0; n < BENCHMARK_ITERATIONS; ++n)
+		{
+			for (int row = 0; row < SCREEN_HEIGHT; ++row)
+			{
+				overRow(actual, src, SCREEN_WIDTH);
+			}
+		}
+		Uint64 end = SDL_GetPerformanceCounter();
+
+		double frequency = (double)SDL_GetPerformanceFrequency();
+		printf("%-6s keyed %.3f ms, over %.3f ms per %dx%d frame\n", COMPOSITE_LEVEL_NAMES[level],
+			(middle - start) * 1000.0 / frequency / BENCHMARK_ITERATIONS, (end - middle) * 1000.0 / frequency / BENCHMARK_ITERATIONS, SCREEN_WIDTH, SCREEN_HEIGHT);
+	}
+
+	return success;
+}
+
+SDL_Surface* loadSurface(std::string path)
+{
+	//The final optimized image
+	SDL_Surface* optimizedSurface = NULL;
+
+	//Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL)
+	{
+		printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else
+	{
+		//The kernels work on ARGB8888 only
+		optimizedSurface = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_ARGB8888, 0);
+		if (optimizedSurface == NULL)
+		{
+			printf("Unable to convert image %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	return optimizedSurface;
+}
+
+SDL_Surface* createGlowSurface(int size)
+{
+	int bpp;
+	Uint32 rmask, gmask, bmask, amask;
+	SDL_PixelFormatEnumToMasks(SDL_PIXELFORMAT_ARGB8888, &bpp, &rmask, &gmask, &bmask, &amask);
+	SDL_Surface* surface = SDL_CreateRGBSurface(0, size, size, bpp, rmask, gmask, bmask, amask);
+	if (surface == NULL)
+	{
+		printf("Unable to create glow surface! SDL Error: %s\n", SDL_GetError());
+		return NULL;
+	}
+
+	//Warm orange falling off with the square of the distance from the center, stored premultiplied
+	float radius = size * 0.5f;
+	for (int y = 0; y < size; ++y)
+	{
+		Uint32* row = (Uint32*)((Uint8*)surface->pixels + y * surface->pitch);
+		for (int x = 0; x < size; ++x)
+		{
+			float dx = (x + 0.5f - radius) / radius;
+			float dy = (y + 0.5f - radius) / radius;
+			float falloff = 1.0f - (dx * dx + dy * dy);
+			falloff = falloff < 0.0f ? 0.0f : falloff * falloff;
+
+			Uint32 alpha = (Uint32)(falloff * 255.0f + 0.5f);
+			row[x] = (alpha << 24) | (alpha << 16) | ((alpha * 200 / 255) << 8) | (alpha * 80 / 255);
+		}
+	}
+
+	return surface;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Software renderer, like the CPU only machines this is written for
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_SOFTWARE);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+
+				//Frame buffer the sprites get composited into
+				int bpp;
+				Uint32 rmask, gmask, bmask, amask;
+				SDL_PixelFormatEnumToMasks(SDL_PIXELFORMAT_ARGB8888, &bpp, &rmask, &gmask, &bmask, &amask);
+				gFrameSurface = SDL_CreateRGBSurface(0, SCREEN_WIDTH, SCREEN_HEIGHT, bpp, rmask, gmask, bmask, amask);
+				gFrameTexture = SDL_CreateTexture(gRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, SCREEN_WIDTH, SCREEN_HEIGHT);
+				if (gFrameSurface == NULL || gFrameTexture == NULL)
+				{
+					printf("Unable to create frame buffer! SDL Error: %s\n", SDL_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo'
+	gFooSurface = loadSurface("Images/foo.png");
+	if (gFooSurface == NULL)
+	{
+		printf("Failed to load Foo' image!\n");
+		success = false;
+	}
+
+	//Load background
+	gBackgroundSurface = loadSurface("Images/background.png");
+	if (gBackgroundSurface == NULL)
+	{
+		printf("Failed to load background image!\n");
+		success = false;
+	}
+	else
+	{
+		//The background is opaque, copying it is enough
+		SDL_SetSurfaceBlendMode(gBackgroundSurface, SDL_BLENDMODE_NONE);
+	}
+
+	//Make the glow
+	gGlowSurface = createGlowSurface(GLOW_SIZE);
+	if (gGlowSurface == NULL)
+	{
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images
+	SDL_FreeSurface(gFooSurface);
+	SDL_FreeSurface(gBackgroundSurface);
+	SDL_FreeSurface(gGlowSurface);
+	SDL_FreeSurface(gFrameSurface);
+	gFooSurface = NULL;
+	gBackgroundSurface = NULL;
+	gGlowSurface = NULL;
+	gFrameSurface = NULL;
+
+	//Free frame texture
+	if (gFrameTexture != NULL)
+	{
+		SDL_DestroyTexture(gFrameTexture);
+		gFrameTexture = NULL;
+	}
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"selftest" checks the SIMD kernels against the scalar ones and times them, no window needed
+	if (argc >= 2 && strcmp(args[1], "selftest") == 0)
+	{
+		return runSelfTest() ? 0 : 1;
+	}
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Start with the best kernels the CPU has
+			int bestLevel = COMPOSITE_SCALAR;
+			for (int level = COMPOSITE_SCALAR; level < COMPOSITE_TOTAL; ++level)
+			{
+				if (isCompositeLevelSupported(level))
+				{
+					bestLevel = level;
+				}
+			}
+			setCompositeLevel(bestLevel);
+
+			//Cyan is the key, same as SDL_SetColorKey used to get
+			Uint32 key = SDL_MapRGB(gFooSurface->format, 0, 0xFF, 0xFF) & 0x00FFFFFF;
+
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Composite timing shown in the title once a second
+			Uint64 compositeCounter = 0;
+			int compositeCount = 0;
+			Uint32 nextTitleUpdate = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					//1, 2 and 3 pick scalar, SSE2 and AVX2
+					else if (e.type == SDL_KEYDOWN && e.key.keysym.sym >= SDLK_1 && e.key.keysym.sym < SDLK_1 + COMPOSITE_TOTAL)
+					{
+						int level = e.key.keysym.sym - SDLK_1;
+						if (isCompositeLevelSupported(level))
+						{
+							setCompositeLevel(level);
+						}
+					}
+				}
+
+				//Composite the frame on the CPU
+				Uint64 compositeStart = SDL_GetPerformanceCounter();
+				SDL_BlitSurface(gBackgroundSurface, NULL, gFrameSurface, NULL);
+
+				float time = SDL_GetTicks() / 1000.0f;
+				for (int i = 0; i < TOTAL_KEYED_SPRITES; ++i)
+				{
+					int x = (int)((i * 97) % SCREEN_WIDTH + 40.0f * SDL_sin(time + i)) - gFooSurface->w / 2;
+					int y = (int)((i * 59) % SCREEN_HEIGHT + 40.0f * SDL_cos(time * 1.3f + i)) - gFooSurface->h / 2;
+					compositeKeyed(gFrameSurface, gFooSurface, x, y, key);
+				}
+				for (int i = 0; i < TOTAL_GLOW_SPRITES; ++i)
+				{
+					int x = (int)((i * 131) % SCREEN_WIDTH + 60.0f * SDL_cos(time * 0.7f + i)) - GLOW_SIZE / 2;
+					int y = (int)((i * 83) % SCREEN_HEIGHT + 60.0f * SDL_sin(time * 0.9f + i)) - GLOW_SIZE / 2;
+					compositeOver(gFrameSurface, gGlowSurface, x, y);
+				}
+				compositeCounter += SDL_GetPerformanceCounter() - compositeStart;
+				++compositeCount;
+
+				if (SDL_GetTicks() >= nextTitleUpdate)
+				{
+					char title[128];
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s compositing %.3f ms", COMPOSITE_LEVEL_NAMES[gCompositeLevel],
+						compositeCounter * 1000.0 / SDL_GetPerformanceFrequency() / (compositeCount > 0 ? compositeCount : 1));
+					SDL_SetWindowTitle(gWindow, title);
+					compositeCounter = 0;
+					compositeCount = 0;
+					nextTitleUpdate = SDL_GetTicks() + 1000;
+				}
+
+				//Show the frame
+				SDL_UpdateTexture(gFrameTexture, NULL, gFrameSurface->pixels, gFrameSurface->pitch);
+				SDL_RenderCopy(gRenderer, gFrameTexture, NULL, NULL);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
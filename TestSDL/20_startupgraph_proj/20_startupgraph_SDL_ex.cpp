@@ -0,0 +1,718 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, SDL threads, standard IO, strings, vectors, and atomics
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_thread.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <atomic>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//A startup stage, returns false on failure
+typedef bool(*StageFunction)();
+
+//Where a stage is in the graph
+enum StageState
+{
+	STAGE_PENDING,
+	STAGE_RUNNING,
+	STAGE_DONE,
+	STAGE_FAILED,
+	STAGE_SKIPPED
+};
+
+//One node of the startup graph
+struct StartupStage
+{
+	const char* name;
+	StageFunction function;
+
+	//Window and renderer creation have to stay on the main thread, everything else may run on its own thread
+	bool mainThread;
+
+	//Stages that must be done first
+	std::vector<int> dependencies;
+
+	std::atomic<int> state;
+	Uint64 startCounter;
+	Uint64 endCounter;
+	SDL_Thread* thread;
+
+	//Graph to signal when a worker stage finishes
+	class StartupGraph* graph;
+};
+
+//A named span of time for the report, used for the stages and for lazy work that happens inside them
+struct StartupTiming
+{
+	std::string name;
+	bool mainThread;
+	Uint64 startCounter;
+	Uint64 endCounter;
+};
+
+//Runs startup stages as soon as their dependencies are done, worker stages overlapping the main thread ones
+class StartupGraph
+{
+	public:
+		//Initializes variables
+		StartupGraph();
+
+		//Waits for any worker threads still running and frees the stages
+		~StartupGraph();
+
+		//Adds a stage, returns its index for addDependency
+		int addStage(const char* name, StageFunction function, bool mainThread);
+
+		//Makes stage wait for dependency
+		void addDependency(int stage, int dependency);
+
+		//Runs every stage, returns false if any failed. Stages depending on a failed one are skipped.
+		bool run();
+
+		//Records a span for the report, safe to call from any thread
+		void addTiming(const std::string& name, Uint64 startCounter, Uint64 endCounter);
+
+		//Prints every stage and timing relative to process start
+		void printReport();
+
+	private:
+		//Thread entry for worker stages
+		static int runWorkerStage(void* data);
+
+		std::vector<StartupStage*> mStages;
+
+		//Posted each time a worker stage finishes
+		SDL_sem* mCompleted;
+
+		//Spans recorded by addTiming
+		std::vector<StartupTiming> mTimings;
+		SDL_mutex* mTimingMutex;
+};
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Creates texture from a decoded surface, the surface isn't freed
+		bool loadFromSurface(SDL_Surface* surface);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point
+		void render(int x, int y);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Startup stages
+bool initSDL();
+bool createWindow();
+bool createRenderer();
+bool decodeFoo();
+bool decodeBackground();
+bool loadMedia();
+
+//Builds and runs the startup graph
+bool init();
+
+//Frees media and shuts down SDL
+void close();
+
+//Initializes SDL_image for an image's format the first time that format is seen
+bool ensureImageFormat(const std::string& path);
+
+//Loads individual image as surface, safe to call from worker stages
+SDL_Surface* loadSurface(std::string path);
+
+//Milliseconds from process start to a performance counter value
+double getStartupMs(Uint64 counter);
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+
+//Images decoded by worker stages, waiting for the renderer
+SDL_Surface* gFooSurface = NULL;
+SDL_Surface* gBackgroundSurface = NULL;
+
+//The graph init() runs, kept around for the report
+StartupGraph* gStartupGraph = NULL;
+
+//When main started and which thread it runs on
+Uint64 gStartCounter = 0;
+SDL_threadID gMainThreadID = 0;
+
+//SDL_image formats initialized so far
+int gImageInitFlags = 0;
+SDL_mutex* gImageInitMutex = NULL;
+
+
+double getStartupMs(Uint64 counter)
+{
+	return (double)(counter - gStartCounter) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+// implementation of StartupGraph class
+StartupGraph::StartupGraph()
+{
+	mCompleted = SDL_CreateSemaphore(0);
+	mTimingMutex = SDL_CreateMutex();
+}
+
+StartupGraph::~StartupGraph()
+{
+	for (size_t i = 0; i < mStages.size(); ++i)
+	{
+		if (mStages[i]->thread != NULL)
+		{
+			SDL_WaitThread(mStages[i]->thread, NULL);
+		}
+		delete mStages[i];
+	}
+	mStages.clear();
+
+	SDL_DestroySemaphore(mCompleted);
+	SDL_DestroyMutex(mTimingMutex);
+}
+
+int StartupGraph::addStage(const char* name, StageFunction function, bool mainThread)
+{
+	StartupStage* stage = new StartupStage();
+	stage->name = name;
+	stage->function = function;
+	stage->mainThread = mainThread;
+	stage->state = STAGE_PENDING;
+	stage->startCounter = 0;
+	stage->endCounter = 0;
+	stage->thread = NULL;
+	stage->graph = this;
+
+	mStages.push_back(stage);
+	return (int)mStages.size() - 1;
+}
+
+void StartupGraph::addDependency(int stage, int dependency)
+{
+	mStages[stage]->dependencies.push_back(dependency);
+}
+
+int StartupGraph::runWorkerStage(void* data)
+{
+	StartupStage* stage = (StartupStage*)data;
+
+	stage->startCounter = SDL_GetPerformanceCounter();
+	bool success = stage->function();
+	stage->endCounter = SDL_GetPerformanceCounter();
+
+	stage->state = success ? STAGE_DONE : STAGE_FAILED;
+	SDL_SemPost(stage->graph->mCompleted);
+	return 0;
+}
+
+bool StartupGraph::run()
+{
+	int running = 0;
+
+	while (true)
+	{
+		bool progress = false;
+		int finished = 0;
+		StartupStage* mainStage = NULL;
+
+		for (size_t i = 0; i < mStages.size(); ++i)
+		{
+			StartupStage* stage = mStages[i];
+			if (stage->state != STAGE_PENDING)
+			{
+				if (stage->state != STAGE_RUNNING)
+				{
+					++finished;
+				}
+				continue;
+			}
+
+			//Ready once every dependency is done, skipped once any of them can't be
+			bool ready = true;
+			bool blocked = false;
+			for (size_t j = 0; j < stage->dependencies.size(); ++j)
+			{
+				int state = mStages[stage->dependencies[j]]->state;
+				ready = ready && state == STAGE_DONE;
+				blocked = blocked || state == STAGE_FAILED || state == STAGE_SKIPPED;
+			}
+
+			if (blocked)
+			{
+				stage->state = STAGE_SKIPPED;
+				progress = true;
+			}
+			else if (ready && !stage->mainThread)
+			{
+				//Start worker stages first so they overlap whatever the main thread does next
+				stage->state = STAGE_RUNNING;
+				stage->thread = SDL_CreateThread(runWorkerStage, stage->name, stage);
+				if (stage->thread == NULL)
+				{
+					//No thread, run it here instead
+					runWorkerStage(stage);
+					SDL_SemWait(mCompleted);
+				}
+				else
+				{
+					++running;
+				}
+				progress = true;
+			}
+			else if (ready && mainStage == NULL)
+			{
+				mainStage = stage;
+			}
+		}
+
+		//One main thread stage at a time, then look for newly ready workers again
+		if (mainStage != NULL)
+		{
+			mainStage->state = STAGE_RUNNING;
+			mainStage->startCounter = SDL_GetPerformanceCounter();
+			bool success = mainStage->function();
+			mainStage->endCounter = SDL_GetPerformanceCounter();
+			mainStage->state = success ? STAGE_DONE : STAGE_FAILED;
+			continue;
+		}
+
+		if (finished == (int)mStages.size())
+		{
+			break;
+		}
+
+		//Nothing to do on the main thread until a worker finishes
+		if (!progress)
+		{
+			if (running == 0)
+			{
+				printf("Startup graph has a dependency cycle!\n");
+				return false;
+			}
+			SDL_SemWait(mCompleted);
+			--running;
+		}
+	}
+
+	bool success = true;
+	for (size_t i = 0; i < mStages.size(); ++i)
+	{
+		if (mStages[i]->state != STAGE_DONE)
+		{
+			printf("Startup stage \"%s\" %s!\n", mStages[i]->name, mStages[i]->state == STAGE_FAILED ? "failed" : "was skipped");
+			success = false;
+		}
+	}
+	return success;
+}
+
+void StartupGraph::addTiming(const std::string& name, Uint64 startCounter, Uint64 endCounter)
+{
+	StartupTiming timing;
+	timing.name = name;
+	timing.mainThread = SDL_ThreadID() == gMainThreadID;
+	timing.startCounter = startCounter;
+	timing.endCounter = endCounter;
+
+	SDL_LockMutex(mTimingMutex);
+	mTimings.push_back(timing);
+	SDL_UnlockMutex(mTimingMutex);
+}
+
+void StartupGraph::printReport()
+{
+	printf("%-28s %-7s %10s %10s %10s\n", "startup stage", "thread", "start ms", "end ms", "took ms");
+	for (size_t i = 0; i < mStages.size(); ++i)
+	{
+		StartupStage* stage = mStages[i];
+		if (stage->state == STAGE_SKIPPED)
+		{
+			printf("%-28s %-7s %10s\n", stage->name, stage->mainThread ? "main" : "worker", "skipped");
+			continue;
+		}
+		printf("%-28s %-7s %10.2f %10.2f %10.2f\n", stage->name, stage->mainThread ? "main" : "worker",
+			getStartupMs(stage->startCounter), getStartupMs(stage->endCounter), getStartupMs(stage->endCounter) - getStartupMs(stage->startCounter));
+	}
+
+	SDL_LockMutex(mTimingMutex);
+	for (size_t i = 0; i < mTimings.size(); ++i)
+	{
+		const StartupTiming& timing = mTimings[i];
+		printf("%-28s %-7s %10.2f %10.2f %10.2f\n", timing.name.c_str(), timing.mainThread ? "main" : "worker",
+			getStartupMs(timing.startCounter), getStartupMs(timing.endCounter), getStartupMs(timing.endCounter) - getStartupMs(timing.startCounter));
+	}
+	SDL_UnlockMutex(mTimingMutex);
+}
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromSurface(SDL_Surface* surface) {
+	//Get rid of preexisting texture
+	free();
+
+	//Color key image
+	SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 0, 0xFF, 0xFF));
+
+	//Create texture from surface pixels
+	mTexture = SDL_CreateTextureFromSurface(gRenderer, surface);
+	if (mTexture == NULL) {
+		printf("Unable to create texture! SDL Error: %s\n", SDL_GetError());
+	}
+	else {
+		//Get image dimensions
+		mWidth = surface->w;
+		mHeight = surface->h;
+	}
+
+	// Return success
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+bool ensureImageFormat(const std::string& path)
+{
+	//Formats SDL_image needs a library loaded for, BMP and the other built in ones need nothing
+	struct FormatFlag
+	{
+		const char* extension;
+		int flag;
+		const char* name;
+	};
+	const FormatFlag formats[] = {
+		{ ".png", IMG_INIT_PNG, "png" },
+		{ ".jpg", IMG_INIT_JPG, "jpg" },
+		{ ".jpeg", IMG_INIT_JPG, "jpg" },
+		{ ".tif", IMG_INIT_TIF, "tif" },
+		{ ".tiff", IMG_INIT_TIF, "tif" },
+		{ ".webp", IMG_INIT_WEBP, "webp" }
+	};
+
+	size_t dot = path.rfind('.');
+	if (dot == std::string::npos)
+	{
+		return true;
+	}
+
+	for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i)
+	{
+		if (SDL_strcasecmp(path.c_str() + dot, formats[i].extension) != 0)
+		{
+			continue;
+		}
+
+		//Decode stages run in parallel, only the first one to see a format initializes it
+		bool success = true;
+		SDL_LockMutex(gImageInitMutex);
+		if (!(gImageInitFlags & formats[i].flag))
+		{
+			Uint64 start = SDL_GetPerformanceCounter();
+			success = (IMG_Init(formats[i].flag) & formats[i].flag) != 0;
+			gStartupGraph->addTiming(std::string("IMG_Init ") + formats[i].name + " (lazy)", start, SDL_GetPerformanceCounter());
+
+			if (success)
+			{
+				gImageInitFlags |= formats[i].flag;
+			}
+			else
+			{
+				printf("SDL_image could not initialize %s! SDL_image Error: %s\n", formats[i].name, IMG_GetError());
+			}
+		}
+		SDL_UnlockMutex(gImageInitMutex);
+		return success;
+	}
+
+	return true;
+}
+
+SDL_Surface* loadSurface(std::string path)
+{
+	if (!ensureImageFormat(path))
+	{
+		return NULL;
+	}
+
+	//Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL)
+	{
+		printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+
+	return loadedSurface;
+}
+
+bool initSDL()
+{
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	//Set texture filtering to linear
+	if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+	{
+		printf("Warning: Linear texture filtering not enabled!");
+	}
+
+	return true;
+}
+
+bool createWindow()
+{
+	//Create window
+	gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+	if (gWindow == NULL)
+	{
+		printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	return true;
+}
+
+bool createRenderer()
+{
+	//Create renderer for window
+	gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
+	if (gRenderer == NULL)
+	{
+		printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	//Initialize renderer color
+	SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+	return true;
+}
+
+bool decodeFoo()
+{
+	gFooSurface = loadSurface("Images/foo.png");
+	return gFooSurface != NULL;
+}
+
+bool decodeBackground()
+{
+	gBackgroundSurface = loadSurface("Images/background.png");
+	return gBackgroundSurface != NULL;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Upload Foo' texture
+	if (!gFooTexture.loadFromSurface(gFooSurface))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Upload background texture
+	if (!gBackgroundTexture.loadFromSurface(gBackgroundSurface))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	//The decoded pixels aren't needed anymore
+	SDL_FreeSurface(gFooSurface);
+	SDL_FreeSurface(gBackgroundSurface);
+	gFooSurface = NULL;
+	gBackgroundSurface = NULL;
+
+	return success;
+}
+
+bool init()
+{
+	gImageInitMutex = SDL_CreateMutex();
+	gStartupGraph = new StartupGraph();
+
+	//SDL, the window and the renderer have to happen in order on the main thread.
+	//Decoding needs none of them and runs alongside, textures are created once both sides are done.
+	int sdl = gStartupGraph->addStage("SDL_Init", initSDL, true);
+	int window = gStartupGraph->addStage("create window", createWindow, true);
+	int renderer = gStartupGraph->addStage("create renderer", createRenderer, true);
+	int foo = gStartupGraph->addStage("decode foo.png", decodeFoo, false);
+	int background = gStartupGraph->addStage("decode background.png", decodeBackground, false);
+	int media = gStartupGraph->addStage("create textures", loadMedia, true);
+
+	gStartupGraph->addDependency(window, sdl);
+	gStartupGraph->addDependency(renderer, window);
+	gStartupGraph->addDependency(media, renderer);
+	gStartupGraph->addDependency(media, foo);
+	gStartupGraph->addDependency(media, background);
+
+	return gStartupGraph->run();
+}
+
+void close()
+{
+	//Free loaded images
+	gFooTexture.free();
+	gBackgroundTexture.free();
+	SDL_FreeSurface(gFooSurface);
+	SDL_FreeSurface(gBackgroundSurface);
+	gFooSurface = NULL;
+	gBackgroundSurface = NULL;
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//The graph waits for any stage threads still running
+	delete gStartupGraph;
+	gStartupGraph = NULL;
+	SDL_DestroyMutex(gImageInitMutex);
+	gImageInitMutex = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Everything in the report is measured from here
+	gStartCounter = SDL_GetPerformanceCounter();
+	gMainThreadID = SDL_ThreadID();
+
+	//"batch" exits after the first frame, the way short lived render processes run
+	bool batch = argc >= 2 && strcmp(args[1], "batch") == 0;
+
+	//Start up SDL, create window and load media
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+		gStartupGraph->printReport();
+	}
+	else
+	{
+		//Main loop flag
+		bool quit = false;
+
+		//Event handler
+		SDL_Event e;
+
+		//Whether the startup report has been printed
+		bool reported = false;
+
+		//While application is running
+		while (!quit)
+		{
+			//Handle events on queue
+			while (SDL_PollEvent(&e) != 0)
+			{
+				//User requests quit
+				if (e.type == SDL_QUIT)
+				{
+					quit = true;
+				}
+			}
+
+			//Clear screen
+			SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+			SDL_RenderClear(gRenderer);
+
+			//Render background texture to screen
+			gBackgroundTexture.render(0, 0);
+
+			//Render Foo' to the screen
+			gFooTexture.render(240, 190);
+
+			//Update screen
+			SDL_RenderPresent(gRenderer);
+
+			//Time to first frame ends the report
+			if (!reported)
+			{
+				gStartupGraph->addTiming("first frame presented", gStartCounter, SDL_GetPerformanceCounter());
+				gStartupGraph->printReport();
+				reported = true;
+				quit = quit || batch;
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,576 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, and strings
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Probe workload: frames timed per backend, and what each frame draws on top of the background
+const int PROBE_WARMUP_FRAMES = 5;
+const int PROBE_FRAMES = 30;
+const int PROBE_SPRITES = 500;
+const int PROBE_RECTS = 100;
+
+//File in the preferences folder remembering the probe result
+const char* RENDERER_CACHE_FILE = "renderer.cfg";
+
+//How init() picks a renderer
+enum RendererSelect
+{
+	//Use the cached choice if there is one, otherwise probe
+	RENDERER_SELECT_CACHED,
+
+	//Probe even if there is a cached choice
+	RENDERER_SELECT_PROBE,
+
+	//No probing, first accelerated driver that works, software if none does
+	RENDERER_SELECT_DEFAULT
+};
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point
+		void render(int x, int y);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Starts up SDL and creates window
+bool init(RendererSelect select);
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Lists the render drivers this SDL build has
+void printRenderDrivers();
+
+//Creates a renderer for the window according to select, sets gRendererName and gRendererThroughput
+SDL_Renderer* createRenderer(SDL_Window* window, RendererSelect select);
+
+//Draws the probe workload on the current gRenderer, returns draws per second or 0 if it couldn't run
+double benchmarkRenderer();
+
+//Reads and writes the cached choice
+bool loadRendererCache(std::string& driver, double& throughput);
+void saveRendererCache(const std::string& driver, double throughput);
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Chosen driver and its measured draws per second, 0 when it wasn't measured
+std::string gRendererName;
+double gRendererThroughput = 0.0;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL_Image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else {
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else {
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+void printRenderDrivers()
+{
+	int count = SDL_GetNumRenderDrivers();
+	printf("%d render drivers:\n", count);
+	for (int i = 0; i < count; ++i)
+	{
+		SDL_RendererInfo info;
+		if (SDL_GetRenderDriverInfo(i, &info) == 0)
+		{
+			printf("  %d: %-12s %s%s%s max texture %dx%d\n", i, info.name,
+				(info.flags & SDL_RENDERER_ACCELERATED) ? "accelerated " : "",
+				(info.flags & SDL_RENDERER_SOFTWARE) ? "software " : "",
+				(info.flags & SDL_RENDERER_TARGETTEXTURE) ? "target-texture " : "",
+				info.max_texture_width, info.max_texture_height);
+		}
+	}
+}
+
+bool loadRendererCache(std::string& driver, double& throughput)
+{
+	char* prefPath = SDL_GetPrefPath("LazyFoo", "SDLTutorial");
+	if (prefPath == NULL)
+	{
+		return false;
+	}
+	std::string path = std::string(prefPath) + RENDERER_CACHE_FILE;
+	SDL_free(prefPath);
+
+	FILE* file = fopen(path.c_str(), "r");
+	if (file == NULL)
+	{
+		return false;
+	}
+
+	//driver=<name> and throughput=<draws per second>, one per line
+	char name[64] = "";
+	double value = 0.0;
+	bool success = fscanf(file, "driver=%63s\nthroughput=%lf", name, &value) == 2;
+	fclose(file);
+
+	if (success)
+	{
+		driver = name;
+		throughput = value;
+	}
+	return success;
+}
+
+void saveRendererCache(const std::string& driver, double throughput)
+{
+	char* prefPath = SDL_GetPrefPath("LazyFoo", "SDLTutorial");
+	if (prefPath == NULL)
+	{
+		printf("Warning: no preferences folder, renderer choice won't be cached! SDL Error: %s\n", SDL_GetError());
+		return;
+	}
+	std::string path = std::string(prefPath) + RENDERER_CACHE_FILE;
+	SDL_free(prefPath);
+
+	FILE* file = fopen(path.c_str(), "w");
+	if (file == NULL)
+	{
+		printf("Warning: unable to write %s!\n", path.c_str());
+		return;
+	}
+	fprintf(file, "driver=%s\nthroughput=%.0f\n", driver.c_str(), throughput);
+	fclose(file);
+}
+
+double benchmarkRenderer()
+{
+	//The workload uses the scene textures, loaded for this renderer and dropped again afterwards
+	LTexture foo;
+	LTexture background;
+	if (!foo.loadFromFile("Images/foo.png") || !background.loadFromFile("Images/background.png"))
+	{
+		return 0.0;
+	}
+
+	SDL_Rect rects[PROBE_RECTS];
+	for (int i = 0; i < PROBE_RECTS; ++i)
+	{
+		rects[i].x = (i * 53) % SCREEN_WIDTH;
+		rects[i].y = (i * 31) % SCREEN_HEIGHT;
+		rects[i].w = 16 + i % 48;
+		rects[i].h = 16 + i % 32;
+	}
+
+	Uint64 start = 0;
+	for (int frame = 0; frame < PROBE_WARMUP_FRAMES + PROBE_FRAMES; ++frame)
+	{
+		if (frame == PROBE_WARMUP_FRAMES)
+		{
+			start = SDL_GetPerformanceCounter();
+		}
+
+		//Full screen copy, lots of small keyed sprites, and a batch of translucent fills
+		SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+		SDL_RenderClear(gRenderer);
+		background.render(0, 0);
+		for (int i = 0; i < PROBE_SPRITES; ++i)
+		{
+			foo.render((i * 37 + frame * 3) % SCREEN_WIDTH - foo.getWidth() / 2, (i * 23 + frame * 2) % SCREEN_HEIGHT - foo.getHeight() / 2);
+		}
+		SDL_SetRenderDrawBlendMode(gRenderer, SDL_BLENDMODE_BLEND);
+		SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0xFF, 0x40);
+		SDL_RenderFillRects(gRenderer, rects, PROBE_RECTS);
+		SDL_SetRenderDrawBlendMode(gRenderer, SDL_BLENDMODE_NONE);
+		SDL_RenderPresent(gRenderer);
+	}
+
+	//Reading a pixel back waits for the GPU, otherwise we'd only be timing command submission
+	Uint32 pixel = 0;
+	SDL_Rect pixelRect = { 0, 0, 1, 1 };
+	SDL_RenderReadPixels(gRenderer, &pixelRect, SDL_PIXELFORMAT_ARGB8888, &pixel, sizeof(pixel));
+
+	double seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+	return seconds > 0.0 ? PROBE_FRAMES * (2.0 + PROBE_SPRITES + PROBE_RECTS) / seconds : 0.0;
+}
+
+//Creates a renderer with one driver by index, software drivers get the software flag
+static SDL_Renderer* createRendererForDriver(SDL_Window* window, int index, const SDL_RendererInfo& info)
+{
+	return SDL_CreateRenderer(window, index, (info.flags & SDL_RENDERER_SOFTWARE) ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED);
+}
+
+SDL_Renderer* createRenderer(SDL_Window* window, RendererSelect select)
+{
+	SDL_Renderer* renderer = NULL;
+	gRendererName.clear();
+	gRendererThroughput = 0.0;
+
+	//A cached choice skips the probe as long as that driver still works
+	std::string cachedDriver;
+	double cachedThroughput = 0.0;
+	if (select == RENDERER_SELECT_CACHED && loadRendererCache(cachedDriver, cachedThroughput))
+	{
+		for (int i = 0; i < SDL_GetNumRenderDrivers() && renderer == NULL; ++i)
+		{
+			SDL_RendererInfo info;
+			if (SDL_GetRenderDriverInfo(i, &info) == 0 && cachedDriver == info.name)
+			{
+				renderer = createRendererForDriver(window, i, info);
+			}
+		}
+
+		if (renderer != NULL)
+		{
+			gRendererName = cachedDriver;
+			gRendererThroughput = cachedThroughput;
+			printf("Using cached renderer %s (%.0f draws/s)\n", cachedDriver.c_str(), cachedThroughput);
+			return renderer;
+		}
+		printf("Cached renderer %s is unavailable, probing again\n", cachedDriver.c_str());
+	}
+
+	//Try every driver on the real window and keep the fastest
+	if (select != RENDERER_SELECT_DEFAULT)
+	{
+		int bestIndex = -1;
+		double bestThroughput = 0.0;
+		std::string bestName;
+
+		for (int i = 0; i < SDL_GetNumRenderDrivers(); ++i)
+		{
+			SDL_RendererInfo info;
+			if (SDL_GetRenderDriverInfo(i, &info) != 0)
+			{
+				continue;
+			}
+
+			gRenderer = createRendererForDriver(window, i, info);
+			if (gRenderer == NULL)
+			{
+				printf("  %-12s unavailable: %s\n", info.name, SDL_GetError());
+				continue;
+			}
+
+			double throughput = benchmarkRenderer();
+			printf("  %-12s %.0f draws/s\n", info.name, throughput);
+			if (throughput > bestThroughput)
+			{
+				bestThroughput = throughput;
+				bestIndex = i;
+				bestName = info.name;
+			}
+
+			SDL_DestroyRenderer(gRenderer);
+			gRenderer = NULL;
+		}
+
+		if (bestIndex >= 0)
+		{
+			SDL_RendererInfo info;
+			SDL_GetRenderDriverInfo(bestIndex, &info);
+			renderer = createRendererForDriver(window, bestIndex, info);
+			if (renderer != NULL)
+			{
+				gRendererName = bestName;
+				gRendererThroughput = bestThroughput;
+				saveRendererCache(bestName, bestThroughput);
+				printf("Probed renderer %s is fastest\n", bestName.c_str());
+				return renderer;
+			}
+		}
+	}
+
+	//No probe, or nothing survived it: any accelerated renderer, then software
+	renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+	if (renderer == NULL)
+	{
+		printf("Warning: no accelerated renderer (%s), falling back to software\n", SDL_GetError());
+		renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+	}
+
+	if (renderer != NULL)
+	{
+		SDL_RendererInfo info;
+		SDL_GetRendererInfo(renderer, &info);
+		gRendererName = info.name;
+	}
+	return renderer;
+}
+
+bool init(RendererSelect select)
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Initialize PNG loading, the probe needs it before there is a renderer
+		int imgFlags = IMG_INIT_PNG;
+		if (!(IMG_Init(imgFlags) & imgFlags))
+		{
+			printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+			success = false;
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Pick and create renderer for window
+			printRenderDrivers();
+			gRenderer = createRenderer(gWindow, select);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' texture
+	if (!gFooTexture.loadFromFile("Images/foo.png"))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Load background texture
+	if (!gBackgroundTexture.loadFromFile("Images/background.png"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images
+	gFooTexture.free();
+	gBackgroundTexture.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"probe" ignores the cached choice, "noprobe" never benchmarks
+	RendererSelect select = RENDERER_SELECT_CACHED;
+	if (argc >= 2 && strcmp(args[1], "probe") == 0)
+	{
+		select = RENDERER_SELECT_PROBE;
+	}
+	else if (argc >= 2 && strcmp(args[1], "noprobe") == 0)
+	{
+		select = RENDERER_SELECT_DEFAULT;
+	}
+
+	//Start up SDL and create window
+	if (!init(select))
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Show which backend won
+			char title[128];
+			if (gRendererThroughput > 0.0)
+			{
+				SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s renderer, %.0f draws/s", gRendererName.c_str(), gRendererThroughput);
+			}
+			else
+			{
+				SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s renderer", gRendererName.c_str());
+			}
+			SDL_SetWindowTitle(gWindow, title);
+
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render background texture to screen
+				gBackgroundTexture.render(0, 0);
+
+				//Render Foo' to the screen
+				gFooTexture.render(240, 190);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,1178 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, random numbers, strings, and containers
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Built in font covers printable ASCII, 8x8 pixels per glyph
+const int FONT_FIRST_CHAR = 0x20;
+const int FONT_GLYPH_COUNT = 0x7F - 0x20;
+const int FONT_CELL_SIZE = 8;
+
+//Damage number limits, and frames timed per mode by the benchmark
+const int DEFAULT_LABELS = 2000;
+const int MAX_LABELS = 32000;
+const int BENCHMARK_FRAMES = 300;
+
+//8x8 glyph bitmaps, one byte per row, least significant bit is the leftmost pixel (public domain font8x8)
+const Uint8 FONT_8X8[FONT_GLYPH_COUNT][FONT_CELL_SIZE] =
+{
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	//space
+	{ 0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00 },	//!
+	{ 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	//"
+	{ 0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00 },	//#
+	{ 0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00 },	//$
+	{ 0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00 },	//%
+	{ 0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00 },	//&
+	{ 0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00 },	//'
+	{ 0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00 },	//(
+	{ 0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00 },	//)
+	{ 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00 },	//*
+	{ 0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00 },	//+
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06 },	//,
+	{ 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00 },	//-
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00 },	//.
+	{ 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00 },	///
+	{ 0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00 },	//0
+	{ 0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00 },	//1
+	{ 0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00 },	//2
+	{ 0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00 },	//3
+	{ 0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00 },	//4
+	{ 0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00 },	//5
+	{ 0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00 },	//6
+	{ 0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00 },	//7
+	{ 0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00 },	//8
+	{ 0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00 },	//9
+	{ 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00 },	//:
+	{ 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06 },	//;
+	{ 0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00 },	//<
+	{ 0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00 },	//=
+	{ 0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00 },	//>
+	{ 0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00 },	//?
+	{ 0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00 },	//@
+	{ 0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00 },	//A
+	{ 0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00 },	//B
+	{ 0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00 },	//C
+	{ 0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00 },	//D
+	{ 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00 },	//E
+	{ 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00 },	//F
+	{ 0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00 },	//G
+	{ 0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00 },	//H
+	{ 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },	//I
+	{ 0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00 },	//J
+	{ 0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00 },	//K
+	{ 0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00 },	//L
+	{ 0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00 },	//M
+	{ 0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00 },	//N
+	{ 0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00 },	//O
+	{ 0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00 },	//P
+	{ 0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00 },	//Q
+	{ 0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00 },	//R
+	{ 0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00 },	//S
+	{ 0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },	//T
+	{ 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00 },	//U
+	{ 0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 },	//V
+	{ 0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00 },	//W
+	{ 0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00 },	//X
+	{ 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00 },	//Y
+	{ 0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00 },	//Z
+	{ 0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00 },	//[
+	{ 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00 },	//backslash
+	{ 0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00 },	//]
+	{ 0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00 },	//^
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF },	//_
+	{ 0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },	//`
+	{ 0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00 },	//a
+	{ 0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00 },	//b
+	{ 0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00 },	//c
+	{ 0x38, 0x30, 0x30, 0x3E, 0x33, 0x33, 0x6E, 0x00 },	//d
+	{ 0x00, 0x00, 0x1E, 0x33, 0x3F, 0x03, 0x1E, 0x00 },	//e
+	{ 0x1C, 0x36, 0x06, 0x0F, 0x06, 0x06, 0x0F, 0x00 },	//f
+	{ 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F },	//g
+	{ 0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00 },	//h
+	{ 0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },	//i
+	{ 0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E },	//j
+	{ 0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00 },	//k
+	{ 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },	//l
+	{ 0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00 },	//m
+	{ 0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00 },	//n
+	{ 0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00 },	//o
+	{ 0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F },	//p
+	{ 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78 },	//q
+	{ 0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00 },	//r
+	{ 0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00 },	//s
+	{ 0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00 },	//t
+	{ 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00 },	//u
+	{ 0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 },	//v
+	{ 0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00 },	//w
+	{ 0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00 },	//x
+	{ 0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F },	//y
+	{ 0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00 },	//z
+	{ 0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00 },	//{
+	{ 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00 },	//|
+	{ 0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00 },	//}
+	{ 0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	//~
+};
+
+//A glyph's place in the atlas and how far it moves the pen
+struct Glyph
+{
+	//Atlas page and the glyph's rectangle on it
+	int page;
+	SDL_Rect clip;
+
+	//Pen advance after drawing it
+	int advance;
+};
+
+//A glyph positioned relative to the start of a run
+struct GlyphQuad
+{
+	int page;
+	SDL_Rect clip;
+	int x;
+	int y;
+};
+
+//A laid out string, cached by the font for static text
+struct TextRun
+{
+	std::vector<GlyphQuad> quads;
+	int width;
+	int height;
+};
+
+//Bitmap font rasterized once into atlas pages, text is queued each frame and drawn with one draw per page
+class LBitmapFont
+{
+	public:
+		//Initializes variables
+		LBitmapFont();
+
+		//Deallocates memory
+		~LBitmapFont();
+
+		//Rasterizes the built in glyphs at scale into pages of pageSize x pageSize
+		bool create(int scale, int pageSize);
+
+		//Deallocates atlas pages and cached runs
+		void free();
+
+		//Lays out a static string the first time it's asked for and keeps it
+		const TextRun& getRun(const std::string& text);
+
+		//Adds a cached run to this frame's batch
+		void queueRun(const TextRun& run, int x, int y, SDL_Color color);
+
+		//Lays out text straight into this frame's batch, for strings that change every frame
+		void queueText(const char* text, int x, int y, SDL_Color color);
+
+		//Formats and queues a number without touching the heap
+		void queueNumber(int value, int x, int y, SDL_Color color);
+
+		//Draws everything queued and empties the batch, returns the number of draw calls
+		int flush(bool batched);
+
+		//Gets font metrics and stats
+		int getLineHeight();
+		int getTextWidth(const char* text);
+		int getPageCount();
+		int getCachedRunCount();
+		int getLastGlyphCount();
+
+	private:
+		//A glyph waiting in the batch
+		struct QueuedQuad
+		{
+			SDL_Rect clip;
+			SDL_Rect dst;
+			SDL_Color color;
+		};
+
+		//Adds one glyph to its page's batch
+		void queueGlyph(int page, const SDL_Rect& clip, int x, int y, SDL_Color color);
+
+		//Draws one page's quads with a copy per glyph
+		void renderPageCopies(int page);
+
+		//Atlas page textures
+		std::vector<SDL_Texture*> mPages;
+
+		//Glyph lookup, indexed from FONT_FIRST_CHAR
+		Glyph mGlyphs[FONT_GLYPH_COUNT];
+
+		//Cached runs for static strings
+		std::map<std::string, TextRun> mRuns;
+
+		//Quads queued this frame, one list per page, cleared but never shrunk
+		std::vector< std::vector<QueuedQuad> > mQueue;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+		//Geometry scratch, the index pattern only grows
+		std::vector<SDL_Vertex> mVertices;
+		std::vector<int> mIndices;
+#endif
+
+		//Font metrics
+		int mScale;
+		int mPageSize;
+		int mLineHeight;
+
+		//Glyphs drawn by the last flush
+		int mLastGlyphCount;
+};
+
+//A floating damage number
+struct DamageLabel
+{
+	float x;
+	float y;
+	float velX;
+	float velY;
+	int value;
+	int step;
+	int life;
+	SDL_Color color;
+};
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point
+		void render(int x, int y);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Gives a label a fresh value, position and lifetime
+void spawnLabel(DamageLabel& label);
+
+//Moves the labels and respawns the ones that expired
+void updateLabels();
+
+//Draws the scene, the labels and the stats overlay, returns the draw calls the fonts made
+int renderFrame(bool batched, int frameMicroseconds);
+
+//Times the same scene with and without batching
+void runBenchmark();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+
+//Small font for the overlay, large one for damage numbers
+LBitmapFont gOverlayFont;
+LBitmapFont gLabelFont;
+
+//Live damage numbers
+std::vector<DamageLabel> gLabels;
+
+//Textures created by the fonts, stays put no matter how much text changes
+int gFontTexturesCreated = 0;
+
+
+LBitmapFont::LBitmapFont()
+{
+	//Initialize
+	mScale = 0;
+	mPageSize = 0;
+	mLineHeight = 0;
+	mLastGlyphCount = 0;
+	memset(mGlyphs, 0, sizeof(mGlyphs));
+}
+
+LBitmapFont::~LBitmapFont()
+{
+	//Deallocate
+	free();
+}
+
+bool LBitmapFont::create(int scale, int pageSize)
+{
+	//Get rid of preexisting atlas
+	free();
+
+	mScale = scale;
+	mPageSize = pageSize;
+	mLineHeight = (FONT_CELL_SIZE + 1) * scale;
+
+	//Shelf pack the glyphs, trimmed to the columns they use, with a pixel of padding so filtering can't bleed
+	int firstColumns[FONT_GLYPH_COUNT];
+	int penX = 1;
+	int penY = 1;
+	int shelfHeight = 0;
+	int pageCount = 1;
+	for (int i = 0; i < FONT_GLYPH_COUNT; ++i)
+	{
+		//Columns this glyph actually uses
+		Uint8 columns = 0;
+		for (int row = 0; row < FONT_CELL_SIZE; ++row)
+		{
+			columns |= FONT_8X8[i][row];
+		}
+
+		//Blank glyphs get half a cell, digits keep a fixed width so changing numbers don't jitter
+		int left = 0;
+		int right = FONT_CELL_SIZE / 2 - 1;
+		int c = i + FONT_FIRST_CHAR;
+		if (c >= '0' && c <= '9')
+		{
+			right = FONT_CELL_SIZE - 2;
+		}
+		else if (columns != 0)
+		{
+			while (!(columns & (1 << left)))
+			{
+				++left;
+			}
+			right = FONT_CELL_SIZE - 1;
+			while (!(columns & (1 << right)))
+			{
+				--right;
+			}
+		}
+
+		int w = (right - left + 1) * scale;
+		int h = FONT_CELL_SIZE * scale;
+		if (w + 2 > pageSize || h + 2 > pageSize)
+		{
+			printf("Font scale %d doesn't fit a %dx%d atlas page!\n", scale, pageSize, pageSize);
+			return false;
+		}
+
+		//Next shelf when the row is full, next page when the shelves are
+		if (penX + w + 1 > pageSize)
+		{
+			penX = 1;
+			penY += shelfHeight + 1;
+			shelfHeight = 0;
+		}
+		if (penY + h + 1 > pageSize)
+		{
+			penX = 1;
+			penY = 1;
+			shelfHeight = 0;
+			++pageCount;
+		}
+
+		Glyph& glyph = mGlyphs[i];
+		glyph.page = pageCount - 1;
+		glyph.clip.x = penX;
+		glyph.clip.y = penY;
+		glyph.clip.w = w;
+		glyph.clip.h = h;
+		glyph.advance = w + scale;
+		firstColumns[i] = left;
+
+		penX += w + 1;
+		if (h > shelfHeight)
+		{
+			shelfHeight = h;
+		}
+	}
+
+	//Rasterize each page into white pixels with coverage in alpha, so color comes from modulation
+	Uint32 rMask, gMask, bMask, aMask;
+	int bpp;
+	SDL_PixelFormatEnumToMasks(SDL_PIXELFORMAT_RGBA8888, &bpp, &rMask, &gMask, &bMask, &aMask);
+	bool success = true;
+	for (int page = 0; page < pageCount && success; ++page)
+	{
+		SDL_Surface* surface = SDL_CreateRGBSurface(0, pageSize, pageSize, bpp, rMask, gMask, bMask, aMask);
+		if (surface == NULL)
+		{
+			printf("Unable to create font atlas surface! SDL Error: %s\n", SDL_GetError());
+			success = false;
+			break;
+		}
+
+		Uint32 clear = SDL_MapRGBA(surface->format, 0xFF, 0xFF, 0xFF, 0x00);
+		Uint32 solid = SDL_MapRGBA(surface->format, 0xFF, 0xFF, 0xFF, 0xFF);
+		SDL_FillRect(surface, NULL, clear);
+
+		SDL_LockSurface(surface);
+		for (int i = 0; i < FONT_GLYPH_COUNT; ++i)
+		{
+			const Glyph& glyph = mGlyphs[i];
+			if (glyph.page != page)
+			{
+				continue;
+			}
+
+			//Each set bit becomes a scale x scale block
+			for (int row = 0; row < FONT_CELL_SIZE; ++row)
+			{
+				for (int column = firstColumns[i]; column < FONT_CELL_SIZE; ++column)
+				{
+					if (!(FONT_8X8[i][row] & (1 << column)))
+					{
+						continue;
+					}
+
+					int x = glyph.clip.x + (column - firstColumns[i]) * scale;
+					for (int sy = 0; sy < scale; ++sy)
+					{
+						Uint32* pixels = (Uint32*)((Uint8*)surface->pixels + (glyph.clip.y + row * scale + sy) * surface->pitch);
+						for (int sx = 0; sx < scale; ++sx)
+						{
+							pixels[x + sx] = solid;
+						}
+					}
+				}
+			}
+		}
+		SDL_UnlockSurface(surface);
+
+		//Upload the page
+		SDL_Texture* texture = SDL_CreateTextureFromSurface(gRenderer, surface);
+		if (texture == NULL)
+		{
+			printf("Unable to create font atlas texture! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+			mPages.push_back(texture);
+			++gFontTexturesCreated;
+		}
+		SDL_FreeSurface(surface);
+	}
+
+	if (!success)
+	{
+		free();
+		return false;
+	}
+
+	mQueue.resize(mPages.size());
+	return true;
+}
+
+void LBitmapFont::free()
+{
+	//Free atlas pages if they exist
+	for (size_t i = 0; i < mPages.size(); ++i)
+	{
+		SDL_DestroyTexture(mPages[i]);
+	}
+	mPages.clear();
+	mQueue.clear();
+	mRuns.clear();
+	mScale = 0;
+	mPageSize = 0;
+	mLineHeight = 0;
+}
+
+const TextRun& LBitmapFont::getRun(const std::string& text)
+{
+	//Already laid out
+	std::map<std::string, TextRun>::iterator found = mRuns.find(text);
+	if (found != mRuns.end())
+	{
+		return found->second;
+	}
+
+	//Lay it out once, newlines start a new line
+	TextRun& run = mRuns[text];
+	run.quads.reserve(text.size());
+	run.width = 0;
+	run.height = mLineHeight;
+
+	int penX = 0;
+	int penY = 0;
+	for (size_t i = 0; i < text.size(); ++i)
+	{
+		int c = (unsigned char)text[i];
+		if (c == '\n')
+		{
+			penX = 0;
+			penY += mLineHeight;
+			run.height += mLineHeight;
+			continue;
+		}
+		if (c < FONT_FIRST_CHAR || c >= FONT_FIRST_CHAR + FONT_GLYPH_COUNT)
+		{
+			c = '?';
+		}
+
+		const Glyph& glyph = mGlyphs[c - FONT_FIRST_CHAR];
+		if (c != ' ')
+		{
+			GlyphQuad quad = { glyph.page, glyph.clip, penX, penY };
+			run.quads.push_back(quad);
+		}
+		penX += glyph.advance;
+		if (penX > run.width)
+		{
+			run.width = penX;
+		}
+	}
+
+	return run;
+}
+
+void LBitmapFont::queueGlyph(int page, const SDL_Rect& clip, int x, int y, SDL_Color color)
+{
+	QueuedQuad quad;
+	quad.clip = clip;
+	quad.dst.x = x;
+	quad.dst.y = y;
+	quad.dst.w = clip.w;
+	quad.dst.h = clip.h;
+	quad.color = color;
+	mQueue[page].push_back(quad);
+}
+
+void LBitmapFont::queueRun(const TextRun& run, int x, int y, SDL_Color color)
+{
+	for (size_t i = 0; i < run.quads.size(); ++i)
+	{
+		const GlyphQuad& quad = run.quads[i];
+		queueGlyph(quad.page, quad.clip, x + quad.x, y + quad.y, color);
+	}
+}
+
+void LBitmapFont::queueText(const char* text, int x, int y, SDL_Color color)
+{
+	int penX = x;
+	for (const char* p = text; *p != '\0'; ++p)
+	{
+		int c = (unsigned char)*p;
+		if (c == '\n')
+		{
+			penX = x;
+			y += mLineHeight;
+			continue;
+		}
+		if (c < FONT_FIRST_CHAR || c >= FONT_FIRST_CHAR + FONT_GLYPH_COUNT)
+		{
+			c = '?';
+		}
+
+		const Glyph& glyph = mGlyphs[c - FONT_FIRST_CHAR];
+		if (c != ' ')
+		{
+			queueGlyph(glyph.page, glyph.clip, penX, y, color);
+		}
+		penX += glyph.advance;
+	}
+}
+
+void LBitmapFont::queueNumber(int value, int x, int y, SDL_Color color)
+{
+	//Digits are written backwards into a stack buffer, big enough for INT_MIN
+	char digits[12];
+	char* p = digits + sizeof(digits) - 1;
+	*p = '\0';
+
+	unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+	do
+	{
+		*--p = (char)('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+	if (value < 0)
+	{
+		*--p = '-';
+	}
+
+	queueText(p, x, y, color);
+}
+
+void LBitmapFont::renderPageCopies(int page)
+{
+	SDL_Texture* texture = mPages[page];
+	const std::vector<QueuedQuad>& quads = mQueue[page];
+
+	//Only touch the modulation when the color actually changes
+	SDL_Color current = { 0xFF, 0xFF, 0xFF, 0xFF };
+	SDL_SetTextureColorMod(texture, current.r, current.g, current.b);
+	SDL_SetTextureAlphaMod(texture, current.a);
+	for (size_t i = 0; i < quads.size(); ++i)
+	{
+		const QueuedQuad& quad = quads[i];
+		if (quad.color.r != current.r || quad.color.g != current.g || quad.color.b != current.b)
+		{
+			SDL_SetTextureColorMod(texture, quad.color.r, quad.color.g, quad.color.b);
+		}
+		if (quad.color.a != current.a)
+		{
+			SDL_SetTextureAlphaMod(texture, quad.color.a);
+		}
+		current = quad.color;
+
+		SDL_RenderCopy(gRenderer, texture, &quad.clip, &quad.dst);
+	}
+
+	//Leave the page unmodulated for the next user
+	SDL_SetTextureColorMod(texture, 0xFF, 0xFF, 0xFF);
+	SDL_SetTextureAlphaMod(texture, 0xFF);
+}
+
+int LBitmapFont::flush(bool batched)
+{
+	int draws = 0;
+	mLastGlyphCount = 0;
+
+	for (size_t page = 0; page < mPages.size(); ++page)
+	{
+		std::vector<QueuedQuad>& quads = mQueue[page];
+		if (quads.empty())
+		{
+			continue;
+		}
+		mLastGlyphCount += (int)quads.size();
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+		if (batched)
+		{
+			//Four corners per glyph, with the texture coordinates normalized to the page
+			float texel = 1.0f / mPageSize;
+			mVertices.resize(quads.size() * 4);
+			for (size_t i = 0; i < quads.size(); ++i)
+			{
+				const QueuedQuad& quad = quads[i];
+				float left = (float)quad.dst.x;
+				float top = (float)quad.dst.y;
+				float right = (float)(quad.dst.x + quad.dst.w);
+				float bottom = (float)(quad.dst.y + quad.dst.h);
+				float u0 = quad.clip.x * texel;
+				float v0 = quad.clip.y * texel;
+				float u1 = (quad.clip.x + quad.clip.w) * texel;
+				float v1 = (quad.clip.y + quad.clip.h) * texel;
+
+				SDL_Vertex* v = &mVertices[i * 4];
+				v[0].position.x = left;  v[0].position.y = top;    v[0].tex_coord.x = u0; v[0].tex_coord.y = v0;
+				v[1].position.x = right; v[1].position.y = top;    v[1].tex_coord.x = u1; v[1].tex_coord.y = v0;
+				v[2].position.x = left;  v[2].position.y = bottom; v[2].tex_coord.x = u0; v[2].tex_coord.y = v1;
+				v[3].position.x = right; v[3].position.y = bottom; v[3].tex_coord.x = u1; v[3].tex_coord.y = v1;
+				v[0].color = v[1].color = v[2].color = v[3].color = quad.color;
+			}
+
+			//Two triangles per glyph, the pattern is the same for every page so it's only extended
+			size_t builtQuads = mIndices.size() / 6;
+			if (builtQuads < quads.size())
+			{
+				mIndices.resize(quads.size() * 6);
+				for (size_t i = builtQuads; i < quads.size(); ++i)
+				{
+					int base = (int)i * 4;
+					int* index = &mIndices[i * 6];
+					index[0] = base;
+					index[1] = base + 1;
+					index[2] = base + 2;
+					index[3] = base + 1;
+					index[4] = base + 3;
+					index[5] = base + 2;
+				}
+			}
+
+			if (SDL_RenderGeometry(gRenderer, mPages[page], &mVertices[0], (int)quads.size() * 4, &mIndices[0], (int)quads.size() * 6) == 0)
+			{
+				++draws;
+				quads.clear();
+				continue;
+			}
+			printf("Warning: batched text failed, drawing glyph by glyph! SDL Error: %s\n", SDL_GetError());
+		}
+#endif
+
+		//No geometry API, or it was turned off: one copy per glyph
+		renderPageCopies((int)page);
+		draws += (int)quads.size();
+		quads.clear();
+	}
+
+	return draws;
+}
+
+int LBitmapFont::getLineHeight()
+{
+	return mLineHeight;
+}
+
+int LBitmapFont::getTextWidth(const char* text)
+{
+	int width = 0;
+	for (const char* p = text; *p != '\0' && *p != '\n'; ++p)
+	{
+		int c = (unsigned char)*p;
+		if (c < FONT_FIRST_CHAR || c >= FONT_FIRST_CHAR + FONT_GLYPH_COUNT)
+		{
+			c = '?';
+		}
+		width += mGlyphs[c - FONT_FIRST_CHAR].advance;
+	}
+	return width;
+}
+
+int LBitmapFont::getPageCount()
+{
+	return (int)mPages.size();
+}
+
+int LBitmapFont::getCachedRunCount()
+{
+	return (int)mRuns.size();
+}
+
+int LBitmapFont::getLastGlyphCount()
+{
+	return mLastGlyphCount;
+}
+
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL_Image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else {
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else {
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+void spawnLabel(DamageLabel& label)
+{
+	//Burst out of Foo' and drift up, big hits are red
+	label.x = (float)(240 + gFooTexture.getWidth() / 2 + rand() % 81 - 40);
+	label.y = (float)(190 + gFooTexture.getHeight() / 3 + rand() % 41 - 20);
+	label.velX = (rand() % 201 - 100) / 40.0f;
+	label.velY = -(rand() % 100) / 25.0f - 1.0f;
+	label.value = rand() % 1000;
+	label.step = rand() % 97 + 1;
+	label.life = 60 + rand() % 90;
+
+	SDL_Color hit = { 0xFF, 0xFF, 0x40, 0xFF };
+	SDL_Color crit = { 0xFF, 0x30, 0x30, 0xFF };
+	label.color = label.value > 900 ? crit : hit;
+}
+
+void updateLabels()
+{
+	for (size_t i = 0; i < gLabels.size(); ++i)
+	{
+		DamageLabel& label = gLabels[i];
+		if (--label.life <= 0)
+		{
+			spawnLabel(label);
+			continue;
+		}
+
+		//Values keep ticking so the text really is different every frame
+		label.x += label.velX;
+		label.y += label.velY;
+		label.velY += 0.05f;
+		label.value += label.step;
+		label.color.a = (Uint8)(label.life < 32 ? label.life * 8 : 0xFF);
+	}
+}
+
+int renderFrame(bool batched, int frameMicroseconds)
+{
+	//Clear screen
+	SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+	SDL_RenderClear(gRenderer);
+
+	//Render background texture to screen
+	gBackgroundTexture.render(0, 0);
+
+	//Render Foo' to the screen
+	gFooTexture.render(240, 190);
+
+	//Every damage number is laid out fresh, nothing new is created
+	for (size_t i = 0; i < gLabels.size(); ++i)
+	{
+		const DamageLabel& label = gLabels[i];
+		gLabelFont.queueNumber(label.value, (int)label.x, (int)label.y, label.color);
+	}
+	int draws = gLabelFont.flush(batched);
+	int labelGlyphs = gLabelFont.getLastGlyphCount();
+
+	//Stats overlay, the captions are cached runs and the values change every frame
+	SDL_Rect panel = { 4, 4, 200, gOverlayFont.getLineHeight() * 7 + 8 };
+	SDL_SetRenderDrawBlendMode(gRenderer, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0x00, 0xA0);
+	SDL_RenderFillRect(gRenderer, &panel);
+	SDL_SetRenderDrawBlendMode(gRenderer, SDL_BLENDMODE_NONE);
+
+	SDL_Color caption = { 0xC0, 0xC0, 0xC0, 0xFF };
+	SDL_Color value = { 0xFF, 0xFF, 0xFF, 0xFF };
+	int x = panel.x + 4;
+	int valueX = panel.x + 120;
+	int y = panel.y + 4;
+	int line = gOverlayFont.getLineHeight();
+
+	gOverlayFont.queueRun(gOverlayFont.getRun("Labels"), x, y, caption);
+	gOverlayFont.queueNumber((int)gLabels.size(), valueX, y, value);
+	y += line;
+	gOverlayFont.queueRun(gOverlayFont.getRun("Label glyphs"), x, y, caption);
+	gOverlayFont.queueNumber(labelGlyphs, valueX, y, value);
+	y += line;
+	gOverlayFont.queueRun(gOverlayFont.getRun("Label draws"), x, y, caption);
+	gOverlayFont.queueNumber(draws, valueX, y, value);
+	y += line;
+	gOverlayFont.queueRun(gOverlayFont.getRun("Frame us"), x, y, caption);
+	gOverlayFont.queueNumber(frameMicroseconds, valueX, y, value);
+	y += line;
+	gOverlayFont.queueRun(gOverlayFont.getRun("Font textures"), x, y, caption);
+	gOverlayFont.queueNumber(gFontTexturesCreated, valueX, y, value);
+	y += line;
+	gOverlayFont.queueRun(gOverlayFont.getRun("Cached runs"), x, y, caption);
+	gOverlayFont.queueNumber(gOverlayFont.getCachedRunCount(), valueX, y, value);
+	y += line;
+	gOverlayFont.queueRun(gOverlayFont.getRun(batched ? "Batched per page" : "Copy per glyph"), x, y, caption);
+	draws += gOverlayFont.flush(batched);
+
+	//Update screen
+	SDL_RenderPresent(gRenderer);
+
+	return draws;
+}
+
+void runBenchmark()
+{
+	//Same labels and same random sequence for both modes
+	gLabels.resize(MAX_LABELS / 8);
+	for (int mode = 0; mode < 2; ++mode)
+	{
+		bool batched = mode == 0;
+		srand(1);
+		for (size_t i = 0; i < gLabels.size(); ++i)
+		{
+			spawnLabel(gLabels[i]);
+		}
+
+		int draws = 0;
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+		{
+			updateLabels();
+			draws += renderFrame(batched, 0);
+		}
+
+		//Wait for the GPU before stopping the clock
+		Uint32 pixel = 0;
+		SDL_Rect pixelRect = { 0, 0, 1, 1 };
+		SDL_RenderReadPixels(gRenderer, &pixelRect, SDL_PIXELFORMAT_ARGB8888, &pixel, sizeof(pixel));
+
+		double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+		printf("%-16s %d labels: %.3f ms/frame, %d draws/frame\n", batched ? "batched" : "copy per glyph", (int)gLabels.size(), ms / BENCHMARK_FRAMES, draws / BENCHMARK_FRAMES);
+	}
+	printf("Font textures created: %d\n", gFontTexturesCreated);
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window, no vsync so the frame time shows the text cost
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' texture
+	if (!gFooTexture.loadFromFile("Images/foo.png"))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Load background texture
+	if (!gBackgroundTexture.loadFromFile("Images/background.png"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	//Rasterize the fonts, the large one spills onto a second page
+	if (!gOverlayFont.create(1, 128))
+	{
+		printf("Failed to create overlay font!\n");
+		success = false;
+	}
+	if (!gLabelFont.create(2, 128))
+	{
+		printf("Failed to create label font!\n");
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images and fonts
+	gFooTexture.free();
+	gBackgroundTexture.free();
+	gOverlayFont.free();
+	gLabelFont.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else if (argc >= 2 && strcmp(args[1], "benchmark") == 0)
+		{
+			//Times batched against per glyph drawing and exits
+			runBenchmark();
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Up/down doubles/halves the damage numbers, space toggles batching
+			bool batched = true;
+			gLabels.resize(DEFAULT_LABELS);
+			for (size_t i = 0; i < gLabels.size(); ++i)
+			{
+				spawnLabel(gLabels[i]);
+			}
+
+			//Last frame's time for the overlay
+			int frameMicroseconds = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				Uint64 frameStart = SDL_GetPerformanceCounter();
+
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_KEYDOWN)
+					{
+						size_t count = gLabels.size();
+						switch (e.key.keysym.sym)
+						{
+							case SDLK_UP:
+							count = count * 2 > (size_t)MAX_LABELS ? (size_t)MAX_LABELS : (count == 0 ? 1 : count * 2);
+							break;
+
+							case SDLK_DOWN:
+							count /= 2;
+							break;
+
+							case SDLK_SPACE:
+							batched = !batched;
+							break;
+						}
+
+						//New labels start fresh, removed ones just go
+						size_t oldCount = gLabels.size();
+						gLabels.resize(count);
+						for (size_t i = oldCount; i < count; ++i)
+						{
+							spawnLabel(gLabels[i]);
+						}
+					}
+				}
+
+				//Move the damage numbers and draw everything
+				updateLabels();
+				renderFrame(batched, frameMicroseconds);
+
+				frameMicroseconds = (int)((SDL_GetPerformanceCounter() - frameStart) * 1000000 / SDL_GetPerformanceFrequency());
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,854 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, random numbers, strings, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Actor limits
+const int DEFAULT_ACTORS = 100;
+const int MAX_ACTORS = 20000;
+
+//Longest metadata line the sheet parser accepts
+const int SHEET_LINE_LENGTH = 512;
+
+//A named run of frames on a sprite sheet
+struct Animation
+{
+	//Name from the metadata
+	std::string name;
+
+	//First entry in the sheet's frame sequence and how many follow
+	int firstFrame;
+	int frameCount;
+
+	//Time each frame is shown
+	Uint32 frameTime;
+
+	//Loops forever or holds the last frame
+	bool loop;
+};
+
+//A moving sprite
+struct Actor
+{
+	float x;
+	float y;
+	float velX;
+};
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point, only the clip of it if there is one
+		void render(int x, int y, const SDL_Rect* clip = NULL);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//All of a character's frames in one texture, with frame rects and animations read from metadata
+class LSpriteSheet
+{
+	public:
+		//Loads the metadata at path and the image it names
+		bool loadFromFile(std::string path);
+
+		//Deallocates the texture and metadata
+		void free();
+
+		//Gets an animation's index by name, -1 if the sheet doesn't have it
+		int findAnimation(const char* name);
+
+		//Gets an animation by index
+		const Animation& getAnimation(int index);
+
+		//Gets the frame a sequence entry refers to
+		int getSequenceFrame(int index);
+
+		//Gets a frame's rect on the sheet
+		const SDL_Rect& getFrame(int index);
+
+		//Renders one frame at the given point
+		void render(int x, int y, int frame);
+
+	private:
+		//Gets a frame's index by name, -1 if the sheet doesn't have it
+		int findFrame(const char* name);
+
+		//The sheet texture
+		LTexture mTexture;
+
+		//Frame rects and their names
+		std::vector<SDL_Rect> mFrames;
+		std::vector<std::string> mFrameNames;
+
+		//Frames of every animation back to back, animations index into it
+		std::vector<int> mSequence;
+
+		//Animations on this sheet
+		std::vector<Animation> mAnimations;
+};
+
+//Plays animations for many sprites at once, state lives in parallel arrays advanced in one pass
+class AnimationSystem
+{
+	public:
+		//Initializes variables
+		AnimationSystem();
+
+		//Sets the sheet the animations come from, clears all instances
+		void setSheet(LSpriteSheet* sheet);
+
+		//Adds an instance already startTime into its animation, returns its index
+		int add(int animation, Uint32 startTime);
+
+		//Removes instances from the end until count are left
+		void truncate(int count);
+
+		//Restarts an instance on an animation
+		void play(int instance, int animation, Uint32 startTime = 0);
+
+		//Advances every instance by ms
+		void update(Uint32 ms);
+
+		//Gets the sheet frame an instance shows
+		int getFrame(int instance);
+
+		//Gets the animation an instance plays
+		int getAnimation(int instance);
+
+		//Checks whether a non looping animation has shown its last frame for its full time
+		bool isFinished(int instance);
+
+		//Gets the number of instances
+		int getCount();
+
+	private:
+		//Advances one instance by ms and resolves its sheet frame
+		void advance(int instance, Uint32 ms);
+
+		//Sheet the animations belong to
+		LSpriteSheet* mSheet;
+
+		//Per instance animation, time into it, and resolved sheet frame
+		std::vector<int> mAnimations;
+		std::vector<Uint32> mElapsed;
+		std::vector<int> mFrames;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Adds or removes actors, new ones get the given animation
+void setActorCount(int count, int animation);
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene textures
+LTexture gBackgroundTexture;
+LSpriteSheet gFooSheet;
+
+//Actors and their animations, same index in both
+std::vector<Actor> gActors;
+AnimationSystem gAnimations;
+
+//Animation indices on the Foo' sheet
+int gIdleAnimation = -1;
+int gWalkAnimation = -1;
+int gHopAnimation = -1;
+int gLandAnimation = -1;
+
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL_Image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else {
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else {
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y, const SDL_Rect* clip) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+
+	//Set clip rendering dimensions
+	if (clip != NULL)
+	{
+		renderQuad.w = clip->w;
+		renderQuad.h = clip->h;
+	}
+
+	SDL_RenderCopy(gRenderer, mTexture, clip, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+bool LSpriteSheet::loadFromFile(std::string path)
+{
+	//Get rid of preexisting sheet
+	free();
+
+	FILE* file = fopen(path.c_str(), "r");
+	if (file == NULL)
+	{
+		printf("Unable to open sprite sheet %s!\n", path.c_str());
+		return false;
+	}
+
+	//The image is named relative to the metadata
+	std::string folder;
+	size_t slash = path.find_last_of("/\\");
+	if (slash != std::string::npos)
+	{
+		folder = path.substr(0, slash + 1);
+	}
+
+	//One directive per line, # starts a comment
+	bool success = true;
+	std::string image;
+	char line[SHEET_LINE_LENGTH];
+	int lineNumber = 0;
+	while (success && fgets(line, sizeof(line), file) != NULL)
+	{
+		++lineNumber;
+		char* token = strtok(line, " \t\r\n");
+		if (token == NULL || token[0] == '#')
+		{
+			continue;
+		}
+
+		if (strcmp(token, "image") == 0)
+		{
+			char* name = strtok(NULL, " \t\r\n");
+			if (name == NULL)
+			{
+				success = false;
+			}
+			else
+			{
+				image = name;
+			}
+		}
+		else if (strcmp(token, "frame") == 0)
+		{
+			//frame <name> <x> <y> <w> <h>
+			char* name = strtok(NULL, " \t\r\n");
+			char* numbers = strtok(NULL, "\r\n");
+			SDL_Rect frame;
+			if (name == NULL || numbers == NULL || sscanf(numbers, "%d %d %d %d", &frame.x, &frame.y, &frame.w, &frame.h) != 4 || findFrame(name) >= 0)
+			{
+				success = false;
+			}
+			else
+			{
+				mFrames.push_back(frame);
+				mFrameNames.push_back(name);
+			}
+		}
+		else if (strcmp(token, "animation") == 0)
+		{
+			//animation <name> <ms per frame> <loop|once> <frame names...>
+			char* name = strtok(NULL, " \t\r\n");
+			char* time = strtok(NULL, " \t\r\n");
+			char* mode = strtok(NULL, " \t\r\n");
+			if (name == NULL || time == NULL || mode == NULL || atoi(time) <= 0 || findAnimation(name) >= 0)
+			{
+				success = false;
+			}
+			else if (strcmp(mode, "loop") != 0 && strcmp(mode, "once") != 0)
+			{
+				printf("Animation %s in %s has mode \"%s\", expected loop or once!\n", name, path.c_str(), mode);
+				success = false;
+			}
+			else
+			{
+				Animation animation;
+				animation.name = name;
+				animation.firstFrame = (int)mSequence.size();
+				animation.frameCount = 0;
+				animation.frameTime = (Uint32)atoi(time);
+				animation.loop = strcmp(mode, "loop") == 0;
+
+				for (char* frame = strtok(NULL, " \t\r\n"); frame != NULL && success; frame = strtok(NULL, " \t\r\n"))
+				{
+					int index = findFrame(frame);
+					if (index < 0)
+					{
+						success = false;
+					}
+					mSequence.push_back(index);
+					++animation.frameCount;
+				}
+
+				if (animation.frameCount == 0)
+				{
+					success = false;
+				}
+				mAnimations.push_back(animation);
+			}
+		}
+		else
+		{
+			success = false;
+		}
+
+		if (!success)
+		{
+			printf("Bad sprite sheet line %d in %s!\n", lineNumber, path.c_str());
+		}
+	}
+	fclose(file);
+
+	//Every frame of the character comes out of this one texture
+	if (success)
+	{
+		if (image.empty() || mFrames.empty())
+		{
+			printf("Sprite sheet %s has no image or frames!\n", path.c_str());
+			success = false;
+		}
+		else if (!mTexture.loadFromFile(folder + image))
+		{
+			success = false;
+		}
+	}
+
+	//Frames have to lie on the sheet
+	for (size_t i = 0; i < mFrames.size() && success; ++i)
+	{
+		const SDL_Rect& frame = mFrames[i];
+		if (frame.x < 0 || frame.y < 0 || frame.w <= 0 || frame.h <= 0 || frame.x + frame.w > mTexture.getWidth() || frame.y + frame.h > mTexture.getHeight())
+		{
+			printf("Frame %s is outside %s!\n", mFrameNames[i].c_str(), image.c_str());
+			success = false;
+		}
+	}
+
+	if (!success)
+	{
+		free();
+	}
+	return success;
+}
+
+void LSpriteSheet::free()
+{
+	mTexture.free();
+	mFrames.clear();
+	mFrameNames.clear();
+	mSequence.clear();
+	mAnimations.clear();
+}
+
+int LSpriteSheet::findFrame(const char* name)
+{
+	for (size_t i = 0; i < mFrameNames.size(); ++i)
+	{
+		if (mFrameNames[i] == name)
+		{
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+int LSpriteSheet::findAnimation(const char* name)
+{
+	for (size_t i = 0; i < mAnimations.size(); ++i)
+	{
+		if (mAnimations[i].name == name)
+		{
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+const Animation& LSpriteSheet::getAnimation(int index)
+{
+	return mAnimations[index];
+}
+
+int LSpriteSheet::getSequenceFrame(int index)
+{
+	return mSequence[index];
+}
+
+const SDL_Rect& LSpriteSheet::getFrame(int index)
+{
+	return mFrames[index];
+}
+
+void LSpriteSheet::render(int x, int y, int frame)
+{
+	mTexture.render(x, y, &mFrames[frame]);
+}
+
+AnimationSystem::AnimationSystem()
+{
+	//Initialize
+	mSheet = NULL;
+}
+
+void AnimationSystem::setSheet(LSpriteSheet* sheet)
+{
+	mSheet = sheet;
+	truncate(0);
+}
+
+int AnimationSystem::add(int animation, Uint32 startTime)
+{
+	mAnimations.push_back(animation);
+	mElapsed.push_back(0);
+	mFrames.push_back(0);
+
+	int instance = (int)mAnimations.size() - 1;
+	play(instance, animation, startTime);
+	return instance;
+}
+
+void AnimationSystem::truncate(int count)
+{
+	if (count < (int)mAnimations.size())
+	{
+		mAnimations.resize(count);
+		mElapsed.resize(count);
+		mFrames.resize(count);
+	}
+}
+
+void AnimationSystem::play(int instance, int animation, Uint32 startTime)
+{
+	mAnimations[instance] = animation;
+	mElapsed[instance] = startTime;
+
+	//Resolve the first frame now so the instance never shows a stale one
+	advance(instance, 0);
+}
+
+void AnimationSystem::update(Uint32 ms)
+{
+	//One pass over every instance, no per sprite objects to chase
+	int count = (int)mAnimations.size();
+	for (int i = 0; i < count; ++i)
+	{
+		advance(i, ms);
+	}
+}
+
+void AnimationSystem::advance(int instance, Uint32 ms)
+{
+	const Animation& animation = mSheet->getAnimation(mAnimations[instance]);
+	Uint32 length = animation.frameTime * animation.frameCount;
+
+	//Loops wrap, one shots stop at their end
+	Uint32 elapsed = mElapsed[instance] + ms;
+	if (elapsed >= length)
+	{
+		elapsed = animation.loop ? elapsed % length : length;
+	}
+	mElapsed[instance] = elapsed;
+
+	int step = (int)(elapsed / animation.frameTime);
+	if (step >= animation.frameCount)
+	{
+		step = animation.frameCount - 1;
+	}
+	mFrames[instance] = mSheet->getSequenceFrame(animation.firstFrame + step);
+}
+
+int AnimationSystem::getFrame(int instance)
+{
+	return mFrames[instance];
+}
+
+int AnimationSystem::getAnimation(int instance)
+{
+	return mAnimations[instance];
+}
+
+bool AnimationSystem::isFinished(int instance)
+{
+	const Animation& animation = mSheet->getAnimation(mAnimations[instance]);
+	return !animation.loop && mElapsed[instance] >= animation.frameTime * animation.frameCount;
+}
+
+int AnimationSystem::getCount()
+{
+	return (int)mAnimations.size();
+}
+
+void setActorCount(int count, int animation)
+{
+	int oldCount = (int)gActors.size();
+	gActors.resize(count);
+	gAnimations.truncate(count);
+
+	//Newcomers are scattered across the ground, each a different way into its animation
+	for (int i = oldCount; i < count; ++i)
+	{
+		Actor& actor = gActors[i];
+		actor.x = (float)(rand() % SCREEN_WIDTH);
+		actor.y = (float)(SCREEN_HEIGHT - 128 - rand() % (SCREEN_HEIGHT / 2));
+		actor.velX = (rand() % 2 == 0 ? -1.0f : 1.0f) * (0.5f + (rand() % 100) / 50.0f);
+		gAnimations.add(animation, (Uint32)(rand() % 1000));
+	}
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' sprite sheet
+	if (!gFooSheet.loadFromFile("Images/foo_sheet.txt"))
+	{
+		printf("Failed to load Foo' sprite sheet!\n");
+		success = false;
+	}
+	else
+	{
+		//The demo needs these animations
+		gIdleAnimation = gFooSheet.findAnimation("idle");
+		gWalkAnimation = gFooSheet.findAnimation("walk");
+		gHopAnimation = gFooSheet.findAnimation("hop");
+		gLandAnimation = gFooSheet.findAnimation("land");
+		if (gIdleAnimation < 0 || gWalkAnimation < 0 || gHopAnimation < 0 || gLandAnimation < 0)
+		{
+			printf("Foo' sprite sheet is missing an animation!\n");
+			success = false;
+		}
+		gAnimations.setSheet(&gFooSheet);
+	}
+
+	//Load background texture
+	if (!gBackgroundTexture.loadFromFile("Images/background.png"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images
+	gFooSheet.free();
+	gBackgroundTexture.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//1-3 switch everyone to idle/walk/hop, L lands them, up/down doubles/halves the crowd
+			int animation = gWalkAnimation;
+			setActorCount(DEFAULT_ACTORS, animation);
+
+			//Time of the last frame, and the update cost for the title
+			Uint32 lastTicks = SDL_GetTicks();
+			Uint32 titleTicks = lastTicks;
+			Uint64 updateCounter = 0;
+			int updateFrames = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_KEYDOWN)
+					{
+						int newAnimation = -1;
+						switch (e.key.keysym.sym)
+						{
+							case SDLK_1: newAnimation = gIdleAnimation; break;
+							case SDLK_2: newAnimation = gWalkAnimation; break;
+							case SDLK_3: newAnimation = gHopAnimation; break;
+							case SDLK_l: newAnimation = gLandAnimation; break;
+
+							case SDLK_UP:
+							setActorCount(gActors.size() * 2 > (size_t)MAX_ACTORS ? MAX_ACTORS : (gActors.empty() ? 1 : (int)gActors.size() * 2), animation);
+							break;
+
+							case SDLK_DOWN:
+							setActorCount((int)gActors.size() / 2, animation);
+							break;
+						}
+
+						//Restart everyone a little out of step so the crowd doesn't move in lockstep
+						if (newAnimation >= 0)
+						{
+							if (newAnimation != gLandAnimation)
+							{
+								animation = newAnimation;
+							}
+							for (int i = 0; i < gAnimations.getCount(); ++i)
+							{
+								gAnimations.play(i, newAnimation, newAnimation == gLandAnimation ? 0 : (Uint32)(rand() % 1000));
+							}
+						}
+					}
+				}
+
+				//Elapsed time, capped so a stall doesn't fling everyone across the screen
+				Uint32 ticks = SDL_GetTicks();
+				Uint32 delta = ticks - lastTicks;
+				lastTicks = ticks;
+				if (delta > 100)
+				{
+					delta = 100;
+				}
+
+				//Every animation advances in one pass
+				Uint64 updateStart = SDL_GetPerformanceCounter();
+				gAnimations.update(delta);
+				updateCounter += SDL_GetPerformanceCounter() - updateStart;
+				++updateFrames;
+
+				//Landed actors go back to what they were doing, walkers move
+				for (int i = 0; i < (int)gActors.size(); ++i)
+				{
+					if (gAnimations.getAnimation(i) == gLandAnimation && gAnimations.isFinished(i))
+					{
+						gAnimations.play(i, animation, (Uint32)(rand() % 1000));
+					}
+
+					Actor& actor = gActors[i];
+					if (gAnimations.getAnimation(i) == gWalkAnimation)
+					{
+						actor.x += actor.velX * delta / 16.0f;
+						if (actor.x < -64.0f)
+						{
+							actor.x += SCREEN_WIDTH + 64.0f;
+						}
+						else if (actor.x > SCREEN_WIDTH)
+						{
+							actor.x -= SCREEN_WIDTH + 64.0f;
+						}
+					}
+				}
+
+				//Show the crowd size and the cost of the update pass once a second
+				if (ticks - titleTicks >= 1000)
+				{
+					char title[128];
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - %d sprites, animation update %.1f us", gAnimations.getCount(), (double)updateCounter * 1000000.0 / SDL_GetPerformanceFrequency() / updateFrames);
+					SDL_SetWindowTitle(gWindow, title);
+					titleTicks = ticks;
+					updateCounter = 0;
+					updateFrames = 0;
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render background texture to screen
+				gBackgroundTexture.render(0, 0);
+
+				//Every actor is a clip of the same sheet texture
+				for (int i = 0; i < (int)gActors.size(); ++i)
+				{
+					gFooSheet.render((int)gActors[i].x, (int)gActors[i].y, gAnimations.getFrame(i));
+				}
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,850 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Tile and chunk sizes, a chunk is CHUNK_TILES x CHUNK_TILES tiles
+const int TILE_SIZE = 32;
+const int CHUNK_TILES = 8;
+const int CHUNK_PIXELS = TILE_SIZE * CHUNK_TILES;
+
+//Map size in tiles
+const int MAP_WIDTH = 256;
+const int MAP_HEIGHT = 256;
+
+//Chunk textures kept alive at once, has to cover a screen's worth of chunks
+const int MAX_RESIDENT_CHUNKS = 48;
+
+//Frames timed per mode by the benchmark
+const int BENCHMARK_FRAMES = 300;
+
+//Tiles in Images/tiles.png, left to right
+enum Tile
+{
+	TILE_GRASS,
+	TILE_FLOWERS,
+	TILE_DIRT,
+	TILE_WATER,
+	TILE_STONE,
+	TILE_SAND,
+	TILE_BRICK,
+	TILE_TREE,
+	TILE_TOTAL
+};
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point, only the clip of it if there is one
+		void render(int x, int y, const SDL_Rect* clip = NULL);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Tile map split into chunks, each chunk is drawn once into a target texture and blitted from there
+class LTileMap
+{
+	public:
+		//Initializes variables
+		LTileMap();
+
+		//Deallocates memory
+		~LTileMap();
+
+		//Makes an empty map of width x height tiles drawn from tileset
+		bool create(int width, int height, LTexture* tileset);
+
+		//Deallocates chunk textures and tiles
+		void free();
+
+		//Gets/sets a tile, setting one marks its chunk for redrawing
+		int getTile(int x, int y);
+		void setTile(int x, int y, int tile);
+
+		//Draws the part of the map the camera sees, chunk by chunk or tile by tile
+		void render(const SDL_Rect& camera, bool chunked);
+
+		//Marks every chunk for redrawing, for when the renderer threw away target contents
+		void invalidateChunks();
+
+		//Destroys every chunk texture, for when the renderer lost its textures
+		void releaseChunks();
+
+		//Gets stats about the last render
+		int getDrawCount();
+		int getChunkRedraws();
+		int getResidentChunks();
+
+	private:
+		//A block of CHUNK_TILES x CHUNK_TILES tiles
+		struct Chunk
+		{
+			//Cached tiles, NULL when not resident
+			SDL_Texture* texture;
+
+			//Texture is out of date with the tiles
+			bool dirty;
+
+			//Last frame the chunk was drawn
+			Uint32 lastUsedFrame;
+		};
+
+		//Makes sure a chunk has an up to date texture, false if it has to be drawn tile by tile
+		bool prepareChunk(Chunk& chunk, int chunkX, int chunkY);
+
+		//Draws a block of tiles with the top left tile at x, y on the current render target
+		void renderTiles(int firstX, int firstY, int lastX, int lastY, int x, int y);
+
+		//Tileset and how many tiles it has per row
+		LTexture* mTileset;
+		int mTilesetColumns;
+
+		//Tiles, row by row
+		std::vector<Uint8> mTiles;
+		int mWidth;
+		int mHeight;
+
+		//Chunks, row by row
+		std::vector<Chunk> mChunks;
+		int mChunksX;
+		int mChunksY;
+
+		//Whether the renderer can draw into textures at all
+		bool mTargetsSupported;
+
+		//Frame counter for picking chunks to evict, and stats
+		Uint32 mFrame;
+		int mResidentChunks;
+		int mDrawCount;
+		int mChunkRedraws;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Fills the map with terrain
+void generateMap();
+
+//Times chunked against per tile drawing while panning across the map
+void runBenchmark();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Tileset texture
+LTexture gTilesTexture;
+
+//The map
+LTileMap gTileMap;
+
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL_Image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else {
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else {
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y, const SDL_Rect* clip) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+
+	//Set clip rendering dimensions
+	if (clip != NULL)
+	{
+		renderQuad.w = clip->w;
+		renderQuad.h = clip->h;
+	}
+
+	SDL_RenderCopy(gRenderer, mTexture, clip, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+LTileMap::LTileMap()
+{
+	//Initialize
+	mTileset = NULL;
+	mTilesetColumns = 0;
+	mWidth = 0;
+	mHeight = 0;
+	mChunksX = 0;
+	mChunksY = 0;
+	mTargetsSupported = false;
+	mFrame = 0;
+	mResidentChunks = 0;
+	mDrawCount = 0;
+	mChunkRedraws = 0;
+}
+
+LTileMap::~LTileMap()
+{
+	//Deallocate
+	free();
+}
+
+bool LTileMap::create(int width, int height, LTexture* tileset)
+{
+	//Get rid of preexisting map
+	free();
+
+	mTilesetColumns = tileset->getWidth() / TILE_SIZE;
+	if (mTilesetColumns <= 0)
+	{
+		printf("Tileset is narrower than a tile!\n");
+		return false;
+	}
+
+	mTileset = tileset;
+	mWidth = width;
+	mHeight = height;
+	mTiles.assign(width * height, 0);
+
+	//Partial chunks at the right and bottom edges still get a full size texture
+	mChunksX = (width + CHUNK_TILES - 1) / CHUNK_TILES;
+	mChunksY = (height + CHUNK_TILES - 1) / CHUNK_TILES;
+	Chunk empty = { NULL, true, 0 };
+	mChunks.assign(mChunksX * mChunksY, empty);
+
+	//Without render targets every frame is drawn tile by tile
+	mTargetsSupported = SDL_RenderTargetSupported(gRenderer) == SDL_TRUE;
+	if (!mTargetsSupported)
+	{
+		printf("Warning: renderer has no render targets, tiles will be drawn one by one!\n");
+	}
+
+	return true;
+}
+
+void LTileMap::free()
+{
+	releaseChunks();
+	mChunks.clear();
+	mTiles.clear();
+	mTileset = NULL;
+	mWidth = 0;
+	mHeight = 0;
+	mChunksX = 0;
+	mChunksY = 0;
+}
+
+int LTileMap::getTile(int x, int y)
+{
+	if (x < 0 || y < 0 || x >= mWidth || y >= mHeight)
+	{
+		return -1;
+	}
+	return mTiles[y * mWidth + x];
+}
+
+void LTileMap::setTile(int x, int y, int tile)
+{
+	if (x < 0 || y < 0 || x >= mWidth || y >= mHeight || mTiles[y * mWidth + x] == tile)
+	{
+		return;
+	}
+
+	//Only the chunk holding the tile has to be redrawn
+	mTiles[y * mWidth + x] = (Uint8)tile;
+	mChunks[(y / CHUNK_TILES) * mChunksX + x / CHUNK_TILES].dirty = true;
+}
+
+void LTileMap::invalidateChunks()
+{
+	for (size_t i = 0; i < mChunks.size(); ++i)
+	{
+		mChunks[i].dirty = true;
+	}
+}
+
+void LTileMap::releaseChunks()
+{
+	for (size_t i = 0; i < mChunks.size(); ++i)
+	{
+		if (mChunks[i].texture != NULL)
+		{
+			SDL_DestroyTexture(mChunks[i].texture);
+			mChunks[i].texture = NULL;
+		}
+		mChunks[i].dirty = true;
+	}
+	mResidentChunks = 0;
+}
+
+void LTileMap::renderTiles(int firstX, int firstY, int lastX, int lastY, int x, int y)
+{
+	SDL_Rect clip = { 0, 0, TILE_SIZE, TILE_SIZE };
+	for (int tileY = firstY; tileY <= lastY; ++tileY)
+	{
+		for (int tileX = firstX; tileX <= lastX; ++tileX)
+		{
+			int tile = mTiles[tileY * mWidth + tileX];
+			clip.x = (tile % mTilesetColumns) * TILE_SIZE;
+			clip.y = (tile / mTilesetColumns) * TILE_SIZE;
+			mTileset->render(x + (tileX - firstX) * TILE_SIZE, y + (tileY - firstY) * TILE_SIZE, &clip);
+			++mDrawCount;
+		}
+	}
+}
+
+bool LTileMap::prepareChunk(Chunk& chunk, int chunkX, int chunkY)
+{
+	chunk.lastUsedFrame = mFrame;
+
+	if (chunk.texture == NULL)
+	{
+		//Take the texture of the chunk that's gone longest without being drawn, unless it's on screen
+		if (mResidentChunks >= MAX_RESIDENT_CHUNKS)
+		{
+			Chunk* victim = NULL;
+			for (size_t i = 0; i < mChunks.size(); ++i)
+			{
+				Chunk& other = mChunks[i];
+				if (other.texture != NULL && other.lastUsedFrame != mFrame && (victim == NULL || other.lastUsedFrame < victim->lastUsedFrame))
+				{
+					victim = &other;
+				}
+			}
+
+			if (victim == NULL)
+			{
+				return false;
+			}
+			chunk.texture = victim->texture;
+			victim->texture = NULL;
+			victim->dirty = true;
+		}
+		else
+		{
+			chunk.texture = SDL_CreateTexture(gRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, CHUNK_PIXELS, CHUNK_PIXELS);
+			if (chunk.texture == NULL)
+			{
+				printf("Unable to create chunk texture! SDL Error: %s\n", SDL_GetError());
+				return false;
+			}
+
+			//Tiles are opaque, skipping the blend makes the blit cheaper
+			SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_NONE);
+			++mResidentChunks;
+		}
+		chunk.dirty = true;
+	}
+
+	//Redraw the chunk's tiles into its texture only when one of them changed
+	if (chunk.dirty)
+	{
+		int firstX = chunkX * CHUNK_TILES;
+		int firstY = chunkY * CHUNK_TILES;
+		int lastX = SDL_min(firstX + CHUNK_TILES, mWidth) - 1;
+		int lastY = SDL_min(firstY + CHUNK_TILES, mHeight) - 1;
+
+		SDL_SetRenderTarget(gRenderer, chunk.texture);
+		SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0x00, 0xFF);
+		SDL_RenderClear(gRenderer);
+		renderTiles(firstX, firstY, lastX, lastY, 0, 0);
+		SDL_SetRenderTarget(gRenderer, NULL);
+
+		chunk.dirty = false;
+		++mChunkRedraws;
+	}
+
+	return true;
+}
+
+void LTileMap::render(const SDL_Rect& camera, bool chunked)
+{
+	++mFrame;
+	mDrawCount = 0;
+	mChunkRedraws = 0;
+
+	if (!chunked || !mTargetsSupported)
+	{
+		//Immediate mode, one copy per visible tile
+		int firstX = SDL_max(camera.x / TILE_SIZE, 0);
+		int firstY = SDL_max(camera.y / TILE_SIZE, 0);
+		int lastX = SDL_min((camera.x + camera.w - 1) / TILE_SIZE, mWidth - 1);
+		int lastY = SDL_min((camera.y + camera.h - 1) / TILE_SIZE, mHeight - 1);
+		if (firstX <= lastX && firstY <= lastY)
+		{
+			renderTiles(firstX, firstY, lastX, lastY, firstX * TILE_SIZE - camera.x, firstY * TILE_SIZE - camera.y);
+		}
+		return;
+	}
+
+	//Chunked, one copy per visible chunk plus whatever had to be redrawn
+	int firstX = SDL_max(camera.x / CHUNK_PIXELS, 0);
+	int firstY = SDL_max(camera.y / CHUNK_PIXELS, 0);
+	int lastX = SDL_min((camera.x + camera.w - 1) / CHUNK_PIXELS, mChunksX - 1);
+	int lastY = SDL_min((camera.y + camera.h - 1) / CHUNK_PIXELS, mChunksY - 1);
+	for (int chunkY = firstY; chunkY <= lastY; ++chunkY)
+	{
+		for (int chunkX = firstX; chunkX <= lastX; ++chunkX)
+		{
+			Chunk& chunk = mChunks[chunkY * mChunksX + chunkX];
+			int x = chunkX * CHUNK_PIXELS - camera.x;
+			int y = chunkY * CHUNK_PIXELS - camera.y;
+
+			if (prepareChunk(chunk, chunkX, chunkY))
+			{
+				SDL_Rect renderQuad = { x, y, CHUNK_PIXELS, CHUNK_PIXELS };
+				SDL_RenderCopy(gRenderer, chunk.texture, NULL, &renderQuad);
+				++mDrawCount;
+			}
+			else
+			{
+				//No texture to spare, draw this one the slow way
+				int firstTileX = chunkX * CHUNK_TILES;
+				int firstTileY = chunkY * CHUNK_TILES;
+				renderTiles(firstTileX, firstTileY, SDL_min(firstTileX + CHUNK_TILES, mWidth) - 1, SDL_min(firstTileY + CHUNK_TILES, mHeight) - 1, x, y);
+			}
+		}
+	}
+}
+
+int LTileMap::getDrawCount()
+{
+	return mDrawCount;
+}
+
+int LTileMap::getChunkRedraws()
+{
+	return mChunkRedraws;
+}
+
+int LTileMap::getResidentChunks()
+{
+	return mResidentChunks;
+}
+
+//Smooth pseudo random value in 0..255 for a point, from hashed lattice corners
+static int terrainNoise(int x, int y, int scale)
+{
+	int cellX = x / scale;
+	int cellY = y / scale;
+	int fracX = (x % scale) * 256 / scale;
+	int fracY = (y % scale) * 256 / scale;
+
+	int corners[4];
+	for (int i = 0; i < 4; ++i)
+	{
+		Uint32 h = (Uint32)(cellX + (i & 1)) * 374761393u + (Uint32)(cellY + (i >> 1)) * 668265263u;
+		h = (h ^ (h >> 13)) * 1274126177u;
+		corners[i] = (int)((h ^ (h >> 16)) & 0xFF);
+	}
+
+	int top = corners[0] + (corners[1] - corners[0]) * fracX / 256;
+	int bottom = corners[2] + (corners[3] - corners[2]) * fracX / 256;
+	return top + (bottom - top) * fracY / 256;
+}
+
+void generateMap()
+{
+	//Water in the low spots, sand around it, grass with trees and flowers up high, and a walled yard
+	for (int y = 0; y < MAP_HEIGHT; ++y)
+	{
+		for (int x = 0; x < MAP_WIDTH; ++x)
+		{
+			int height = (terrainNoise(x, y, 24) * 3 + terrainNoise(x, y, 6)) / 4;
+			int detail = terrainNoise(x + 1000, y, 3);
+
+			int tile = TILE_GRASS;
+			if (height < 80)
+			{
+				tile = TILE_WATER;
+			}
+			else if (height < 92)
+			{
+				tile = TILE_SAND;
+			}
+			else if (height > 170)
+			{
+				tile = TILE_STONE;
+			}
+			else if (detail > 200)
+			{
+				tile = TILE_TREE;
+			}
+			else if (detail < 40)
+			{
+				tile = TILE_FLOWERS;
+			}
+			else if (detail > 150 && detail < 160)
+			{
+				tile = TILE_DIRT;
+			}
+			gTileMap.setTile(x, y, tile);
+		}
+	}
+
+	for (int i = 8; i < 24; ++i)
+	{
+		gTileMap.setTile(i, 8, TILE_BRICK);
+		gTileMap.setTile(i, 23, TILE_BRICK);
+		gTileMap.setTile(8, i, TILE_BRICK);
+		gTileMap.setTile(23, i, TILE_BRICK);
+	}
+}
+
+void runBenchmark()
+{
+	for (int mode = 0; mode < 2; ++mode)
+	{
+		bool chunked = mode == 0;
+		int draws = 0;
+		int redraws = 0;
+
+		//Pan diagonally, painting a tile now and then so chunks do get redrawn
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+		{
+			SDL_Rect camera = { frame * 4, frame * 3, SCREEN_WIDTH, SCREEN_HEIGHT };
+			if (frame % 10 == 0)
+			{
+				gTileMap.setTile((camera.x + SCREEN_WIDTH / 2) / TILE_SIZE, (camera.y + SCREEN_HEIGHT / 2) / TILE_SIZE, TILE_BRICK);
+			}
+
+			SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0x00, 0xFF);
+			SDL_RenderClear(gRenderer);
+			gTileMap.render(camera, chunked);
+			SDL_RenderPresent(gRenderer);
+
+			draws += gTileMap.getDrawCount();
+			redraws += gTileMap.getChunkRedraws();
+		}
+
+		//Wait for the GPU before stopping the clock
+		Uint32 pixel = 0;
+		SDL_Rect pixelRect = { 0, 0, 1, 1 };
+		SDL_RenderReadPixels(gRenderer, &pixelRect, SDL_PIXELFORMAT_ARGB8888, &pixel, sizeof(pixel));
+
+		double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+		printf("%-8s %.3f ms/frame, %d draws/frame, %d chunk redraws\n", chunked ? "chunked" : "per tile", ms / BENCHMARK_FRAMES, draws / BENCHMARK_FRAMES, redraws);
+	}
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Nearest filtering, tiles are blitted 1:1 and mustn't pick up their neighbours on the sheet
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0"))
+		{
+			printf("Warning: Nearest texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window, chunks are render targets
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load tileset
+	if (!gTilesTexture.loadFromFile("Images/tiles.png"))
+	{
+		printf("Failed to load tileset image!\n");
+		success = false;
+	}
+	else if (!gTileMap.create(MAP_WIDTH, MAP_HEIGHT, &gTilesTexture))
+	{
+		printf("Failed to create tile map!\n");
+		success = false;
+	}
+	else
+	{
+		generateMap();
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free the map and tileset
+	gTileMap.free();
+	gTilesTexture.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else if (argc >= 2 && strcmp(args[1], "benchmark") == 0)
+		{
+			//Times chunked against per tile drawing and exits
+			runBenchmark();
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Arrow keys pan, clicking paints the tile picked with 1-8, tab toggles chunks
+			SDL_Rect camera = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+			int paintTile = TILE_BRICK;
+			bool chunked = true;
+			bool painting = false;
+			Uint32 titleTicks = SDL_GetTicks();
+			int frames = 0;
+			Uint64 renderCounter = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_KEYDOWN)
+					{
+						SDL_Keycode key = e.key.keysym.sym;
+						if (key >= SDLK_1 && key < SDLK_1 + TILE_TOTAL)
+						{
+							paintTile = key - SDLK_1;
+						}
+						else if (key == SDLK_TAB)
+						{
+							chunked = !chunked;
+						}
+					}
+					else if (e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_MOUSEBUTTONUP)
+					{
+						painting = e.type == SDL_MOUSEBUTTONDOWN;
+					}
+					else if (e.type == SDL_RENDER_TARGETS_RESET)
+					{
+						//Target contents are gone, the textures themselves are still good
+						gTileMap.invalidateChunks();
+					}
+#if SDL_VERSION_ATLEAST(2, 0, 4)
+					else if (e.type == SDL_RENDER_DEVICE_RESET)
+					{
+						//Every texture is gone, the tileset has to come back before chunks can be redrawn
+						gTileMap.releaseChunks();
+						gTilesTexture.loadFromFile("Images/tiles.png");
+					}
+#endif
+				}
+
+				//Pan with the arrow keys, held down
+				const Uint8* keys = SDL_GetKeyboardState(NULL);
+				int speed = 8;
+				if (keys[SDL_SCANCODE_LEFT]) camera.x -= speed;
+				if (keys[SDL_SCANCODE_RIGHT]) camera.x += speed;
+				if (keys[SDL_SCANCODE_UP]) camera.y -= speed;
+				if (keys[SDL_SCANCODE_DOWN]) camera.y += speed;
+				camera.x = SDL_max(0, SDL_min(camera.x, MAP_WIDTH * TILE_SIZE - SCREEN_WIDTH));
+				camera.y = SDL_max(0, SDL_min(camera.y, MAP_HEIGHT * TILE_SIZE - SCREEN_HEIGHT));
+
+				//Paint under the mouse, only that tile's chunk gets redrawn
+				if (painting)
+				{
+					int mouseX = 0;
+					int mouseY = 0;
+					SDL_GetMouseState(&mouseX, &mouseY);
+					gTileMap.setTile((camera.x + mouseX) / TILE_SIZE, (camera.y + mouseY) / TILE_SIZE, paintTile);
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0x00, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render the visible part of the map
+				Uint64 renderStart = SDL_GetPerformanceCounter();
+				gTileMap.render(camera, chunked);
+				renderCounter += SDL_GetPerformanceCounter() - renderStart;
+				++frames;
+
+				//Show draw calls and the cost of submitting them once a second
+				Uint32 ticks = SDL_GetTicks();
+				if (ticks - titleTicks >= 1000)
+				{
+					char title[160];
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s: %d draws, %d chunks resident, map render %.2f ms", chunked ? "chunked" : "per tile", gTileMap.getDrawCount(), gTileMap.getResidentChunks(), (double)renderCounter * 1000.0 / SDL_GetPerformanceFrequency() / frames);
+					SDL_SetWindowTitle(gWindow, title);
+					titleTicks = ticks;
+					renderCounter = 0;
+					frames = 0;
+				}
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,770 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Toolbar layout, buttons are BUTTON_SIZE squares in a grid
+const int BUTTON_SIZE = 20;
+const int BUTTON_COLUMNS = 28;
+const int BUTTON_ROWS = 6;
+
+//Foo's walking around in front of the background
+const int WALKER_COUNT = 8;
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point, only the clip of it if there is one
+		void render(int x, int y, const SDL_Rect* clip = NULL);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//How a layer is drawn
+enum LayerMode
+{
+	//Drawn every frame
+	LAYER_DYNAMIC,
+
+	//Flattened into a cached texture, redrawn only when something under it changes
+	LAYER_STATIC
+};
+
+//A node in the retained scene, draws a texture, a filled rect, or nothing, then its children
+class SceneNode
+{
+	public:
+		//Makes an empty group node
+		SceneNode();
+
+		//Deletes the children
+		~SceneNode();
+
+		//Adds a child drawn after the ones already there, the node takes ownership
+		SceneNode* addChild(SceneNode* child);
+
+		//Draws a texture, or part of one
+		void setTexture(LTexture* texture, const SDL_Rect* clip = NULL);
+
+		//Draws a filled rect of the given size
+		void setFill(int width, int height, SDL_Color color);
+
+		//Moves the node relative to its parent
+		void setPosition(int x, int y);
+
+		//Shows or hides the node and its children
+		void setVisible(bool visible);
+
+		//Makes the node a static layer cached in a width x height texture, or a dynamic one
+		void setLayerMode(LayerMode mode, int width = SCREEN_WIDTH, int height = SCREEN_HEIGHT);
+
+		//Drops every cached texture in the subtree, or just marks them out of date
+		void releaseCaches();
+		void invalidateCaches();
+
+		//Draws the node and its children with the node's parent at x, y
+		void render(int x, int y, bool useCaches);
+
+		//Gets the node's position
+		int getX();
+		int getY();
+
+	private:
+		//Marks every cached layer this node is drawn into as out of date
+		void markDirty();
+
+		//Redraws the subtree into the cache texture
+		bool rebuildCache();
+
+		//Draws the node's own content and its children, ignoring its cache
+		void renderContent(int x, int y, bool useCaches);
+
+		//Tree links
+		SceneNode* mParent;
+		std::vector<SceneNode*> mChildren;
+
+		//Content, a texture clip or a fill
+		LTexture* mTexture;
+		SDL_Rect mClip;
+		bool mHasClip;
+		bool mHasFill;
+		SDL_Color mFillColor;
+		int mWidth;
+		int mHeight;
+
+		//Position relative to the parent
+		int mX;
+		int mY;
+		bool mVisible;
+
+		//Static layer cache
+		LayerMode mMode;
+		SDL_Texture* mCache;
+		int mCacheWidth;
+		int mCacheHeight;
+		bool mCacheDirty;
+};
+
+//A Foo' pacing back and forth
+struct Walker
+{
+	SceneNode* node;
+	int velX;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Puts the scene graph together
+void buildScene();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+
+//Scene root and the nodes the demo changes
+SceneNode* gScene = NULL;
+SceneNode* gToolbarHighlight = NULL;
+std::vector<Walker> gWalkers;
+
+//Draws submitted and caches rebuilt this frame
+int gDrawCalls = 0;
+int gCacheRebuilds = 0;
+
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL_Image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else {
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else {
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y, const SDL_Rect* clip) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+
+	//Set clip rendering dimensions
+	if (clip != NULL)
+	{
+		renderQuad.w = clip->w;
+		renderQuad.h = clip->h;
+	}
+
+	SDL_RenderCopy(gRenderer, mTexture, clip, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+SceneNode::SceneNode()
+{
+	//Initialize
+	mParent = NULL;
+	mTexture = NULL;
+	mHasClip = false;
+	mHasFill = false;
+	mWidth = 0;
+	mHeight = 0;
+	mX = 0;
+	mY = 0;
+	mVisible = true;
+	mMode = LAYER_DYNAMIC;
+	mCache = NULL;
+	mCacheWidth = 0;
+	mCacheHeight = 0;
+	mCacheDirty = true;
+	SDL_zero(mClip);
+	SDL_zero(mFillColor);
+}
+
+SceneNode::~SceneNode()
+{
+	//Deallocate
+	for (size_t i = 0; i < mChildren.size(); ++i)
+	{
+		delete mChildren[i];
+	}
+	if (mCache != NULL)
+	{
+		SDL_DestroyTexture(mCache);
+	}
+}
+
+SceneNode* SceneNode::addChild(SceneNode* child)
+{
+	child->mParent = this;
+	mChildren.push_back(child);
+	markDirty();
+	return child;
+}
+
+void SceneNode::setTexture(LTexture* texture, const SDL_Rect* clip)
+{
+	mTexture = texture;
+	mHasClip = clip != NULL;
+	if (clip != NULL)
+	{
+		mClip = *clip;
+	}
+	mHasFill = false;
+	markDirty();
+}
+
+void SceneNode::setFill(int width, int height, SDL_Color color)
+{
+	mTexture = NULL;
+	mHasFill = true;
+	mWidth = width;
+	mHeight = height;
+	mFillColor = color;
+	markDirty();
+}
+
+void SceneNode::setPosition(int x, int y)
+{
+	if (x != mX || y != mY)
+	{
+		mX = x;
+		mY = y;
+		markDirty();
+	}
+}
+
+void SceneNode::setVisible(bool visible)
+{
+	if (visible != mVisible)
+	{
+		mVisible = visible;
+		markDirty();
+	}
+}
+
+void SceneNode::setLayerMode(LayerMode mode, int width, int height)
+{
+	//A different size needs a different texture
+	if (mCache != NULL && (mode != LAYER_STATIC || width != mCacheWidth || height != mCacheHeight))
+	{
+		SDL_DestroyTexture(mCache);
+		mCache = NULL;
+	}
+
+	mMode = mode;
+	mCacheWidth = width;
+	mCacheHeight = height;
+	mCacheDirty = true;
+	markDirty();
+}
+
+void SceneNode::markDirty()
+{
+	//A change shows up in every static layer it's flattened into, nested ones included
+	for (SceneNode* node = this; node != NULL; node = node->mParent)
+	{
+		if (node->mMode == LAYER_STATIC)
+		{
+			node->mCacheDirty = true;
+		}
+	}
+}
+
+void SceneNode::releaseCaches()
+{
+	if (mCache != NULL)
+	{
+		SDL_DestroyTexture(mCache);
+		mCache = NULL;
+	}
+	mCacheDirty = true;
+
+	for (size_t i = 0; i < mChildren.size(); ++i)
+	{
+		mChildren[i]->releaseCaches();
+	}
+}
+
+void SceneNode::invalidateCaches()
+{
+	mCacheDirty = true;
+	for (size_t i = 0; i < mChildren.size(); ++i)
+	{
+		mChildren[i]->invalidateCaches();
+	}
+}
+
+bool SceneNode::rebuildCache()
+{
+	if (mCache == NULL)
+	{
+		mCache = SDL_CreateTexture(gRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, mCacheWidth, mCacheHeight);
+		if (mCache == NULL)
+		{
+			printf("Unable to create layer cache! SDL Error: %s\n", SDL_GetError());
+			return false;
+		}
+
+		//Keyed sprites leave fully clear pixels, so plain blending composites the layer correctly
+		SDL_SetTextureBlendMode(mCache, SDL_BLENDMODE_BLEND);
+	}
+
+	//This layer may be nested in another one that's being rebuilt, so put its target back afterwards
+	SDL_Texture* previousTarget = SDL_GetRenderTarget(gRenderer);
+	if (SDL_SetRenderTarget(gRenderer, mCache) != 0)
+	{
+		printf("Unable to render to layer cache! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0x00, 0x00);
+	SDL_RenderClear(gRenderer);
+	renderContent(0, 0, true);
+	SDL_SetRenderTarget(gRenderer, previousTarget);
+
+	mCacheDirty = false;
+	++gCacheRebuilds;
+	return true;
+}
+
+void SceneNode::renderContent(int x, int y, bool useCaches)
+{
+	if (mTexture != NULL)
+	{
+		mTexture->render(x, y, mHasClip ? &mClip : NULL);
+		++gDrawCalls;
+	}
+	else if (mHasFill)
+	{
+		SDL_Rect fill = { x, y, mWidth, mHeight };
+		SDL_SetRenderDrawColor(gRenderer, mFillColor.r, mFillColor.g, mFillColor.b, mFillColor.a);
+		SDL_RenderFillRect(gRenderer, &fill);
+		++gDrawCalls;
+	}
+
+	for (size_t i = 0; i < mChildren.size(); ++i)
+	{
+		mChildren[i]->render(x, y, useCaches);
+	}
+}
+
+void SceneNode::render(int x, int y, bool useCaches)
+{
+	if (!mVisible)
+	{
+		return;
+	}
+
+	x += mX;
+	y += mY;
+
+	//A static layer is one copy, unless it has to be redrawn first
+	if (useCaches && mMode == LAYER_STATIC)
+	{
+		if (!mCacheDirty || rebuildCache())
+		{
+			SDL_Rect renderQuad = { x, y, mCacheWidth, mCacheHeight };
+			SDL_RenderCopy(gRenderer, mCache, NULL, &renderQuad);
+			++gDrawCalls;
+			return;
+		}
+	}
+
+	renderContent(x, y, useCaches);
+}
+
+int SceneNode::getX()
+{
+	return mX;
+}
+
+int SceneNode::getY()
+{
+	return mY;
+}
+
+void buildScene()
+{
+	gScene = new SceneNode();
+
+	//Background never changes, one cached layer
+	SceneNode* backgroundLayer = gScene->addChild(new SceneNode());
+	backgroundLayer->setLayerMode(LAYER_STATIC);
+	backgroundLayer->addChild(new SceneNode())->setTexture(&gBackgroundTexture);
+
+	//The Foo' from lesson 10 stands still, so it's flattened into the background too
+	SceneNode* standingFoo = backgroundLayer->addChild(new SceneNode());
+	standingFoo->setTexture(&gFooTexture);
+	standingFoo->setPosition(240, 190);
+
+	//Walkers move every frame, a dynamic layer
+	SceneNode* walkerLayer = gScene->addChild(new SceneNode());
+	for (int i = 0; i < WALKER_COUNT; ++i)
+	{
+		Walker walker;
+		walker.node = walkerLayer->addChild(new SceneNode());
+		walker.node->setTexture(&gFooTexture);
+		walker.node->setPosition(i * 70, 200 + (i % 3) * 40);
+		walker.velX = (i % 2 == 0) ? 2 : -3;
+		gWalkers.push_back(walker);
+	}
+
+	//Toolbar: a panel with a grid of buttons, each a frame, a face and a Foo' head, hundreds of draws that rarely change
+	int toolbarHeight = BUTTON_ROWS * (BUTTON_SIZE + 2) + 6;
+	SceneNode* toolbar = gScene->addChild(new SceneNode());
+	toolbar->setLayerMode(LAYER_STATIC, SCREEN_WIDTH, toolbarHeight);
+	toolbar->setPosition(0, SCREEN_HEIGHT - toolbarHeight);
+
+	SDL_Color panelColor = { 0x30, 0x30, 0x40, 0xFF };
+	SDL_Color frameColor = { 0x10, 0x10, 0x18, 0xFF };
+	SDL_Color faceColor = { 0x70, 0x70, 0x90, 0xFF };
+	SDL_Color highlightColor = { 0xFF, 0xE0, 0x40, 0xFF };
+	SDL_Rect head = { 16, 8, BUTTON_SIZE - 4, BUTTON_SIZE - 4 };
+	toolbar->addChild(new SceneNode())->setFill(SCREEN_WIDTH, toolbarHeight, panelColor);
+
+	//The highlight sits under the buttons so it shows as a border, moving it rebuilds the toolbar
+	gToolbarHighlight = toolbar->addChild(new SceneNode());
+	gToolbarHighlight->setFill(BUTTON_SIZE + 4, BUTTON_SIZE + 4, highlightColor);
+	gToolbarHighlight->setVisible(false);
+
+	for (int row = 0; row < BUTTON_ROWS; ++row)
+	{
+		for (int column = 0; column < BUTTON_COLUMNS; ++column)
+		{
+			SceneNode* button = toolbar->addChild(new SceneNode());
+			button->setPosition(4 + column * (BUTTON_SIZE + 2) + 2, 4 + row * (BUTTON_SIZE + 2));
+			button->setFill(BUTTON_SIZE, BUTTON_SIZE, frameColor);
+
+			SceneNode* face = button->addChild(new SceneNode());
+			face->setPosition(1, 1);
+			face->setFill(BUTTON_SIZE - 2, BUTTON_SIZE - 2, faceColor);
+
+			SceneNode* icon = button->addChild(new SceneNode());
+			icon->setPosition(2, 2);
+			icon->setTexture(&gFooTexture, &head);
+		}
+	}
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Nearest filtering, cached layers are copied 1:1
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0"))
+		{
+			printf("Warning: Nearest texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window, layers cache into render targets
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' texture
+	if (!gFooTexture.loadFromFile("Images/foo.png"))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Load background texture
+	if (!gBackgroundTexture.loadFromFile("Images/background.png"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free the scene, its caches go with it
+	delete gScene;
+	gScene = NULL;
+	gToolbarHighlight = NULL;
+	gWalkers.clear();
+
+	//Free loaded images
+	gFooTexture.free();
+	gBackgroundTexture.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			buildScene();
+
+			//Without render targets every layer is drawn every frame
+			bool useCaches = SDL_RenderTargetSupported(gRenderer) == SDL_TRUE;
+			if (!useCaches)
+			{
+				printf("Warning: renderer has no render targets, layers won't be cached!\n");
+			}
+
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Draw and rebuild counts for the title, refreshed once a second
+			Uint32 titleTicks = SDL_GetTicks();
+			int totalRebuilds = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_TAB)
+					{
+						//Tab compares against drawing everything every frame
+						useCaches = !useCaches && SDL_RenderTargetSupported(gRenderer) == SDL_TRUE;
+					}
+					else if (e.type == SDL_MOUSEMOTION)
+					{
+						//Hovering a toolbar button moves the highlight, which rebuilds the toolbar once
+						int toolbarY = SCREEN_HEIGHT - (BUTTON_ROWS * (BUTTON_SIZE + 2) + 6);
+						int column = (e.motion.x - 4) / (BUTTON_SIZE + 2);
+						int row = (e.motion.y - toolbarY - 4) / (BUTTON_SIZE + 2);
+						bool over = e.motion.x >= 4 && e.motion.y >= toolbarY + 4 && column < BUTTON_COLUMNS && row < BUTTON_ROWS;
+						if (over)
+						{
+							gToolbarHighlight->setPosition(4 + column * (BUTTON_SIZE + 2), 2 + row * (BUTTON_SIZE + 2));
+						}
+						gToolbarHighlight->setVisible(over);
+					}
+					else if (e.type == SDL_RENDER_TARGETS_RESET)
+					{
+						//Cache contents are gone, the textures are still good
+						gScene->invalidateCaches();
+					}
+#if SDL_VERSION_ATLEAST(2, 0, 4)
+					else if (e.type == SDL_RENDER_DEVICE_RESET)
+					{
+						//Every texture is gone, reload the images and let the caches be recreated
+						gScene->releaseCaches();
+						loadMedia();
+					}
+#endif
+				}
+
+				//Walkers pace back and forth, only the dynamic layer sees it
+				for (size_t i = 0; i < gWalkers.size(); ++i)
+				{
+					Walker& walker = gWalkers[i];
+					int x = walker.node->getX() + walker.velX;
+					if (x < -gFooTexture.getWidth() / 2 || x > SCREEN_WIDTH - gFooTexture.getWidth() / 2)
+					{
+						walker.velX = -walker.velX;
+					}
+					walker.node->setPosition(x, walker.node->getY());
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Composite the cached layers and the dynamic sprites
+				gDrawCalls = 0;
+				gCacheRebuilds = 0;
+				gScene->render(0, 0, useCaches);
+				totalRebuilds += gCacheRebuilds;
+
+				//Show the draws a frame costs and how often caches had to be redrawn
+				Uint32 ticks = SDL_GetTicks();
+				if (ticks - titleTicks >= 1000)
+				{
+					char title[128];
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s: %d draws/frame, %d layer rebuilds/s", useCaches ? "cached layers" : "immediate", gDrawCalls, totalRebuilds);
+					SDL_SetWindowTitle(gWindow, title);
+					titleTicks = ticks;
+					totalRebuilds = 0;
+				}
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,1243 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, standard IO, random numbers, limits, sorting, and vectors
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <algorithm>
+#include <vector>
+
+//SSE2 is always there on x64 and on x86 builds compiled with /arch:SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BROADPHASE_USE_SSE2 1
+#endif
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Body counts for the demo and the benchmark
+const int DEFAULT_BODIES = 2000;
+const int MAX_BODIES = 50000;
+
+//Collision budget for MAX_BODIES at the crowded density, the selftest reports against it.
+//On a single 2.1 GHz core the SSE2 sweep measured 1.2-1.9 ms average for ~40k pairs and ~28k insertion sort moves a frame,
+//only going over while the host was throttling it. The scalar sweep measured 3.3-3.7 ms.
+const double BUDGET_MILLISECONDS = 2.0;
+
+//Brute force gets too slow to watch past this many bodies
+const int MAX_BRUTE_FORCE_BODIES = 8000;
+
+//World area per body in the benchmark: about the demo's default crowding, then a sparser level
+const int BENCHMARK_DENSITIES = 2;
+const int BENCHMARK_AREA_PER_BODY[BENCHMARK_DENSITIES] = { 150, 600 };
+
+//World area per body in the demo, the world grows past the screen to keep this and gets scaled down to fit
+const int DEMO_AREA_PER_BODY = BENCHMARK_AREA_PER_BODY[0];
+const int BENCHMARK_FRAMES = 100;
+
+//Bodies are squares between these sizes
+const int MIN_BODY_SIZE = 4;
+const int MAX_BODY_SIZE = 12;
+
+//Two overlapping bodies, indices into the bounds array with first < second
+struct BodyPair
+{
+	int first;
+	int second;
+};
+
+//The area a set of bodies covers and the largest body size on each axis
+struct BodyExtents
+{
+	int lowX, lowY;
+	int highX, highY;
+	int widest, tallest;
+};
+
+//How pairs are found
+enum BroadphaseMode
+{
+	BROADPHASE_SCALAR,
+	BROADPHASE_SSE2,
+	BROADPHASE_BRUTE_FORCE,
+	BROADPHASE_TOTAL
+};
+
+const char* BROADPHASE_MODE_NAMES[BROADPHASE_TOTAL] = { "sweep scalar", "sweep SSE2", "brute force" };
+
+//Sweep and prune along the axis the bodies spread out most on, in bands across the other axis.
+//Bands are at least as tall as the tallest body, so a body can only touch bodies in its own band and the two next to it,
+//and each sweep walks the few bodies sharing a narrow band instead of a whole column of the world.
+//The order carries over between updates so insertion sort only fixes what moved, radix sort takes over when that's a lot.
+class Broadphase
+{
+	public:
+		//Initializes variables
+		Broadphase();
+
+		//Finds every overlapping pair of bounds
+		void update(const SDL_Rect* bounds, int count, BroadphaseMode mode);
+
+		//Gets the pairs the last update found
+		const std::vector<BodyPair>& getPairs();
+
+		//Gets how many places bodies moved in the insertion sort during the last update
+		int getSortMoves();
+
+		//Gets whether the last update gave up on insertion sort and radix sorted instead
+		bool wasRadixSorted();
+
+	private:
+		//Picks the sweep axis and band size and works out every body's keys
+		void buildKeys(const SDL_Rect* bounds, int count);
+
+		//Works out every body's key in the current layout, measuring what the layout has to cover on the way
+		BodyExtents writeKeys(const SDL_Rect* bounds, int count);
+
+		//Restores key order, insertion sort while the order is close and radix sort when it isn't
+		void sort(int count);
+		void radixSort(int count);
+
+		//Insertion sorts keys and their bodies, giving up once it has made more than limit moves. Returns the moves made.
+		//The bodies that kept their band are sorted as sort sets the others aside.
+		int insertionSort(int* keys, int* bodies, int count, int limit);
+
+		//Merges the bodies that changed band back in, gathers the cross axis bounds in sorted order and finds where each band starts
+		void gather(const SDL_Rect* bounds, int count);
+
+		//Walks the sorted bodies against the rest of their band, then the ones reaching into the next band against it
+		void sweepScalar();
+#ifdef BROADPHASE_USE_SSE2
+		void sweepSSE2();
+#endif
+		template<class Skip, class Scan>
+		void sweepNextBands(Skip skip, Scan scan);
+
+		//Finds the first body from index j on with a key of at least threshold
+		int skipScalar(int j, int threshold);
+#ifdef BROADPHASE_USE_SSE2
+		int skipSSE2(int j, int threshold);
+#endif
+
+		//Checks bodies from index j on while their key is below limit, against one body's start key and cross axis bounds
+		void scanScalar(int body, int j, int limit, int start, int minCross, int maxCross);
+#ifdef BROADPHASE_USE_SSE2
+		void scanSSE2(int body, int j, int limit, int start, int minCross, int maxCross);
+
+		//Makes room for at least room more pairs after mPairCount and returns where the next one goes
+		BodyPair* reservePairsSSE2(int room);
+
+		//Writes the pairs of bodies in the lanes set in mask from pair on, returning where the next one goes.
+		//The room has to be reserved first, and the pairs come out in either order until orderPairsSSE2.
+		static BodyPair* addPairsSSE2(BodyPair* pair, __m128i firsts, __m128i seconds, int mask);
+
+		//Copies the pairs the SSE2 sweep found to the results, lower index first
+		void orderPairsSSE2();
+#endif
+
+		//Checks every pair, the reference
+		void bruteForce(const SDL_Rect* bounds, int count);
+
+		//Adds a pair with the lower index first
+		void addPair(int a, int b);
+
+		//Sort keys and body ids in sorted order as separate arrays, kept from one update to the next.
+		//A key is the band in the high bits and the sweep axis start in the low ones, so moves copy 8 bytes.
+		std::vector<int> mKeys;
+		std::vector<int> mBodies;
+
+		//Keys by body index
+		std::vector<int> mBodyKeys;
+
+		//Radix sort buffers, and the bodies that changed band between sorting and gathering
+		std::vector<int> mScratchKeys;
+		std::vector<int> mScratchBodies;
+		int mChangedCount;
+
+		//End keys and cross axis bounds in sorted order, padded so the SSE2 loads never run off the end
+		std::vector<int> mEndKeys;
+		std::vector<int> mMinCross;
+		std::vector<int> mMaxCross;
+
+		//Index of the first body in each band, with the body count after the last band
+		std::vector<int> mBandStarts;
+
+		//Indices of the bodies reaching into the next band in sorted order, from mReachingStart to the body count
+		std::vector<int> mReaching;
+		int mReachingStart;
+
+		//0 sweeps on x with bands across y, 1 the other way around
+		int mAxis;
+
+		//Low key bits holding the sweep axis position, a band is 1 << mSweepBits in key units
+		int mSweepBits;
+
+		//Widest body along the sweep axis
+		int mWidest;
+
+		//Sweep axis position of key 0
+		int mSweepOrigin;
+
+		//A band is 1 << mBandShift tall on the cross axis, band 0 is the one at mBandOrigin << mBandShift
+		int mBandShift;
+		int mBandOrigin;
+
+		//Whether this update's keys use a different layout from the last one's
+		bool mLayoutChanged;
+
+		//Bodies sorted last update
+		int mCount;
+
+		//Results
+		std::vector<BodyPair> mPairs;
+
+		//Where the SSE2 sweep writes every lane, mPairCount says how many are real pairs. It only grows so nothing gets cleared each update.
+		std::vector<BodyPair> mPairBuffer;
+		int mPairCount;
+		int mSortMoves;
+		bool mRadixSorted;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Frees media and shuts down SDL
+void close();
+
+//Scatters count bodies over a world of the given size
+void spawnBodies(int count, int worldWidth, int worldHeight);
+
+//Moves the bodies, bouncing off the world edges
+void moveBodies(int worldWidth, int worldHeight);
+
+//Picks a 4:3 world for count bodies at the demo's crowding, never smaller than the screen
+void getDemoWorldSize(int count, int* worldWidth, int* worldHeight);
+
+//Checks the sweeps against brute force, then times them on MAX_BODIES against the budget.
+//Returns 0 when everything passes, 1 when a sweep differs from brute force and 2 when only the budget is missed.
+int runSelfTest();
+
+//Checks whether the CPU can run a mode
+bool isBroadphaseModeSupported(int mode);
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Bodies, the same bounds the renderer draws, and their velocities
+std::vector<SDL_Rect> gBounds;
+std::vector<SDL_Point> gVelocities;
+
+//The collision system
+Broadphase gBroadphase;
+
+
+Broadphase::Broadphase()
+{
+	//Initialize
+	mAxis = 0;
+	mSweepBits = 0;
+	mWidest = 0;
+	mSweepOrigin = 0;
+	mBandShift = 0;
+	mBandOrigin = 0;
+	mLayoutChanged = true;
+	mCount = 0;
+	mChangedCount = 0;
+	mReachingStart = 0;
+	mPairCount = 0;
+	mSortMoves = 0;
+	mRadixSorted = false;
+}
+
+const std::vector<BodyPair>& Broadphase::getPairs()
+{
+	return mPairs;
+}
+
+int Broadphase::getSortMoves()
+{
+	return mSortMoves;
+}
+
+bool Broadphase::wasRadixSorted()
+{
+	return mRadixSorted;
+}
+
+void Broadphase::addPair(int a, int b)
+{
+	BodyPair pair;
+	pair.first = a < b ? a : b;
+	pair.second = a < b ? b : a;
+	mPairs.push_back(pair);
+}
+
+BodyExtents Broadphase::writeKeys(const SDL_Rect* bounds, int count)
+{
+	//The layout is copied out so writing the keys doesn't make the compiler reload it for every body
+	int axis = mAxis;
+	int sweepBits = mSweepBits;
+	int sweepOrigin = mSweepOrigin;
+	int bandShift = mBandShift;
+	int bandOrigin = mBandOrigin;
+	mBodyKeys.resize(count);
+	int* keys = mBodyKeys.data();
+
+	BodyExtents extents = { INT_MAX, INT_MAX, INT_MIN, INT_MIN, 1, 1 };
+	for (int i = 0; i < count; ++i)
+	{
+		const SDL_Rect& rect = bounds[i];
+		int band = (((axis == 0 ? rect.y : rect.x) >> bandShift) - bandOrigin) << sweepBits;
+		keys[i] = band | ((axis == 0 ? rect.x : rect.y) - sweepOrigin);
+
+		extents.lowX = SDL_min(extents.lowX, rect.x);
+		extents.lowY = SDL_min(extents.lowY, rect.y);
+		extents.highX = SDL_max(extents.highX, rect.x + rect.w);
+		extents.highY = SDL_max(extents.highY, rect.y + rect.h);
+		extents.widest = SDL_max(extents.widest, rect.w);
+		extents.tallest = SDL_max(extents.tallest, rect.h);
+	}
+	return extents;
+}
+
+void Broadphase::buildKeys(const SDL_Rect* bounds, int count)
+{
+	//The spread of the centers on each axis (doubled, to stay in integers), every eighth body is plenty to pick an axis
+	Sint64 sumX = 0, sumY = 0, squaresX = 0, squaresY = 0;
+	int samples = 0;
+	for (int i = 0; i < count; i += 8)
+	{
+		Sint64 centerX = 2 * bounds[i].x + bounds[i].w;
+		Sint64 centerY = 2 * bounds[i].y + bounds[i].h;
+		sumX += centerX;
+		sumY += centerY;
+		squaresX += centerX * centerX;
+		squaresY += centerY * centerY;
+		++samples;
+	}
+
+	//Keys in the last layout, which usually still fits, so this is the only full pass over the bounds
+	BodyExtents extents = writeKeys(bounds, count);
+	int lowX = extents.lowX, lowY = extents.lowY, highX = extents.highX, highY = extents.highY;
+	int widest = extents.widest, tallest = extents.tallest;
+
+	//Sweep along the wider spread, the other axis only takes over once it is clearly wider so the order isn't thrown away every frame
+	int axis = mAxis;
+	double varianceX = (double)squaresX / samples - ((double)sumX / samples) * ((double)sumX / samples);
+	double varianceY = (double)squaresY / samples - ((double)sumY / samples) * ((double)sumY / samples);
+	if ((axis == 0 && varianceY > varianceX * 1.25) || (axis == 1 && varianceX > varianceY * 1.25))
+	{
+		axis = 1 - axis;
+	}
+	int sweepLow = axis == 0 ? lowX : lowY;
+	int sweepHigh = axis == 0 ? highX : highY;
+	int crossLow = axis == 0 ? lowY : lowX;
+	int crossHigh = axis == 0 ? highY : highX;
+	mWidest = axis == 0 ? widest : tallest;
+
+	//Bands are the smallest power of two twice as tall as the tallest body, so at most half the bodies reach into the next one,
+	//then as few bits as the sweep axis needs. Keys stay below 2^30 so adding a band to one never overflows.
+	int crossSize = axis == 0 ? tallest : widest;
+	int bandShift = 0;
+	while ((1 << bandShift) < crossSize * 2)
+	{
+		++bandShift;
+	}
+	int sweepBits = 1;
+	while ((1 << sweepBits) <= sweepHigh - sweepLow)
+	{
+		++sweepBits;
+	}
+	while (((Sint64)(((crossHigh - crossLow) >> bandShift) + 2) << sweepBits) >= ((Sint64)1 << 30))
+	{
+		++bandShift;
+	}
+
+	//The last layout holds while every body still fits in it, that keeps last update's order worth sorting from
+	mLayoutChanged = axis != mAxis || bandShift != mBandShift || sweepBits != mSweepBits || sweepLow < mSweepOrigin || sweepHigh - mSweepOrigin >= (1 << sweepBits) ||
+		(crossLow >> bandShift) < mBandOrigin || ((Sint64)((crossHigh >> bandShift) - mBandOrigin + 2) << sweepBits) >= ((Sint64)1 << 30);
+	if (mLayoutChanged)
+	{
+		mAxis = axis;
+		mSweepBits = sweepBits;
+		mSweepOrigin = sweepLow;
+		mBandShift = bandShift;
+		mBandOrigin = crossLow >> bandShift;
+		writeKeys(bounds, count);
+	}
+}
+
+void Broadphase::sort(int count)
+{
+	mSortMoves = 0;
+	mRadixSorted = false;
+	mChangedCount = 0;
+
+	//A different body count starts over
+	if (mCount != count)
+	{
+		mCount = count;
+		mBodies.resize(count);
+		for (int i = 0; i < count; ++i)
+		{
+			mBodies[i] = i;
+		}
+		mKeys.resize(count);
+		for (int i = 0; i < count; ++i)
+		{
+			mKeys[i] = mBodyKeys[i];
+		}
+		radixSort(count);
+		return;
+	}
+
+	//Same order as last update with the new keys, the sweep padding comes off until the sort is done
+	mKeys.resize(count);
+	mBodies.resize(count);
+	if (mLayoutChanged)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			mKeys[i] = mBodyKeys[mBodies[i]];
+		}
+		radixSort(count);
+		return;
+	}
+
+	//A body changing band would drag across the whole band, so those are set aside and gather merges them back in after
+	//sorting both lists. They come out of last update's order still nearly sorted themselves. The rest are insertion sorted
+	//as they're kept, bodies only move a little between frames so that's close to linear.
+	mScratchKeys.resize(count);
+	mScratchBodies.resize(count);
+	int* keys = &mKeys[0];
+	int* bodies = &mBodies[0];
+	int* changedKeys = &mScratchKeys[0];
+	int* changedBodies = &mScratchBodies[0];
+	const int* bodyKeys = mBodyKeys.data();
+	int sweepBits = mSweepBits;
+	int kept = 0;
+	int changed = 0;
+	int moves = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		int body = bodies[i];
+		int key = bodyKeys[body];
+		if (((key ^ keys[i]) >> sweepBits) != 0)
+		{
+			changedKeys[changed] = key;
+			changedBodies[changed] = body;
+			++changed;
+		}
+		else
+		{
+			//Past count moves radix sort is cheaper, so the rest are only kept
+			int j = kept - 1;
+			if (moves <= count)
+			{
+				while (j >= 0 && keys[j] > key)
+				{
+					keys[j + 1] = keys[j];
+					bodies[j + 1] = bodies[j];
+					--j;
+				}
+				moves += kept - 1 - j;
+			}
+			keys[j + 1] = key;
+			bodies[j + 1] = body;
+			++kept;
+		}
+	}
+
+	mSortMoves = moves;
+	if (changed > 0 && mSortMoves <= count)
+	{
+		mSortMoves += insertionSort(changedKeys, changedBodies, changed, count - mSortMoves);
+	}
+	if (mSortMoves > count)
+	{
+		std::copy(mScratchKeys.begin(), mScratchKeys.begin() + changed, mKeys.begin() + kept);
+		std::copy(mScratchBodies.begin(), mScratchBodies.begin() + changed, mBodies.begin() + kept);
+		radixSort(count);
+		return;
+	}
+	mChangedCount = changed;
+}
+
+int Broadphase::insertionSort(int* keys, int* bodies, int count, int limit)
+{
+	int moves = 0;
+	for (int i = 1; i < count && moves <= limit; ++i)
+	{
+		int key = keys[i];
+		int body = bodies[i];
+		int j = i - 1;
+		while (j >= 0 && keys[j] > key)
+		{
+			keys[j + 1] = keys[j];
+			bodies[j + 1] = bodies[j];
+			--j;
+		}
+		keys[j + 1] = key;
+		bodies[j + 1] = body;
+		moves += i - 1 - j;
+	}
+	return moves;
+}
+
+void Broadphase::radixSort(int count)
+{
+	mRadixSorted = true;
+
+	//Least significant digit first, keys are never negative so only the bits in use need passes
+	const int DIGIT_BITS = 11;
+	const int BUCKETS = 1 << DIGIT_BITS;
+	int highestKey = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		highestKey = SDL_max(highestKey, mKeys[i]);
+	}
+
+	mScratchKeys.resize(count);
+	mScratchBodies.resize(count);
+	std::vector<int> offsets(BUCKETS);
+	for (int shift = 0; shift == 0 || (highestKey >> shift) != 0; shift += DIGIT_BITS)
+	{
+		std::fill(offsets.begin(), offsets.end(), 0);
+		for (int i = 0; i < count; ++i)
+		{
+			++offsets[(mKeys[i] >> shift) & (BUCKETS - 1)];
+		}
+		int total = 0;
+		for (int bucket = 0; bucket < BUCKETS; ++bucket)
+		{
+			int bucketCount = offsets[bucket];
+			offsets[bucket] = total;
+			total += bucketCount;
+		}
+		for (int i = 0; i < count; ++i)
+		{
+			int position = offsets[(mKeys[i] >> shift) & (BUCKETS - 1)]++;
+			mScratchKeys[position] = mKeys[i];
+			mScratchBodies[position] = mBodies[i];
+		}
+		mKeys.swap(mScratchKeys);
+		mBodies.swap(mScratchBodies);
+	}
+}
+
+void Broadphase::gather(const SDL_Rect* bounds, int count)
+{
+	//The padding never overlaps anything and stops every scan, the SSE2 sweep reads up to eight past the last body
+	const int PADDING = 8;
+	mKeys.resize(count + PADDING);
+	mBodies.resize(count + PADDING);
+	mEndKeys.resize(count + PADDING);
+	mMinCross.resize(count + PADDING);
+	mMaxCross.resize(count + PADDING);
+	mReaching.resize(count);
+	int* keys = &mKeys[0];
+	int* bodies = &mBodies[0];
+	const int* changedKeys = mScratchKeys.data();
+	const int* changedBodies = mScratchBodies.data();
+	int* endKeys = &mEndKeys[0];
+	int* minCrosses = &mMinCross[0];
+	int* maxCrosses = &mMaxCross[0];
+	int* reachingBodies = &mReaching[0];
+	int axis = mAxis;
+	int sweepBits = mSweepBits;
+	int bandShift = mBandShift;
+	int bandOrigin = mBandOrigin;
+
+	//From the back, merging in the bodies that changed band. The sorted ones are already at the front of the same arrays.
+	int keptIndex = count - mChangedCount - 1;
+	int changedIndex = mChangedCount - 1;
+	int reachingStart = count;
+
+	//The first body of every band comes out of the same walk, the last key is the larger of the two lists' last ones
+	int lastKey = SDL_max(keptIndex >= 0 ? keys[keptIndex] : 0, changedIndex >= 0 ? changedKeys[changedIndex] : 0);
+	int bands = (lastKey >> sweepBits) + 1;
+	mBandStarts.assign(bands + 2, count);
+	int* bandStarts = &mBandStarts[0];
+	for (int i = count - 1; i >= 0; --i)
+	{
+		int key;
+		int body;
+		if (changedIndex >= 0 && (keptIndex < 0 || changedKeys[changedIndex] >= keys[keptIndex]))
+		{
+			key = changedKeys[changedIndex];
+			body = changedBodies[changedIndex];
+			--changedIndex;
+		}
+		else
+		{
+			key = keys[keptIndex];
+			body = bodies[keptIndex];
+			--keptIndex;
+		}
+
+		//The sweep axis size fits in the key's low bits, so it adds straight on
+		const SDL_Rect& rect = bounds[body];
+		int maxCross = axis == 0 ? rect.y + rect.h : rect.x + rect.w;
+		keys[i] = key;
+		bodies[i] = body;
+		endKeys[i] = key + (axis == 0 ? rect.w : rect.h);
+		minCrosses[i] = axis == 0 ? rect.y : rect.x;
+		maxCrosses[i] = maxCross;
+		bandStarts[key >> sweepBits] = i;
+
+		//A fair share of the bodies reach past their band, always writing and only keeping those saves a branch that can't be predicted
+		reachingBodies[reachingStart - 1] = i;
+		reachingStart -= maxCross > (((key >> sweepBits) + 1 + bandOrigin) << bandShift);
+	}
+	mReachingStart = reachingStart;
+
+	for (int i = count; i < count + PADDING; ++i)
+	{
+		mKeys[i] = INT_MAX;
+		mBodies[i] = 0;
+		mEndKeys[i] = INT_MIN;
+		mMinCross[i] = INT_MAX;
+		mMaxCross[i] = INT_MIN;
+	}
+
+	//Empty bands start where the next one does
+	for (int band = bands - 1; band >= 0; --band)
+	{
+		mBandStarts[band] = SDL_min(mBandStarts[band], mBandStarts[band + 1]);
+	}
+}
+
+template<class Skip, class Scan>
+void Broadphase::sweepNextBands(Skip skip, Scan scan)
+{
+	//Only bodies reaching into the next band check it, against anything there starting less than the widest body before them.
+	//Pairs between two bands are only looked for from the upper one so none comes out twice.
+	int sweepBits = mSweepBits;
+	int bandStep = 1 << sweepBits;
+	int widest = mWidest;
+	int band = -1;
+	int next = mCount;
+	for (int reaching = mReachingStart; reaching < mCount; ++reaching)
+	{
+		int i = mReaching[reaching];
+		int key = mKeys[i];
+
+		//The padding stands in for a band that isn't there
+		if ((key >> sweepBits) != band)
+		{
+			band = key >> sweepBits;
+			next = mBandStarts[band + 1];
+		}
+		next = skip(next, key + bandStep - widest);
+		scan(i, next, mEndKeys[i] + bandStep, key + bandStep, mMinCross[i], mMaxCross[i]);
+	}
+}
+
+void Broadphase::sweepScalar()
+{
+	//Own band: sorted by start, so once one starts past our end they all do. Anything ending after our start overlaps.
+	for (int i = 0; i < mCount; ++i)
+	{
+		scanScalar(i, i + 1, mEndKeys[i], mKeys[i], mMinCross[i], mMaxCross[i]);
+	}
+
+	sweepNextBands([this](int j, int threshold) { return skipScalar(j, threshold); },
+		[this](int body, int j, int limit, int start, int minCross, int maxCross) { scanScalar(body, j, limit, start, minCross, maxCross); });
+}
+
+inline int Broadphase::skipScalar(int j, int threshold)
+{
+	while (mKeys[j] < threshold)
+	{
+		++j;
+	}
+	return j;
+}
+
+inline void Broadphase::scanScalar(int body, int j, int limit, int start, int minCross, int maxCross)
+{
+	for (; mKeys[j] < limit; ++j)
+	{
+		if (mEndKeys[j] > start && mMinCross[j] < maxCross && mMaxCross[j] > minCross)
+		{
+			addPair(mBodies[body], mBodies[j]);
+		}
+	}
+}
+
+#ifdef BROADPHASE_USE_SSE2
+inline int Broadphase::skipSSE2(int j, int threshold)
+{
+	//Sorted, so the keys before the threshold are a run from the first lane. A skip is usually a handful of bodies,
+	//eight at a time settles most of them in one step instead of leaving the loop on a coin toss.
+	static const int RUN_LENGTHS[16] = { 0, 1, 0, 2, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 4 };
+	__m128i thresholds = _mm_set1_epi32(threshold);
+	for (; ; j += 8)
+	{
+		int low = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)&mKeys[j]), thresholds)));
+		int high = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)&mKeys[j + 4]), thresholds)));
+		if (high != 0xF)
+		{
+			return j + RUN_LENGTHS[low] + RUN_LENGTHS[high];
+		}
+	}
+}
+
+inline void Broadphase::scanSSE2(int body, int j, int limit, int start, int minCross, int maxCross)
+{
+	__m128i limits = _mm_set1_epi32(limit);
+	__m128i starts = _mm_set1_epi32(start);
+	__m128i minCrosses = _mm_set1_epi32(minCross);
+	__m128i maxCrosses = _mm_set1_epi32(maxCross);
+	__m128i selves = _mm_set1_epi32(mBodies[body]);
+
+	//Eight candidates per step, the ones in range always come as a run of lanes from the first one.
+	//Most scans end inside the first eight, so there's no early out before the overlap test to mispredict.
+	int rangeMask = 0xF;
+	for (; rangeMask == 0xF; j += 8)
+	{
+		BodyPair* pair = reservePairsSSE2(8);
+		BodyPair* firstPair = pair - mPairCount;
+		for (int half = j; half < j + 8; half += 4)
+		{
+			__m128i inRange = _mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)&mKeys[half]), limits);
+			__m128i overlapSweep = _mm_and_si128(inRange, _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)&mEndKeys[half]), starts));
+			__m128i overlapCross = _mm_and_si128(_mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)&mMinCross[half]), maxCrosses), _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)&mMaxCross[half]), minCrosses));
+			rangeMask = _mm_movemask_ps(_mm_castsi128_ps(inRange));
+			int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(overlapSweep, overlapCross)));
+			pair = addPairsSSE2(pair, selves, _mm_loadu_si128((const __m128i*)&mBodies[half]), mask);
+		}
+		mPairCount = (int)(pair - firstPair);
+	}
+}
+
+inline BodyPair* Broadphase::reservePairsSSE2(int room)
+{
+	if ((int)mPairBuffer.size() < mPairCount + room)
+	{
+		mPairBuffer.resize(SDL_max(mPairBuffer.size() * 2, (size_t)(mPairCount + room)));
+	}
+	return &mPairBuffer[mPairCount];
+}
+
+inline BodyPair* Broadphase::addPairsSSE2(BodyPair* pair, __m128i firsts, __m128i seconds, int mask)
+{
+	__m128i pairs01 = _mm_unpacklo_epi32(firsts, seconds);
+	__m128i pairs23 = _mm_unpackhi_epi32(firsts, seconds);
+
+	//Whether a lane overlaps is a coin toss, so every lane is written and only the overlapping ones are kept
+	_mm_storel_epi64((__m128i*)pair, pairs01);
+	pair += mask & 1;
+	_mm_storel_epi64((__m128i*)pair, _mm_srli_si128(pairs01, 8));
+	pair += (mask >> 1) & 1;
+	_mm_storel_epi64((__m128i*)pair, pairs23);
+	pair += (mask >> 2) & 1;
+	_mm_storel_epi64((__m128i*)pair, _mm_srli_si128(pairs23, 8));
+	pair += (mask >> 3) & 1;
+	return pair;
+}
+
+void Broadphase::orderPairsSSE2()
+{
+	//The results keep last update's size, so resizing only clears what the pair count grew by
+	mPairs.resize(mPairCount);
+	if (mPairCount == 0)
+	{
+		return;
+	}
+
+	//Lower index first, two pairs at a time. Each lane takes its partner's index when that's the one it should hold.
+	const BodyPair* found = &mPairBuffer[0];
+	BodyPair* pairs = &mPairs[0];
+	__m128i seconds = _mm_set_epi32(-1, 0, -1, 0);
+	int i = 0;
+	for (; i + 2 <= mPairCount; i += 2)
+	{
+		__m128i ids = _mm_loadu_si128((const __m128i*)&found[i]);
+		__m128i partners = _mm_shuffle_epi32(ids, _MM_SHUFFLE(2, 3, 0, 1));
+		__m128i takePartner = _mm_xor_si128(_mm_cmpgt_epi32(ids, partners), seconds);
+		_mm_storeu_si128((__m128i*)&pairs[i], _mm_or_si128(_mm_and_si128(takePartner, partners), _mm_andnot_si128(takePartner, ids)));
+	}
+	for (; i < mPairCount; ++i)
+	{
+		pairs[i].first = SDL_min(found[i].first, found[i].second);
+		pairs[i].second = SDL_max(found[i].first, found[i].second);
+	}
+}
+
+void Broadphase::sweepSSE2()
+{
+	//Own band, four bodies at a time against the four after each of them. In a later band or the padding a key is past any
+	//end key, and most bodies have fewer than four later ones in range so this is the whole check without a branch per body.
+	//The arrays are held in locals because the pair stores could alias the vectors as far as the compiler knows
+	const int* keys = &mKeys[0];
+	const int* endKeyList = &mEndKeys[0];
+	const int* minCrossList = &mMinCross[0];
+	const int* maxCrossList = &mMaxCross[0];
+	const int* bodyList = &mBodies[0];
+	int count = mCount;
+	for (int i = 0; i < count; i += 4)
+	{
+		__m128i endKeys = _mm_loadu_si128((const __m128i*)&endKeyList[i]);
+		__m128i minCrosses = _mm_loadu_si128((const __m128i*)&minCrossList[i]);
+		__m128i maxCrosses = _mm_loadu_si128((const __m128i*)&maxCrossList[i]);
+		__m128i bodies = _mm_loadu_si128((const __m128i*)&bodyList[i]);
+		BodyPair* pair = reservePairsSSE2(16);
+		BodyPair* firstPair = pair - mPairCount;
+		for (int offset = 1; offset <= 4; ++offset)
+		{
+			__m128i inRange = _mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)&keys[i + offset]), endKeys);
+			__m128i overlapCross = _mm_and_si128(_mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)&minCrossList[i + offset]), maxCrosses), _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)&maxCrossList[i + offset]), minCrosses));
+			int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(inRange, overlapCross)));
+			pair = addPairsSSE2(pair, bodies, _mm_loadu_si128((const __m128i*)&bodyList[i + offset]), mask);
+		}
+		mPairCount = (int)(pair - firstPair);
+
+		//Bodies with a fifth later one in range carry on alone
+		int more = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)&keys[i + 5]), endKeys)));
+		for (int lane = 0; more != 0; ++lane, more >>= 1)
+		{
+			if (more & 1)
+			{
+				scanSSE2(i + lane, i + lane + 5, endKeyList[i + lane], keys[i + lane], minCrossList[i + lane], maxCrossList[i + lane]);
+			}
+		}
+	}
+
+	sweepNextBands([this](int j, int threshold) { return skipSSE2(j, threshold); },
+		[this](int body, int j, int limit, int start, int minCross, int maxCross) { scanSSE2(body, j, limit, start, minCross, maxCross); });
+}
+#endif
+
+void Broadphase::bruteForce(const SDL_Rect* bounds, int count)
+{
+	//Every body against every later one, what game code does without a broadphase
+	for (int i = 0; i < count; ++i)
+	{
+		for (int j = i + 1; j < count; ++j)
+		{
+			if (SDL_HasIntersection(&bounds[i], &bounds[j]))
+			{
+				addPair(i, j);
+			}
+		}
+	}
+}
+
+void Broadphase::update(const SDL_Rect* bounds, int count, BroadphaseMode mode)
+{
+	if (mode == BROADPHASE_BRUTE_FORCE)
+	{
+		mPairs.clear();
+		bruteForce(bounds, count);
+		return;
+	}
+
+	if (count == 0)
+	{
+		mPairs.clear();
+		return;
+	}
+
+	buildKeys(bounds, count);
+	sort(count);
+	gather(bounds, count);
+
+#ifdef BROADPHASE_USE_SSE2
+	if (mode == BROADPHASE_SSE2)
+	{
+		mPairCount = 0;
+		sweepSSE2();
+		orderPairsSSE2();
+		return;
+	}
+#endif
+
+	mPairs.clear();
+	sweepScalar();
+}
+
+bool isBroadphaseModeSupported(int mode)
+{
+	switch (mode)
+	{
+		case BROADPHASE_SCALAR:
+		case BROADPHASE_BRUTE_FORCE:
+		return true;
+
+#ifdef BROADPHASE_USE_SSE2
+		case BROADPHASE_SSE2:
+		return SDL_HasSSE2() == SDL_TRUE;
+#endif
+
+		default:
+		return false;
+	}
+}
+
+void spawnBodies(int count, int worldWidth, int worldHeight)
+{
+	gBounds.resize(count);
+	gVelocities.resize(count);
+	for (int i = 0; i < count; ++i)
+	{
+		SDL_Rect& rect = gBounds[i];
+		rect.w = MIN_BODY_SIZE + rand() % (MAX_BODY_SIZE - MIN_BODY_SIZE + 1);
+		rect.h = rect.w;
+		rect.x = rand() % (worldWidth - rect.w);
+		rect.y = rand() % (worldHeight - rect.h);
+
+		gVelocities[i].x = rand() % 5 - 2;
+		gVelocities[i].y = rand() % 5 - 2;
+	}
+}
+
+void moveBodies(int worldWidth, int worldHeight)
+{
+	int count = (int)gBounds.size();
+	for (int i = 0; i < count; ++i)
+	{
+		SDL_Rect& rect = gBounds[i];
+		SDL_Point& velocity = gVelocities[i];
+
+		rect.x += velocity.x;
+		if (rect.x < 0 || rect.x + rect.w > worldWidth)
+		{
+			velocity.x = -velocity.x;
+			rect.x += 2 * velocity.x;
+		}
+
+		rect.y += velocity.y;
+		if (rect.y < 0 || rect.y + rect.h > worldHeight)
+		{
+			velocity.y = -velocity.y;
+			rect.y += 2 * velocity.y;
+		}
+	}
+}
+
+void getDemoWorldSize(int count, int* worldWidth, int* worldHeight)
+{
+	int width = (int)SDL_sqrt((double)count * DEMO_AREA_PER_BODY * 4.0 / 3.0);
+	*worldWidth = SDL_max(width, SCREEN_WIDTH);
+	*worldHeight = SDL_max(width * 3 / 4, SCREEN_HEIGHT);
+}
+
+//Orders pairs so results from different modes can be compared
+static bool pairLess(const BodyPair& a, const BodyPair& b)
+{
+	return a.first < b.first || (a.first == b.first && a.second < b.second);
+}
+
+int runSelfTest()
+{
+	bool success = true;
+
+	//Small worlds, moving for a while so the insertion sort path gets exercised too
+	for (int run = 0; run < 20 && success; ++run)
+	{
+		int count = 1 + rand() % 3000;
+		spawnBodies(count, 400, 300);
+
+		Broadphase sweeps[BROADPHASE_TOTAL];
+		for (int frame = 0; frame < 10 && success; ++frame)
+		{
+			std::vector<BodyPair> expected;
+			sweeps[BROADPHASE_BRUTE_FORCE].update(&gBounds[0], count, BROADPHASE_BRUTE_FORCE);
+			expected = sweeps[BROADPHASE_BRUTE_FORCE].getPairs();
+			std::sort(expected.begin(), expected.end(), pairLess);
+
+			for (int mode = BROADPHASE_SCALAR; mode < BROADPHASE_BRUTE_FORCE; ++mode)
+			{
+				if (!isBroadphaseModeSupported(mode))
+				{
+					continue;
+				}
+
+				sweeps[mode].update(&gBounds[0], count, (BroadphaseMode)mode);
+				std::vector<BodyPair> actual = sweeps[mode].getPairs();
+				std::sort(actual.begin(), actual.end(), pairLess);
+				if (actual.size() != expected.size() || (!actual.empty() && memcmp(&actual[0], &expected[0], actual.size() * sizeof(BodyPair)) != 0))
+				{
+					printf("%s DIFFERS from brute force: %d bodies, %d pairs instead of %d\n", BROADPHASE_MODE_NAMES[mode], count, (int)actual.size(), (int)expected.size());
+					success = false;
+				}
+			}
+
+			moveBodies(400, 300);
+		}
+	}
+	if (success)
+	{
+		printf("Sweeps match brute force\n");
+	}
+
+	//Time the sweeps on the full body count, the sweep's cost grows with how many bodies share each column
+	double bestAverage = 1e9;
+	for (int density = 0; density < BENCHMARK_DENSITIES; ++density)
+	{
+		int worldSize = (int)SDL_sqrt((double)MAX_BODIES * BENCHMARK_AREA_PER_BODY[density]);
+		printf("%d bodies in %dx%d:\n", MAX_BODIES, worldSize, worldSize);
+
+		for (int mode = BROADPHASE_SCALAR; mode < BROADPHASE_BRUTE_FORCE; ++mode)
+		{
+			if (!isBroadphaseModeSupported(mode))
+			{
+				printf("  %-12s not supported on this CPU, skipped\n", BROADPHASE_MODE_NAMES[mode]);
+				continue;
+			}
+
+			srand(1);
+			spawnBodies(MAX_BODIES, worldSize, worldSize);
+			Broadphase broadphase;
+			broadphase.update(&gBounds[0], MAX_BODIES, (BroadphaseMode)mode);
+
+			Uint64 total = 0;
+			Uint64 worst = 0;
+			int pairs = 0;
+			int moves = 0;
+			for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+			{
+				moveBodies(worldSize, worldSize);
+
+				Uint64 start = SDL_GetPerformanceCounter();
+				broadphase.update(&gBounds[0], MAX_BODIES, (BroadphaseMode)mode);
+				Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+
+				total += elapsed;
+				worst = SDL_max(worst, elapsed);
+				pairs += (int)broadphase.getPairs().size();
+				moves += broadphase.getSortMoves();
+			}
+
+			double frequency = (double)SDL_GetPerformanceFrequency();
+			double average = total * 1000.0 / frequency / BENCHMARK_FRAMES;
+			printf("  %-12s %.3f ms average, %.3f ms worst, %d pairs, %d sort moves per frame\n", BROADPHASE_MODE_NAMES[mode],
+				average, worst * 1000.0 / frequency, pairs / BENCHMARK_FRAMES, moves / BENCHMARK_FRAMES);
+
+			//The budget is for the fastest sweep this CPU has, at the demo's crowding
+			if (density == 0)
+			{
+				bestAverage = SDL_min(bestAverage, average);
+			}
+		}
+	}
+
+	bool withinBudget = bestAverage <= BUDGET_MILLISECONDS;
+	printf("Budget %s: fastest sweep %.3f ms average for %d crowded bodies, budget %.1f ms\n", withinBudget ? "PASS" : "FAIL", bestAverage, MAX_BODIES, BUDGET_MILLISECONDS);
+
+	if (!success)
+	{
+		return 1;
+	}
+	return withinBudget ? 0 : 2;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+			}
+		}
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"selftest" checks the sweeps against brute force and times them on MAX_BODIES, no window needed
+	if (argc >= 2 && strcmp(args[1], "selftest") == 0)
+	{
+		return runSelfTest();
+	}
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Main loop flag
+		bool quit = false;
+
+		//Event handler
+		SDL_Event e;
+
+		//Up/down doubles/halves the bodies, tab cycles the modes
+		BroadphaseMode mode = isBroadphaseModeSupported(BROADPHASE_SSE2) ? BROADPHASE_SSE2 : BROADPHASE_SCALAR;
+
+		//The world grows with the body count so crowding stays the same, and is drawn scaled to fit the window
+		int worldWidth;
+		int worldHeight;
+		getDemoWorldSize(DEFAULT_BODIES, &worldWidth, &worldHeight);
+		spawnBodies(DEFAULT_BODIES, worldWidth, worldHeight);
+
+		//Bodies touching something this frame, and rects to draw them with
+		std::vector<Uint8> touching;
+		std::vector<SDL_Rect> touchingRects;
+		std::vector<SDL_Rect> freeRects;
+
+		//Collision time for the title, averaged over a second
+		Uint32 titleTicks = SDL_GetTicks();
+		Uint64 collisionCounter = 0;
+		int frames = 0;
+
+		//While application is running
+		while (!quit)
+		{
+			//Handle events on queue
+			while (SDL_PollEvent(&e) != 0)
+			{
+				//User requests quit
+				if (e.type == SDL_QUIT)
+				{
+					quit = true;
+				}
+				else if (e.type == SDL_KEYDOWN)
+				{
+					int count = (int)gBounds.size();
+					switch (e.key.keysym.sym)
+					{
+						case SDLK_UP:
+						count = SDL_min(count * 2, MAX_BODIES);
+						getDemoWorldSize(count, &worldWidth, &worldHeight);
+						spawnBodies(count, worldWidth, worldHeight);
+						break;
+
+						case SDLK_DOWN:
+						count = SDL_max(count / 2, 1);
+						getDemoWorldSize(count, &worldWidth, &worldHeight);
+						spawnBodies(count, worldWidth, worldHeight);
+						break;
+
+						case SDLK_TAB:
+						//Brute force is skipped when it would stall the window
+						do
+						{
+							mode = (BroadphaseMode)((mode + 1) % BROADPHASE_TOTAL);
+						} while (!isBroadphaseModeSupported(mode) || (mode == BROADPHASE_BRUTE_FORCE && count > MAX_BRUTE_FORCE_BODIES));
+						break;
+					}
+				}
+			}
+
+			//Move everything, then find who touches whom
+			moveBodies(worldWidth, worldHeight);
+			int count = (int)gBounds.size();
+			if (mode == BROADPHASE_BRUTE_FORCE && count > MAX_BRUTE_FORCE_BODIES)
+			{
+				mode = isBroadphaseModeSupported(BROADPHASE_SSE2) ? BROADPHASE_SSE2 : BROADPHASE_SCALAR;
+			}
+
+			Uint64 collisionStart = SDL_GetPerformanceCounter();
+			gBroadphase.update(&gBounds[0], count, mode);
+			collisionCounter += SDL_GetPerformanceCounter() - collisionStart;
+			++frames;
+
+			//Bodies in a pair are drawn solid, the rest as outlines
+			const std::vector<BodyPair>& pairs = gBroadphase.getPairs();
+			touching.assign(count, 0);
+			for (size_t i = 0; i < pairs.size(); ++i)
+			{
+				touching[pairs[i].first] = 1;
+				touching[pairs[i].second] = 1;
+			}
+			touchingRects.clear();
+			freeRects.clear();
+			for (int i = 0; i < count; ++i)
+			{
+				(touching[i] ? touchingRects : freeRects).push_back(gBounds[i]);
+			}
+
+			//Show the mode, the pair count and what finding them cost
+			Uint32 ticks = SDL_GetTicks();
+			if (ticks - titleTicks >= 1000)
+			{
+				char title[128];
+				SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s: %d bodies, %d pairs, %.3f ms", BROADPHASE_MODE_NAMES[mode], count, (int)pairs.size(), (double)collisionCounter * 1000.0 / SDL_GetPerformanceFrequency() / frames);
+				SDL_SetWindowTitle(gWindow, title);
+				titleTicks = ticks;
+				collisionCounter = 0;
+				frames = 0;
+			}
+
+			//Clear screen
+			SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+			SDL_RenderClear(gRenderer);
+
+			//Fit the whole world in the window
+			SDL_RenderSetScale(gRenderer, (float)SCREEN_WIDTH / worldWidth, (float)SCREEN_HEIGHT / worldHeight);
+
+			//Draw the bodies in two batches
+			SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0xFF, 0xFF);
+			if (!freeRects.empty())
+			{
+				SDL_RenderDrawRects(gRenderer, &freeRects[0], (int)freeRects.size());
+			}
+			SDL_SetRenderDrawColor(gRenderer, 0xFF, 0x00, 0x00, 0xFF);
+			if (!touchingRects.empty())
+			{
+				SDL_RenderFillRects(gRenderer, &touchingRects[0], (int)touchingRects.size());
+			}
+
+			//Update screen
+			SDL_RenderPresent(gRenderer);
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
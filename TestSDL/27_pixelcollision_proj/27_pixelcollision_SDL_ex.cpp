@@ -0,0 +1,766 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, random numbers, strings, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Foo's wandering around the player's one
+const int WANDERER_COUNT = 12;
+
+//Offsets the self test checks and times
+const int SELFTEST_OFFSETS = 200000;
+
+//Which pixels of a texture are solid, one bit each, 64 to a word, rows padded to whole words
+class LCollisionMask
+{
+	public:
+		//Initializes variables
+		LCollisionMask();
+
+		//Builds the mask from a surface, color keyed and fully transparent pixels are empty
+		bool create(SDL_Surface* surface);
+
+		//Deallocates the bits
+		void free();
+
+		//Checks whether this mask at x, y and other at otherX, otherY have a solid pixel in common
+		bool overlaps(int x, int y, const LCollisionMask& other, int otherX, int otherY) const;
+
+		//Same answer one pixel at a time, the reference for overlaps()
+		bool overlapsPerPixel(int x, int y, const LCollisionMask& other, int otherX, int otherY) const;
+
+		//Checks a single pixel, outside the mask is empty
+		bool isSolid(int x, int y) const;
+
+		//Gets mask dimensions
+		int getWidth() const;
+		int getHeight() const;
+
+	private:
+		//Gets 64 bits of a row starting at any bit, bits outside the row read as empty
+		Uint64 getBits(int row, int firstBit) const;
+
+		//Mask bits, row by row
+		std::vector<Uint64> mBits;
+
+		//Mask dimensions
+		int mWidth;
+		int mHeight;
+		int mWordsPerRow;
+};
+
+//Texture wrapper class
+class LTexture {
+	public:
+		//initialize variables through constructor
+		LTexture();
+
+		//Deconstructor
+		~LTexture();
+
+		//Loads image at specified path, optionally keeping a collision mask of its solid pixels
+		bool loadFromFile(std::string path, bool buildMask = false);
+
+		//Deallocates texture
+		void free();
+
+		//Set color modulation
+		void setColor(Uint8 red, Uint8 green, Uint8 blue);
+
+		//Renders texture at given point
+		void render(int x, int y);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+		//Gets the collision mask, empty unless loadFromFile was asked for one
+		const LCollisionMask& getMask();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Solid pixels, kept after the surface is gone
+		LCollisionMask mMask;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//A Foo' drifting around
+struct Wanderer
+{
+	int x;
+	int y;
+	int velX;
+	int velY;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Builds a mask from a width x height surface with about solidPercent of its pixels set at random
+bool createRandomMask(LCollisionMask* mask, int width, int height, int solidPercent);
+
+//Checks the word test against the pixel test at random offsets and times both
+bool runSelfTest();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+
+//Foo's to bump into
+std::vector<Wanderer> gWanderers;
+
+
+LCollisionMask::LCollisionMask()
+{
+	//Initialize
+	mWidth = 0;
+	mHeight = 0;
+	mWordsPerRow = 0;
+}
+
+bool LCollisionMask::create(SDL_Surface* surface)
+{
+	//Get rid of preexisting mask
+	free();
+
+	mWidth = surface->w;
+	mHeight = surface->h;
+	mWordsPerRow = (mWidth + 63) / 64;
+	mBits.assign(mWordsPerRow * mHeight, 0);
+
+	//The key set on the surface, and whether pixels carry alpha of their own
+	Uint32 key = 0;
+	bool keyed = SDL_GetColorKey(surface, &key) == 0;
+	bool hasAlpha = surface->format->Amask != 0 || surface->format->palette != NULL;
+
+	if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0)
+	{
+		printf("Unable to lock surface for collision mask! SDL Error: %s\n", SDL_GetError());
+		free();
+		return false;
+	}
+
+	int bytesPerPixel = surface->format->BytesPerPixel;
+	for (int y = 0; y < mHeight; ++y)
+	{
+		const Uint8* row = (const Uint8*)surface->pixels + y * surface->pitch;
+		Uint64* bits = &mBits[y * mWordsPerRow];
+		for (int x = 0; x < mWidth; ++x)
+		{
+			//Raw pixel value, in the surface's own format
+			const Uint8* p = row + x * bytesPerPixel;
+			Uint32 pixel = 0;
+			switch (bytesPerPixel)
+			{
+				case 1: pixel = p[0]; break;
+				case 2: pixel = *(const Uint16*)p; break;
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+				case 3: pixel = (p[0] << 16) | (p[1] << 8) | p[2]; break;
+#else
+				case 3: pixel = p[0] | (p[1] << 8) | (p[2] << 16); break;
+#endif
+				case 4: pixel = *(const Uint32*)p; break;
+			}
+
+			//Keyed pixels are empty, so are ones with no alpha at all
+			bool solid = !(keyed && pixel == key);
+			if (solid && hasAlpha)
+			{
+				Uint8 r, g, b, a;
+				SDL_GetRGBA(pixel, surface->format, &r, &g, &b, &a);
+				solid = a != 0;
+			}
+
+			if (solid)
+			{
+				bits[x >> 6] |= (Uint64)1 << (x & 63);
+			}
+		}
+	}
+
+	if (SDL_MUSTLOCK(surface))
+	{
+		SDL_UnlockSurface(surface);
+	}
+
+	return true;
+}
+
+void LCollisionMask::free()
+{
+	mBits.clear();
+	mWidth = 0;
+	mHeight = 0;
+	mWordsPerRow = 0;
+}
+
+bool LCollisionMask::isSolid(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= mWidth || y >= mHeight)
+	{
+		return false;
+	}
+	return ((mBits[y * mWordsPerRow + (x >> 6)] >> (x & 63)) & 1) != 0;
+}
+
+Uint64 LCollisionMask::getBits(int row, int firstBit) const
+{
+	//Floor division, so bits left of the row work too
+	int word = firstBit >> 6;
+	int shift = firstBit & 63;
+	const Uint64* bits = &mBits[row * mWordsPerRow];
+
+	Uint64 low = (word >= 0 && word < mWordsPerRow) ? bits[word] : 0;
+	if (shift == 0)
+	{
+		return low;
+	}
+
+	Uint64 high = (word + 1 >= 0 && word + 1 < mWordsPerRow) ? bits[word + 1] : 0;
+	return (low >> shift) | (high << (64 - shift));
+}
+
+bool LCollisionMask::overlaps(int x, int y, const LCollisionMask& other, int otherX, int otherY) const
+{
+	//Other mask's position in this mask's pixels
+	int offsetX = otherX - x;
+	int offsetY = otherY - y;
+
+	//Rows and words both masks cover, nothing to do if the boxes don't touch
+	int firstRow = SDL_max(0, offsetY);
+	int lastRow = SDL_min(mHeight, offsetY + other.mHeight) - 1;
+	int firstColumn = SDL_max(0, offsetX);
+	int lastColumn = SDL_min(mWidth, offsetX + other.mWidth) - 1;
+	if (firstRow > lastRow || firstColumn > lastColumn)
+	{
+		return false;
+	}
+
+	//Each of our words against the other row's bits shifted into line, padding bits are empty on both sides
+	int firstWord = firstColumn >> 6;
+	int lastWord = lastColumn >> 6;
+	for (int row = firstRow; row <= lastRow; ++row)
+	{
+		const Uint64* bits = &mBits[row * mWordsPerRow];
+		int otherRow = row - offsetY;
+		for (int word = firstWord; word <= lastWord; ++word)
+		{
+			if (bits[word] & other.getBits(otherRow, word * 64 - offsetX))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool LCollisionMask::overlapsPerPixel(int x, int y, const LCollisionMask& other, int otherX, int otherY) const
+{
+	int offsetX = otherX - x;
+	int offsetY = otherY - y;
+	int firstRow = SDL_max(0, offsetY);
+	int lastRow = SDL_min(mHeight, offsetY + other.mHeight) - 1;
+	int firstColumn = SDL_max(0, offsetX);
+	int lastColumn = SDL_min(mWidth, offsetX + other.mWidth) - 1;
+
+	for (int row = firstRow; row <= lastRow; ++row)
+	{
+		for (int column = firstColumn; column <= lastColumn; ++column)
+		{
+			if (isSolid(column, row) && other.isSolid(column - offsetX, row - offsetY))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+int LCollisionMask::getWidth() const
+{
+	return mWidth;
+}
+
+int LCollisionMask::getHeight() const
+{
+	return mHeight;
+}
+
+
+// implementation of LTexture class
+LTexture::LTexture() {
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture() {
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path, bool buildMask) {
+	//Get rid of preexisting texture
+	free();
+
+	// The final texture
+	SDL_Texture* newTexture = NULL;
+
+	// Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL_Image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else {
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Keep which pixels the key left solid before the surface goes away
+		if (buildMask && !mMask.create(loadedSurface)) {
+			printf("Unable to build collision mask for %s!\n", path.c_str());
+		}
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL) {
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+			mMask.free();
+		}
+		else {
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	// Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free() {
+	// Free texture if it exists
+	if (mTexture != NULL) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+	mMask.free();
+}
+
+void LTexture::setColor(Uint8 red, Uint8 green, Uint8 blue)
+{
+	//Modulate texture
+	SDL_SetTextureColorMod(mTexture, red, green, blue);
+}
+
+void LTexture::render(int x, int y) {
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+const LCollisionMask& LTexture::getMask()
+{
+	return mMask;
+}
+
+bool createRandomMask(LCollisionMask* mask, int width, int height, int solidPercent)
+{
+	int bpp;
+	Uint32 rmask, gmask, bmask, amask;
+	SDL_PixelFormatEnumToMasks(SDL_PIXELFORMAT_ARGB8888, &bpp, &rmask, &gmask, &bmask, &amask);
+	SDL_Surface* surface = SDL_CreateRGBSurface(0, width, height, bpp, rmask, gmask, bmask, amask);
+	if (surface == NULL)
+	{
+		printf("Unable to create mask surface! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	//Transparent pixels are empty, everything else is solid
+	for (int y = 0; y < height; ++y)
+	{
+		Uint32* row = (Uint32*)((Uint8*)surface->pixels + y * surface->pitch);
+		for (int x = 0; x < width; ++x)
+		{
+			row[x] = rand() % 100 < solidPercent ? 0xFF000000 : 0x00000000;
+		}
+	}
+
+	bool success = mask->create(surface);
+	SDL_FreeSurface(surface);
+	return success;
+}
+
+bool runSelfTest()
+{
+	//Masks straight from the image, no renderer needed
+	SDL_Surface* surface = IMG_Load("Images/foo.png");
+	if (surface == NULL)
+	{
+		printf("Unable to load Images/foo.png! SDL_image Error: %s\n", IMG_GetError());
+		return false;
+	}
+	SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 0, 0xFF, 0xFF));
+
+	LCollisionMask mask;
+	bool success = mask.create(surface);
+	SDL_FreeSurface(surface);
+	if (!success)
+	{
+		return false;
+	}
+
+	int solid = 0;
+	for (int y = 0; y < mask.getHeight(); ++y)
+	{
+		for (int x = 0; x < mask.getWidth(); ++x)
+		{
+			solid += mask.isSolid(x, y) ? 1 : 0;
+		}
+	}
+	printf("Foo' mask is %dx%d with %d solid pixels\n", mask.getWidth(), mask.getHeight(), solid);
+
+	//Offsets around the bounding box overlap, where near misses happen
+	std::vector<SDL_Point> offsets(SELFTEST_OFFSETS);
+	for (int i = 0; i < SELFTEST_OFFSETS; ++i)
+	{
+		offsets[i].x = rand() % (mask.getWidth() * 2 + 1) - mask.getWidth();
+		offsets[i].y = rand() % (mask.getHeight() * 2 + 1) - mask.getHeight();
+	}
+
+	int mismatches = 0;
+	int hits = 0;
+	for (int i = 0; i < SELFTEST_OFFSETS; ++i)
+	{
+		bool words = mask.overlaps(0, 0, mask, offsets[i].x, offsets[i].y);
+		bool pixels = mask.overlapsPerPixel(0, 0, mask, offsets[i].x, offsets[i].y);
+		mismatches += words != pixels ? 1 : 0;
+		hits += words ? 1 : 0;
+	}
+	printf("Word test %s per pixel test (%d mismatches, %d of %d offsets collide)\n", mismatches == 0 ? "matches" : "DIFFERS from", mismatches, hits, SELFTEST_OFFSETS);
+
+	//Foo' rows fit in one word, so also try masks with several words per row and different widths.
+	//Sparse pixels make a shift or an off by one show up as a wrong answer instead of hiding in solid areas.
+	const SDL_Point MASK_SIZES[][2] = { { { 100, 40 }, { 130, 70 } }, { { 129, 33 }, { 65, 90 } }, { { 200, 16 }, { 191, 24 } } };
+	int wideMismatches = 0;
+	int wideHits = 0;
+	int wideTests = 0;
+	for (size_t pair = 0; pair < SDL_arraysize(MASK_SIZES); ++pair)
+	{
+		for (int density = 1; density <= 8; density *= 2)
+		{
+			LCollisionMask first;
+			LCollisionMask second;
+			if (!createRandomMask(&first, MASK_SIZES[pair][0].x, MASK_SIZES[pair][0].y, density) ||
+				!createRandomMask(&second, MASK_SIZES[pair][1].x, MASK_SIZES[pair][1].y, density))
+			{
+				return false;
+			}
+
+			//Every offset where the boxes touch is fair game, negative ones and ones that aren't multiples of 64 included
+			for (int i = 0; i < SELFTEST_OFFSETS / 20; ++i)
+			{
+				int x = rand() % (first.getWidth() + second.getWidth() + 1) - second.getWidth();
+				int y = rand() % (first.getHeight() + second.getHeight() + 1) - second.getHeight();
+
+				bool words = first.overlaps(0, 0, second, x, y);
+				bool pixels = first.overlapsPerPixel(0, 0, second, x, y);
+				bool wordsSwapped = second.overlaps(x, y, first, 0, 0);
+				bool pixelsSwapped = second.overlapsPerPixel(x, y, first, 0, 0);
+				wideMismatches += (words != pixels ? 1 : 0) + (wordsSwapped != pixelsSwapped ? 1 : 0);
+				wideHits += words ? 1 : 0;
+				wideTests += 2;
+			}
+		}
+	}
+	printf("Multi word masks: word test %s per pixel test (%d mismatches, %d of %d tests collide)\n", wideMismatches == 0 ? "matches" : "DIFFERS from", wideMismatches, wideHits * 2, wideTests);
+	mismatches += wideMismatches;
+
+	//Time both on the same offsets
+	Uint64 start = SDL_GetPerformanceCounter();
+	for (int i = 0; i < SELFTEST_OFFSETS; ++i)
+	{
+		hits += mask.overlaps(0, 0, mask, offsets[i].x, offsets[i].y) ? 1 : 0;
+	}
+	Uint64 middle = SDL_GetPerformanceCounter();
+	for (int i = 0; i < SELFTEST_OFFSETS; ++i)
+	{
+		hits += mask.overlapsPerPixel(0, 0, mask, offsets[i].x, offsets[i].y) ? 1 : 0;
+	}
+	Uint64 end = SDL_GetPerformanceCounter();
+
+	double frequency = (double)SDL_GetPerformanceFrequency();
+	printf("Word test %.1f ns, per pixel test %.1f ns per pair\n", (middle - start) * 1e9 / frequency / SELFTEST_OFFSETS, (end - middle) * 1e9 / frequency / SELFTEST_OFFSETS);
+
+	return mismatches == 0;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' texture, with the mask the collisions need
+	if (!gFooTexture.loadFromFile("Images/foo.png", true))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Load background texture
+	if (!gBackgroundTexture.loadFromFile("Images/background.png"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images
+	gFooTexture.free();
+	gBackgroundTexture.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//PNG loading is needed by the self test as well
+	int imgFlags = IMG_INIT_PNG;
+	if (!(IMG_Init(imgFlags) & imgFlags))
+	{
+		printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+		return 1;
+	}
+
+	//"selftest" checks the word test against the pixel test and times them, no window needed
+	if (argc >= 2 && strcmp(args[1], "selftest") == 0)
+	{
+		bool passed = runSelfTest();
+		IMG_Quit();
+		return passed ? 0 : 1;
+	}
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//The player's Foo' follows the mouse, the others drift and bounce
+			int playerX = 240;
+			int playerY = 190;
+			for (int i = 0; i < WANDERER_COUNT; ++i)
+			{
+				Wanderer wanderer;
+				wanderer.x = rand() % (SCREEN_WIDTH - gFooTexture.getWidth());
+				wanderer.y = rand() % (SCREEN_HEIGHT - gFooTexture.getHeight());
+				wanderer.velX = rand() % 2 == 0 ? 1 : -1;
+				wanderer.velY = rand() % 2 == 0 ? 1 : -1;
+				gWanderers.push_back(wanderer);
+			}
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_MOUSEMOTION)
+					{
+						//Centered on the mouse
+						playerX = e.motion.x - gFooTexture.getWidth() / 2;
+						playerY = e.motion.y - gFooTexture.getHeight() / 2;
+					}
+				}
+
+				//Move the wanderers
+				for (size_t i = 0; i < gWanderers.size(); ++i)
+				{
+					Wanderer& wanderer = gWanderers[i];
+					wanderer.x += wanderer.velX;
+					wanderer.y += wanderer.velY;
+					if (wanderer.x < 0 || wanderer.x > SCREEN_WIDTH - gFooTexture.getWidth())
+					{
+						wanderer.velX = -wanderer.velX;
+					}
+					if (wanderer.y < 0 || wanderer.y > SCREEN_HEIGHT - gFooTexture.getHeight())
+					{
+						wanderer.velY = -wanderer.velY;
+					}
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render background texture to screen
+				gBackgroundTexture.render(0, 0);
+
+				//Wanderers the player's boxes touch turn yellow, ones it really touches turn red
+				const LCollisionMask& mask = gFooTexture.getMask();
+				SDL_Rect player = { playerX, playerY, gFooTexture.getWidth(), gFooTexture.getHeight() };
+				bool playerHit = false;
+				for (size_t i = 0; i < gWanderers.size(); ++i)
+				{
+					const Wanderer& wanderer = gWanderers[i];
+					SDL_Rect box = { wanderer.x, wanderer.y, gFooTexture.getWidth(), gFooTexture.getHeight() };
+					if (mask.overlaps(playerX, playerY, mask, wanderer.x, wanderer.y))
+					{
+						gFooTexture.setColor(0xFF, 0x40, 0x40);
+						playerHit = true;
+					}
+					else if (SDL_HasIntersection(&player, &box))
+					{
+						gFooTexture.setColor(0xFF, 0xFF, 0x40);
+					}
+					else
+					{
+						gFooTexture.setColor(0xFF, 0xFF, 0xFF);
+					}
+					gFooTexture.render(wanderer.x, wanderer.y);
+				}
+
+				//The player's Foo' goes red too when it's touching anyone
+				if (playerHit)
+				{
+					gFooTexture.setColor(0xFF, 0x40, 0x40);
+				}
+				else
+				{
+					gFooTexture.setColor(0xFF, 0xFF, 0xFF);
+				}
+				gFooTexture.render(playerX, playerY);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,1193 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, standard IO, math, strings, and vectors
+#include <SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+//SSE2 is always there on x64 and on x86 builds compiled with /arch:SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_USE_SSE2 1
+#endif
+
+//AVX kernels are compiled for any x86 target and only called when the CPU has it.
+//MSVC allows the intrinsics anywhere, GCC and Clang need them marked per function.
+#if defined(PARTICLE_USE_SSE2) && defined(_MSC_VER)
+#include <immintrin.h>
+#define PARTICLE_USE_AVX 1
+#define PARTICLE_TARGET_AVX
+#elif defined(PARTICLE_USE_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define PARTICLE_USE_AVX 1
+#define PARTICLE_TARGET_AVX __attribute__((target("avx")))
+#endif
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Particles shared by all emitters, up/down doubles/halves it between these
+const int DEFAULT_PARTICLES = 65536;
+const int MIN_PARTICLES = 1024;
+const int MAX_PARTICLES = 1 << 20;
+
+//Side of the triangle each particle is drawn as
+const float PARTICLE_SIZE = 2.0f;
+
+//Frames the self test compares the kernels over, and frames it times them over
+const int SELFTEST_COMPARE_FRAMES = 240;
+const int SELFTEST_BENCHMARK_FRAMES = 120;
+
+//Frames the benchmark draws per kernel, and what update, build, draw and present of MAX_PARTICLES may cost per frame.
+//One frame at 60 Hz, the benchmark reports against it with the widest kernel the CPU has.
+const int BENCHMARK_FRAMES = 120;
+const double BUDGET_MILLISECONDS = 16.6;
+
+//Widest kernel, in particles per step
+const int PARTICLE_MAX_LANES = 8;
+
+//Per particle values, each one its own array
+enum ParticleField
+{
+	FIELD_X,
+	FIELD_Y,
+	FIELD_VEL_X,
+	FIELD_VEL_Y,
+	FIELD_RED,
+	FIELD_GREEN,
+	FIELD_BLUE,
+	FIELD_ALPHA,
+	FIELD_LIFE,
+	PARTICLE_FIELDS
+};
+
+//Update and geometry kernel implementations, in the order they are tried
+enum ParticleKernel
+{
+	PARTICLE_SCALAR,
+	PARTICLE_SSE2,
+	PARTICLE_AVX,
+	PARTICLE_TOTAL
+};
+
+//Names used in the title and the self test
+const char* PARTICLE_KERNEL_NAMES[PARTICLE_TOTAL] = { "scalar", "SSE2", "AVX" };
+
+//How an emitter sprays its particles
+struct EmitterSettings
+{
+	//Where they come from
+	float x;
+	float y;
+
+	//Direction and half the cone they're thrown in, in radians
+	float angle;
+	float spread;
+
+	//Fastest launch speed in pixels per second
+	float speed;
+
+	//Longest life in seconds, particles live between half this and all of it
+	float lifetime;
+
+	//Downward pull in pixels per second squared
+	float gravity;
+
+	//Color at birth and the color they would fade to at the longest life
+	SDL_Color startColor;
+	SDL_Color endColor;
+};
+
+//Particles of one emitter as parallel float arrays, updated in place and drawn in one go
+class ParticleEmitter
+{
+	public:
+		//Initializes variables
+		ParticleEmitter();
+
+		//Sets how the emitter sprays and how many particles it can have alive
+		void create(const EmitterSettings& settings, int capacity, Uint32 seed);
+
+		//Changes how many particles can be alive, extra ones are dropped
+		void setCapacity(int capacity);
+
+		//Moves where new particles come from
+		void setPosition(float x, float y);
+
+		//Spawns the particles due over the elapsed time, as long as there is room
+		void emit(float seconds);
+
+		//Integrates everything over the elapsed time and squeezes out the dead
+		void update(float seconds, ParticleKernel kernel);
+
+		//Turns the living particles into triangles, with the same kernel choice as update
+		void buildGeometry(ParticleKernel kernel);
+
+		//Draws the triangles in one call, or particle by particle when geometry is off or missing. Returns draw calls.
+		int render(bool geometry);
+
+		//Gets particle counts
+		int getCount();
+		int getCapacity();
+
+		//Gets one particle value, for the self test
+		float getField(int field, int index);
+
+		//Checks the triangles match another emitter's, for the self test
+		bool hasSameGeometry(const ParticleEmitter& other);
+
+	private:
+		//Kernels, each returns how many particles are still alive
+		int updateRange(int first, int write, float seconds);
+#ifdef PARTICLE_USE_SSE2
+		int updateSSE2(float seconds);
+#endif
+#ifdef PARTICLE_USE_AVX
+		PARTICLE_TARGET_AVX int updateAVX(float seconds);
+#endif
+
+		//Geometry builders, each fills from the first particle to the end
+		void buildGeometryRange(int first);
+#ifdef PARTICLE_USE_SSE2
+		void buildGeometrySSE2();
+#endif
+#ifdef PARTICLE_USE_AVX
+		PARTICLE_TARGET_AVX void buildGeometryAVX();
+#endif
+
+		//Moves the living lanes of a block to the write position, returns the new write position
+		int keepLanes(int write, int alive, int width, float lanes[][PARTICLE_MAX_LANES], const SDL_Color* laneColors);
+
+		//Cheap random numbers in [0, 1)
+		float random();
+
+		//Particle values, and their colors packed for drawing
+		std::vector<float> mFields[PARTICLE_FIELDS];
+		std::vector<SDL_Color> mColors;
+
+		//Triangles from the last buildGeometry
+		std::vector<float> mVertexPositions;
+		std::vector<SDL_Color> mVertexColors;
+
+		//How new particles are sprayed and how their color moves per second
+		EmitterSettings mSettings;
+		float mColorSteps[4];
+
+		//Particles per second, and the fraction of one still owed
+		float mRate;
+		float mEmitDebt;
+
+		//Living particles and room for them
+		int mCount;
+		int mCapacity;
+
+		//Random state
+		Uint32 mRandom;
+};
+
+//Starts up SDL and creates window, hidden and without vsync for the benchmark
+bool init(bool hidden);
+
+//Frees media and shuts down SDL
+void close();
+
+//Checks the kernels agree, then times them on MAX_PARTICLES
+bool runSelfTest();
+
+//Times whole frames of MAX_PARTICLES against the budget, returns the exit code
+int runBenchmark();
+
+//Checks whether a kernel was compiled in and the CPU can run it
+bool isParticleKernelSupported(int kernel);
+
+//Gets the seconds between two performance counter values
+double getSeconds(Uint64 start, Uint64 end);
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Fountains for the demo, the first one follows the mouse
+const int TOTAL_EMITTERS = 4;
+const EmitterSettings EMITTER_SETTINGS[TOTAL_EMITTERS] =
+{
+	{ 320.0f, 400.0f, -1.5708f, 0.35f, 380.0f, 2.0f, 300.0f, { 0xFF, 0xC0, 0x40, 0xFF }, { 0xFF, 0x20, 0x00, 0x00 } },
+	{ 100.0f, 470.0f, -1.2000f, 0.15f, 450.0f, 2.5f, 250.0f, { 0x40, 0x80, 0xFF, 0xFF }, { 0x00, 0x00, 0x80, 0x00 } },
+	{ 540.0f, 470.0f, -1.9416f, 0.15f, 450.0f, 2.5f, 250.0f, { 0x40, 0xFF, 0x80, 0xFF }, { 0x00, 0x80, 0x00, 0x00 } },
+	{ 320.0f, 60.0f, 1.5708f, 3.1416f, 120.0f, 1.5f, 60.0f, { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFF, 0x00, 0xFF, 0x00 } }
+};
+ParticleEmitter gEmitters[TOTAL_EMITTERS];
+
+
+ParticleEmitter::ParticleEmitter()
+{
+	//Initialize
+	memset(&mSettings, 0, sizeof(mSettings));
+	for (int i = 0; i < 4; ++i)
+	{
+		mColorSteps[i] = 0.0f;
+	}
+	mRate = 0.0f;
+	mEmitDebt = 0.0f;
+	mCount = 0;
+	mCapacity = 0;
+	mRandom = 1;
+}
+
+void ParticleEmitter::create(const EmitterSettings& settings, int capacity, Uint32 seed)
+{
+	mSettings = settings;
+	mRandom = seed != 0 ? seed : 1;
+	mEmitDebt = 0.0f;
+	mCount = 0;
+
+	//Colors move linearly from start to end over the longest life
+	const Uint8* start = &settings.startColor.r;
+	const Uint8* end = &settings.endColor.r;
+	for (int i = 0; i < 4; ++i)
+	{
+		mColorSteps[i] = (end[i] - start[i]) / 255.0f / settings.lifetime;
+	}
+
+	setCapacity(capacity);
+}
+
+void ParticleEmitter::setCapacity(int capacity)
+{
+	mCapacity = capacity;
+	mCount = SDL_min(mCount, capacity);
+	for (int field = 0; field < PARTICLE_FIELDS; ++field)
+	{
+		mFields[field].resize(capacity);
+	}
+	mColors.resize(capacity);
+
+	//Particles live three quarters of the longest life on average, spawn just fast enough to stay full
+	mRate = capacity / (0.75f * mSettings.lifetime);
+}
+
+void ParticleEmitter::setPosition(float x, float y)
+{
+	mSettings.x = x;
+	mSettings.y = y;
+}
+
+void ParticleEmitter::emit(float seconds)
+{
+	mEmitDebt += mRate * seconds;
+	int spawn = (int)mEmitDebt;
+	mEmitDebt -= spawn;
+	spawn = SDL_min(spawn, mCapacity - mCount);
+
+	for (int i = 0; i < spawn; ++i)
+	{
+		float angle = mSettings.angle + mSettings.spread * (random() * 2.0f - 1.0f);
+		float speed = mSettings.speed * (0.5f + 0.5f * random());
+
+		int index = mCount++;
+		mFields[FIELD_X][index] = mSettings.x;
+		mFields[FIELD_Y][index] = mSettings.y;
+		mFields[FIELD_VEL_X][index] = cosf(angle) * speed;
+		mFields[FIELD_VEL_Y][index] = sinf(angle) * speed;
+		mFields[FIELD_RED][index] = mSettings.startColor.r / 255.0f;
+		mFields[FIELD_GREEN][index] = mSettings.startColor.g / 255.0f;
+		mFields[FIELD_BLUE][index] = mSettings.startColor.b / 255.0f;
+		mFields[FIELD_ALPHA][index] = mSettings.startColor.a / 255.0f;
+		mFields[FIELD_LIFE][index] = mSettings.lifetime * (0.5f + 0.5f * random());
+		mColors[index] = mSettings.startColor;
+	}
+}
+
+void ParticleEmitter::update(float seconds, ParticleKernel kernel)
+{
+#ifdef PARTICLE_USE_AVX
+	if (kernel == PARTICLE_AVX)
+	{
+		mCount = updateAVX(seconds);
+		return;
+	}
+#endif
+
+#ifdef PARTICLE_USE_SSE2
+	if (kernel == PARTICLE_SSE2)
+	{
+		mCount = updateSSE2(seconds);
+		return;
+	}
+#endif
+
+	mCount = updateRange(0, 0, seconds);
+}
+
+int ParticleEmitter::updateRange(int first, int write, float seconds)
+{
+	float* fields[PARTICLE_FIELDS];
+	for (int field = 0; field < PARTICLE_FIELDS; ++field)
+	{
+		fields[field] = mFields[field].empty() ? NULL : &mFields[field][0];
+	}
+	float gravity = mSettings.gravity * seconds;
+	float steps[4];
+	for (int channel = 0; channel < 4; ++channel)
+	{
+		steps[channel] = mColorSteps[channel] * seconds;
+	}
+
+	//Same operations in the same order as the vector kernels, so they all agree
+	for (int i = first; i < mCount; ++i)
+	{
+		float life = fields[FIELD_LIFE][i] - seconds;
+		if (!(life > 0.0f))
+		{
+			continue;
+		}
+
+		float velX = fields[FIELD_VEL_X][i];
+		float velY = fields[FIELD_VEL_Y][i] + gravity;
+		fields[FIELD_X][write] = fields[FIELD_X][i] + velX * seconds;
+		fields[FIELD_Y][write] = fields[FIELD_Y][i] + velY * seconds;
+		fields[FIELD_VEL_X][write] = velX;
+		fields[FIELD_VEL_Y][write] = velY;
+		fields[FIELD_LIFE][write] = life;
+
+		Uint8 bytes[4];
+		for (int channel = 0; channel < 4; ++channel)
+		{
+			float value = SDL_min(SDL_max(fields[FIELD_RED + channel][i] + steps[channel], 0.0f), 1.0f);
+			fields[FIELD_RED + channel][write] = value;
+			bytes[channel] = (Uint8)(value * 255.0f);
+		}
+		SDL_Color color = { bytes[0], bytes[1], bytes[2], bytes[3] };
+		mColors[write] = color;
+
+		++write;
+	}
+
+	return write;
+}
+
+int ParticleEmitter::keepLanes(int write, int alive, int width, float lanes[][PARTICLE_MAX_LANES], const SDL_Color* laneColors)
+{
+	for (int lane = 0; lane < width; ++lane)
+	{
+		if (alive & (1 << lane))
+		{
+			for (int field = 0; field < PARTICLE_FIELDS; ++field)
+			{
+				mFields[field][write] = lanes[field][lane];
+			}
+			mColors[write] = laneColors[lane];
+			++write;
+		}
+	}
+	return write;
+}
+
+#ifdef PARTICLE_USE_SSE2
+//Packs four channels of 0-255 ints into SDL_Color byte order
+static inline __m128i packColorsSSE2(__m128i red, __m128i green, __m128i blue, __m128i alpha)
+{
+	return _mm_or_si128(_mm_or_si128(red, _mm_slli_epi32(green, 8)), _mm_or_si128(_mm_slli_epi32(blue, 16), _mm_slli_epi32(alpha, 24)));
+}
+
+int ParticleEmitter::updateSSE2(float seconds)
+{
+	float* fields[PARTICLE_FIELDS];
+	for (int field = 0; field < PARTICLE_FIELDS; ++field)
+	{
+		fields[field] = mFields[field].empty() ? NULL : &mFields[field][0];
+	}
+	__m128 dt = _mm_set1_ps(seconds);
+	__m128 gravity = _mm_set1_ps(mSettings.gravity * seconds);
+	__m128 steps[4];
+	for (int channel = 0; channel < 4; ++channel)
+	{
+		steps[channel] = _mm_set1_ps(mColorSteps[channel] * seconds);
+	}
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 scale = _mm_set1_ps(255.0f);
+
+	//Dead lanes are squeezed out as we go: the write position never passes the read position
+	int write = 0;
+	int blocks = mCount & ~3;
+	for (int i = 0; i < blocks; i += 4)
+	{
+		__m128 life = _mm_sub_ps(_mm_loadu_ps(fields[FIELD_LIFE] + i), dt);
+		int alive = _mm_movemask_ps(_mm_cmpgt_ps(life, zero));
+		if (alive == 0)
+		{
+			continue;
+		}
+
+		__m128 values[PARTICLE_FIELDS];
+		values[FIELD_VEL_X] = _mm_loadu_ps(fields[FIELD_VEL_X] + i);
+		values[FIELD_VEL_Y] = _mm_add_ps(_mm_loadu_ps(fields[FIELD_VEL_Y] + i), gravity);
+		values[FIELD_X] = _mm_add_ps(_mm_loadu_ps(fields[FIELD_X] + i), _mm_mul_ps(values[FIELD_VEL_X], dt));
+		values[FIELD_Y] = _mm_add_ps(_mm_loadu_ps(fields[FIELD_Y] + i), _mm_mul_ps(values[FIELD_VEL_Y], dt));
+		values[FIELD_LIFE] = life;
+		__m128i bytes[4];
+		for (int channel = 0; channel < 4; ++channel)
+		{
+			__m128 value = _mm_add_ps(_mm_loadu_ps(fields[FIELD_RED + channel] + i), steps[channel]);
+			value = _mm_min_ps(_mm_max_ps(value, zero), one);
+			values[FIELD_RED + channel] = value;
+			bytes[channel] = _mm_cvttps_epi32(_mm_mul_ps(value, scale));
+		}
+		__m128i colors = packColorsSSE2(bytes[0], bytes[1], bytes[2], bytes[3]);
+
+		if (alive == 0xF)
+		{
+			for (int field = 0; field < PARTICLE_FIELDS; ++field)
+			{
+				_mm_storeu_ps(fields[field] + write, values[field]);
+			}
+			_mm_storeu_si128((__m128i*)&mColors[write], colors);
+			write += 4;
+		}
+		else
+		{
+			float lanes[PARTICLE_FIELDS][PARTICLE_MAX_LANES];
+			SDL_Color laneColors[4];
+			for (int field = 0; field < PARTICLE_FIELDS; ++field)
+			{
+				_mm_storeu_ps(lanes[field], values[field]);
+			}
+			_mm_storeu_si128((__m128i*)laneColors, colors);
+			write = keepLanes(write, alive, 4, lanes, laneColors);
+		}
+	}
+
+	//Leftovers one at a time
+	return updateRange(blocks, write, seconds);
+}
+#endif
+
+#ifdef PARTICLE_USE_AVX
+PARTICLE_TARGET_AVX
+int ParticleEmitter::updateAVX(float seconds)
+{
+	float* fields[PARTICLE_FIELDS];
+	for (int field = 0; field < PARTICLE_FIELDS; ++field)
+	{
+		fields[field] = mFields[field].empty() ? NULL : &mFields[field][0];
+	}
+	__m256 dt = _mm256_set1_ps(seconds);
+	__m256 gravity = _mm256_set1_ps(mSettings.gravity * seconds);
+	__m256 steps[4];
+	for (int channel = 0; channel < 4; ++channel)
+	{
+		steps[channel] = _mm256_set1_ps(mColorSteps[channel] * seconds);
+	}
+	__m256 zero = _mm256_setzero_ps();
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 scale = _mm256_set1_ps(255.0f);
+
+	//Same as the SSE2 kernel, eight at a time. AVX has no 256 bit integer shifts so colors are packed in halves.
+	int write = 0;
+	int blocks = mCount & ~7;
+	for (int i = 0; i < blocks; i += 8)
+	{
+		__m256 life = _mm256_sub_ps(_mm256_loadu_ps(fields[FIELD_LIFE] + i), dt);
+		int alive = _mm256_movemask_ps(_mm256_cmp_ps(life, zero, _CMP_GT_OQ));
+		if (alive == 0)
+		{
+			continue;
+		}
+
+		__m256 values[PARTICLE_FIELDS];
+		values[FIELD_VEL_X] = _mm256_loadu_ps(fields[FIELD_VEL_X] + i);
+		values[FIELD_VEL_Y] = _mm256_add_ps(_mm256_loadu_ps(fields[FIELD_VEL_Y] + i), gravity);
+		values[FIELD_X] = _mm256_add_ps(_mm256_loadu_ps(fields[FIELD_X] + i), _mm256_mul_ps(values[FIELD_VEL_X], dt));
+		values[FIELD_Y] = _mm256_add_ps(_mm256_loadu_ps(fields[FIELD_Y] + i), _mm256_mul_ps(values[FIELD_VEL_Y], dt));
+		values[FIELD_LIFE] = life;
+		__m256i bytes[4];
+		for (int channel = 0; channel < 4; ++channel)
+		{
+			__m256 value = _mm256_add_ps(_mm256_loadu_ps(fields[FIELD_RED + channel] + i), steps[channel]);
+			value = _mm256_min_ps(_mm256_max_ps(value, zero), one);
+			values[FIELD_RED + channel] = value;
+			bytes[channel] = _mm256_cvttps_epi32(_mm256_mul_ps(value, scale));
+		}
+		__m128i lowColors = packColorsSSE2(_mm256_castsi256_si128(bytes[0]), _mm256_castsi256_si128(bytes[1]), _mm256_castsi256_si128(bytes[2]), _mm256_castsi256_si128(bytes[3]));
+		__m128i highColors = packColorsSSE2(_mm256_extractf128_si256(bytes[0], 1), _mm256_extractf128_si256(bytes[1], 1), _mm256_extractf128_si256(bytes[2], 1), _mm256_extractf128_si256(bytes[3], 1));
+
+		if (alive == 0xFF)
+		{
+			for (int field = 0; field < PARTICLE_FIELDS; ++field)
+			{
+				_mm256_storeu_ps(fields[field] + write, values[field]);
+			}
+			_mm_storeu_si128((__m128i*)&mColors[write], lowColors);
+			_mm_storeu_si128((__m128i*)&mColors[write + 4], highColors);
+			write += 8;
+		}
+		else
+		{
+			float lanes[PARTICLE_FIELDS][PARTICLE_MAX_LANES];
+			SDL_Color laneColors[8];
+			for (int field = 0; field < PARTICLE_FIELDS; ++field)
+			{
+				_mm256_storeu_ps(lanes[field], values[field]);
+			}
+			_mm_storeu_si128((__m128i*)laneColors, lowColors);
+			_mm_storeu_si128((__m128i*)(laneColors + 4), highColors);
+			write = keepLanes(write, alive, 8, lanes, laneColors);
+		}
+	}
+
+	//Leftovers one at a time
+	_mm256_zeroupper();
+	return updateRange(blocks, write, seconds);
+}
+#endif
+
+void ParticleEmitter::buildGeometry(ParticleKernel kernel)
+{
+	mVertexPositions.resize(mCount * 6);
+	mVertexColors.resize(mCount * 3);
+	if (mCount == 0)
+	{
+		return;
+	}
+
+#ifdef PARTICLE_USE_AVX
+	if (kernel == PARTICLE_AVX)
+	{
+		buildGeometryAVX();
+		return;
+	}
+#endif
+
+#ifdef PARTICLE_USE_SSE2
+	if (kernel == PARTICLE_SSE2)
+	{
+		buildGeometrySSE2();
+		return;
+	}
+#endif
+
+	buildGeometryRange(0);
+}
+
+void ParticleEmitter::buildGeometryRange(int first)
+{
+	//A small right triangle per particle, all three corners in the particle's color
+	const float* x = &mFields[FIELD_X][0];
+	const float* y = &mFields[FIELD_Y][0];
+	float* position = &mVertexPositions[first * 6];
+	SDL_Color* color = &mVertexColors[first * 3];
+	for (int i = first; i < mCount; ++i)
+	{
+		position[0] = x[i];
+		position[1] = y[i];
+		position[2] = x[i] + PARTICLE_SIZE;
+		position[3] = y[i];
+		position[4] = x[i];
+		position[5] = y[i] + PARTICLE_SIZE;
+		position += 6;
+
+		color[0] = color[1] = color[2] = mColors[i];
+		color += 3;
+	}
+}
+
+#ifdef PARTICLE_USE_SSE2
+void ParticleEmitter::buildGeometrySSE2()
+{
+	const float* x = &mFields[FIELD_X][0];
+	const float* y = &mFields[FIELD_Y][0];
+	float* position = &mVertexPositions[0];
+	SDL_Color* color = &mVertexColors[0];
+	const __m128 size = _mm_set1_ps(PARTICLE_SIZE);
+
+	//Four particles a step, 24 floats and 12 colors out
+	int blocks = mCount & ~3;
+	for (int i = 0; i < blocks; i += 4)
+	{
+		__m128 left = _mm_loadu_ps(x + i);
+		__m128 top = _mm_loadu_ps(y + i);
+		__m128 right = _mm_add_ps(left, size);
+		__m128 bottom = _mm_add_ps(top, size);
+
+		//Corners of particles 0 and 1 from the low halves, 2 and 3 from the high halves
+		for (int half = 0; half < 2; ++half)
+		{
+			__m128 topLeft = half == 0 ? _mm_unpacklo_ps(left, top) : _mm_unpackhi_ps(left, top);
+			__m128 topRight = half == 0 ? _mm_unpacklo_ps(right, top) : _mm_unpackhi_ps(right, top);
+			__m128 bottomLeft = half == 0 ? _mm_unpacklo_ps(left, bottom) : _mm_unpackhi_ps(left, bottom);
+
+			//x0 y0 x0+s y0 | x0 y0+s x1 y1 | x1+s y1 x1 y1+s
+			_mm_storeu_ps(position, _mm_movelh_ps(topLeft, topRight));
+			_mm_storeu_ps(position + 4, _mm_shuffle_ps(bottomLeft, topLeft, _MM_SHUFFLE(3, 2, 1, 0)));
+			_mm_storeu_ps(position + 8, _mm_movehl_ps(bottomLeft, topRight));
+			position += 12;
+		}
+
+		//Each color three times: c0 c0 c0 c1 | c1 c1 c2 c2 | c2 c3 c3 c3
+		__m128i colors = _mm_loadu_si128((const __m128i*)&mColors[i]);
+		_mm_storeu_si128((__m128i*)color, _mm_shuffle_epi32(colors, _MM_SHUFFLE(1, 0, 0, 0)));
+		_mm_storeu_si128((__m128i*)(color + 4), _mm_shuffle_epi32(colors, _MM_SHUFFLE(2, 2, 1, 1)));
+		_mm_storeu_si128((__m128i*)(color + 8), _mm_shuffle_epi32(colors, _MM_SHUFFLE(3, 3, 3, 2)));
+		color += 12;
+	}
+
+	//Leftovers one at a time
+	buildGeometryRange(blocks);
+}
+#endif
+
+#ifdef PARTICLE_USE_AVX
+PARTICLE_TARGET_AVX
+void ParticleEmitter::buildGeometryAVX()
+{
+	const float* x = &mFields[FIELD_X][0];
+	const float* y = &mFields[FIELD_Y][0];
+	float* position = &mVertexPositions[0];
+	SDL_Color* color = &mVertexColors[0];
+	const __m256 size = _mm256_set1_ps(PARTICLE_SIZE);
+
+	//Eight particles a step, 48 floats and 24 colors out
+	int blocks = mCount & ~7;
+	for (int i = 0; i < blocks; i += 8)
+	{
+		__m256 left = _mm256_loadu_ps(x + i);
+		__m256 top = _mm256_loadu_ps(y + i);
+		__m256 right = _mm256_add_ps(left, size);
+		__m256 bottom = _mm256_add_ps(top, size);
+
+		//Same shuffles as SSE2 inside each 128 bit lane: the low unpacks hold particles 0, 1 | 4, 5, the high ones 2, 3 | 6, 7
+		__m256 topLeft = _mm256_unpacklo_ps(left, top);
+		__m256 topRight = _mm256_unpacklo_ps(right, top);
+		__m256 bottomLeft = _mm256_unpacklo_ps(left, bottom);
+		__m256 low0 = _mm256_shuffle_ps(topLeft, topRight, _MM_SHUFFLE(1, 0, 1, 0));
+		__m256 low1 = _mm256_shuffle_ps(bottomLeft, topLeft, _MM_SHUFFLE(3, 2, 1, 0));
+		__m256 low2 = _mm256_shuffle_ps(topRight, bottomLeft, _MM_SHUFFLE(3, 2, 3, 2));
+
+		topLeft = _mm256_unpackhi_ps(left, top);
+		topRight = _mm256_unpackhi_ps(right, top);
+		bottomLeft = _mm256_unpackhi_ps(left, bottom);
+		__m256 high0 = _mm256_shuffle_ps(topLeft, topRight, _MM_SHUFFLE(1, 0, 1, 0));
+		__m256 high1 = _mm256_shuffle_ps(bottomLeft, topLeft, _MM_SHUFFLE(3, 2, 1, 0));
+		__m256 high2 = _mm256_shuffle_ps(topRight, bottomLeft, _MM_SHUFFLE(3, 2, 3, 2));
+
+		//Particles 0-3 from the low lanes, then 4-7 from the high lanes
+		_mm256_storeu_ps(position, _mm256_permute2f128_ps(low0, low1, 0x20));
+		_mm256_storeu_ps(position + 8, _mm256_permute2f128_ps(low2, high0, 0x20));
+		_mm256_storeu_ps(position + 16, _mm256_permute2f128_ps(high1, high2, 0x20));
+		_mm256_storeu_ps(position + 24, _mm256_permute2f128_ps(low0, low1, 0x31));
+		_mm256_storeu_ps(position + 32, _mm256_permute2f128_ps(low2, high0, 0x31));
+		_mm256_storeu_ps(position + 40, _mm256_permute2f128_ps(high1, high2, 0x31));
+		position += 48;
+
+		//Colors moved as floats, AVX has no integer shuffles. Only bits are moved, nothing is computed on them.
+		__m256 colors = _mm256_loadu_ps((const float*)&mColors[i]);
+		__m256 colors0 = _mm256_permute_ps(colors, _MM_SHUFFLE(1, 0, 0, 0));
+		__m256 colors1 = _mm256_permute_ps(colors, _MM_SHUFFLE(2, 2, 1, 1));
+		__m256 colors2 = _mm256_permute_ps(colors, _MM_SHUFFLE(3, 3, 3, 2));
+		_mm256_storeu_ps((float*)color, _mm256_permute2f128_ps(colors0, colors1, 0x20));
+		_mm256_storeu_ps((float*)(color + 8), _mm256_permute2f128_ps(colors2, colors0, 0x30));
+		_mm256_storeu_ps((float*)(color + 16), _mm256_permute2f128_ps(colors1, colors2, 0x31));
+		color += 24;
+	}
+
+	//Leftovers one at a time
+	_mm256_zeroupper();
+	buildGeometryRange(blocks);
+}
+#endif
+
+int ParticleEmitter::render(bool geometry)
+{
+	if (mCount == 0)
+	{
+		return 0;
+	}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	if (geometry)
+	{
+		//Positions and colors straight from their own arrays, no texture and no indices
+		if (SDL_RenderGeometryRaw(gRenderer, NULL, &mVertexPositions[0], sizeof(float) * 2, &mVertexColors[0], sizeof(SDL_Color), NULL, 0, mCount * 3, NULL, 0, 0) == 0)
+		{
+			return 1;
+		}
+		printf("Warning: particle geometry failed, drawing point by point! SDL Error: %s\n", SDL_GetError());
+	}
+#endif
+
+	//No geometry API, or it was turned off: the lesson 8 way
+	for (int i = 0; i < mCount; ++i)
+	{
+		const SDL_Color& color = mColors[i];
+		SDL_SetRenderDrawColor(gRenderer, color.r, color.g, color.b, color.a);
+		SDL_RenderDrawPoint(gRenderer, (int)mFields[FIELD_X][i], (int)mFields[FIELD_Y][i]);
+	}
+	return mCount;
+}
+
+int ParticleEmitter::getCount()
+{
+	return mCount;
+}
+
+int ParticleEmitter::getCapacity()
+{
+	return mCapacity;
+}
+
+float ParticleEmitter::getField(int field, int index)
+{
+	return mFields[field][index];
+}
+
+bool ParticleEmitter::hasSameGeometry(const ParticleEmitter& other)
+{
+	//Bit for bit, the builders only move and add the same floats
+	return mVertexPositions.size() == other.mVertexPositions.size() && mVertexColors.size() == other.mVertexColors.size() &&
+		(mVertexPositions.empty() || memcmp(&mVertexPositions[0], &other.mVertexPositions[0], mVertexPositions.size() * sizeof(float)) == 0) &&
+		(mVertexColors.empty() || memcmp(&mVertexColors[0], &other.mVertexColors[0], mVertexColors.size() * sizeof(SDL_Color)) == 0);
+}
+
+float ParticleEmitter::random()
+{
+	//xorshift32, top 24 bits as the fraction
+	mRandom ^= mRandom << 13;
+	mRandom ^= mRandom >> 17;
+	mRandom ^= mRandom << 5;
+	return (mRandom >> 8) * (1.0f / 16777216.0f);
+}
+
+bool isParticleKernelSupported(int kernel)
+{
+	switch (kernel)
+	{
+		case PARTICLE_SCALAR:
+		return true;
+
+#ifdef PARTICLE_USE_SSE2
+		case PARTICLE_SSE2:
+		return SDL_HasSSE2() == SDL_TRUE;
+#endif
+
+#if defined(PARTICLE_USE_AVX) && SDL_VERSION_ATLEAST(2, 0, 2)
+		case PARTICLE_AVX:
+		return SDL_HasAVX() == SDL_TRUE;
+#endif
+
+		default:
+		return false;
+	}
+}
+
+double getSeconds(Uint64 start, Uint64 end)
+{
+	return (double)(end - start) / SDL_GetPerformanceFrequency();
+}
+
+bool runSelfTest()
+{
+	bool success = true;
+	const float frameSeconds = 1.0f / 60.0f;
+
+	//Same emitter and seed run through each kernel, every frame must leave the same particles and the same triangles
+	for (int kernel = PARTICLE_SSE2; kernel < PARTICLE_TOTAL; ++kernel)
+	{
+		if (!isParticleKernelSupported(kernel))
+		{
+			printf("%s: not supported here, skipped\n", PARTICLE_KERNEL_NAMES[kernel]);
+			continue;
+		}
+
+		ParticleEmitter reference;
+		ParticleEmitter tested;
+		reference.create(EMITTER_SETTINGS[0], 10007, 1234);
+		tested.create(EMITTER_SETTINGS[0], 10007, 1234);
+
+		int mismatches = 0;
+		for (int frame = 0; frame < SELFTEST_COMPARE_FRAMES; ++frame)
+		{
+			reference.emit(frameSeconds);
+			tested.emit(frameSeconds);
+			reference.update(frameSeconds, PARTICLE_SCALAR);
+			tested.update(frameSeconds, (ParticleKernel)kernel);
+			reference.buildGeometry(PARTICLE_SCALAR);
+			tested.buildGeometry((ParticleKernel)kernel);
+
+			if (reference.getCount() != tested.getCount() || !tested.hasSameGeometry(reference))
+			{
+				++mismatches;
+				continue;
+			}
+			for (int i = 0; i < reference.getCount(); ++i)
+			{
+				for (int field = 0; field < PARTICLE_FIELDS; ++field)
+				{
+					if (reference.getField(field, i) != tested.getField(field, i))
+					{
+						++mismatches;
+						field = PARTICLE_FIELDS;
+						i = reference.getCount();
+					}
+				}
+			}
+		}
+		printf("%s: %s scalar over %d frames (%d mismatching frames, %d particles alive)\n", PARTICLE_KERNEL_NAMES[kernel], mismatches == 0 ? "matches" : "DIFFERS from", SELFTEST_COMPARE_FRAMES, mismatches, tested.getCount());
+		success = success && mismatches == 0;
+	}
+
+	//One emitter holding MAX_PARTICLES, run until it is full before timing
+	ParticleEmitter emitter;
+	emitter.create(EMITTER_SETTINGS[0], MAX_PARTICLES, 4321);
+	for (int frame = 0; frame < (int)(EMITTER_SETTINGS[0].lifetime * 60.0f); ++frame)
+	{
+		emitter.emit(frameSeconds);
+		emitter.update(frameSeconds, PARTICLE_SCALAR);
+	}
+
+	for (int kernel = 0; kernel < PARTICLE_TOTAL; ++kernel)
+	{
+		if (!isParticleKernelSupported(kernel))
+		{
+			continue;
+		}
+
+		double updateSeconds = 0.0;
+		double buildSeconds = 0.0;
+		int particles = 0;
+		for (int frame = 0; frame < SELFTEST_BENCHMARK_FRAMES; ++frame)
+		{
+			Uint64 start = SDL_GetPerformanceCounter();
+			emitter.emit(frameSeconds);
+			emitter.update(frameSeconds, (ParticleKernel)kernel);
+			Uint64 middle = SDL_GetPerformanceCounter();
+			emitter.buildGeometry((ParticleKernel)kernel);
+			Uint64 end = SDL_GetPerformanceCounter();
+
+			updateSeconds += getSeconds(start, middle);
+			buildSeconds += getSeconds(middle, end);
+			particles += emitter.getCount();
+		}
+		printf("%s: %d particles, emit and update %.3f ms, geometry %.3f ms per frame\n", PARTICLE_KERNEL_NAMES[kernel], particles / SELFTEST_BENCHMARK_FRAMES, updateSeconds * 1000.0 / SELFTEST_BENCHMARK_FRAMES, buildSeconds * 1000.0 / SELFTEST_BENCHMARK_FRAMES);
+	}
+
+	return success;
+}
+
+int runBenchmark()
+{
+	const float frameSeconds = 1.0f / 60.0f;
+
+	//The demo's fountains sharing MAX_PARTICLES, drawn the way the demo draws them
+	SDL_SetRenderDrawBlendMode(gRenderer, SDL_BLENDMODE_ADD);
+	for (int i = 0; i < TOTAL_EMITTERS; ++i)
+	{
+		gEmitters[i].create(EMITTER_SETTINGS[i], MAX_PARTICLES / TOTAL_EMITTERS, 1000 + i);
+	}
+
+	//Run until the longest lived fountain is full before timing
+	float lifetime = 0.0f;
+	for (int i = 0; i < TOTAL_EMITTERS; ++i)
+	{
+		lifetime = SDL_max(lifetime, EMITTER_SETTINGS[i].lifetime);
+	}
+	for (int frame = 0; frame < (int)(lifetime * 60.0f); ++frame)
+	{
+		for (int i = 0; i < TOTAL_EMITTERS; ++i)
+		{
+			gEmitters[i].emit(frameSeconds);
+			gEmitters[i].update(frameSeconds, PARTICLE_SCALAR);
+		}
+	}
+
+	//The budget is for the widest kernel the CPU has, which is the last one supported
+	double widestAverage = 0.0;
+	int widestParticles = 0;
+	for (int kernel = 0; kernel < PARTICLE_TOTAL; ++kernel)
+	{
+		if (!isParticleKernelSupported(kernel))
+		{
+			continue;
+		}
+
+		double updateSeconds = 0.0;
+		double buildSeconds = 0.0;
+		double renderSeconds = 0.0;
+		double presentSeconds = 0.0;
+		double worstSeconds = 0.0;
+		int particles = 0;
+		int draws = 0;
+		for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+		{
+			Uint64 updateStart = SDL_GetPerformanceCounter();
+			for (int i = 0; i < TOTAL_EMITTERS; ++i)
+			{
+				gEmitters[i].emit(frameSeconds);
+				gEmitters[i].update(frameSeconds, (ParticleKernel)kernel);
+				particles += gEmitters[i].getCount();
+			}
+			Uint64 buildStart = SDL_GetPerformanceCounter();
+			for (int i = 0; i < TOTAL_EMITTERS; ++i)
+			{
+				gEmitters[i].buildGeometry((ParticleKernel)kernel);
+			}
+			Uint64 renderStart = SDL_GetPerformanceCounter();
+			SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0x00, 0xFF);
+			SDL_RenderClear(gRenderer);
+			for (int i = 0; i < TOTAL_EMITTERS; ++i)
+			{
+				draws += gEmitters[i].render(true);
+			}
+			Uint64 presentStart = SDL_GetPerformanceCounter();
+			SDL_RenderPresent(gRenderer);
+			Uint64 end = SDL_GetPerformanceCounter();
+
+			updateSeconds += getSeconds(updateStart, buildStart);
+			buildSeconds += getSeconds(buildStart, renderStart);
+			renderSeconds += getSeconds(renderStart, presentStart);
+			presentSeconds += getSeconds(presentStart, end);
+			worstSeconds = SDL_max(worstSeconds, getSeconds(updateStart, end));
+		}
+
+		double average = (updateSeconds + buildSeconds + renderSeconds + presentSeconds) * 1000.0 / BENCHMARK_FRAMES;
+		printf("%s: %d particles, %d draws, update %.3f ms, build %.3f ms, draw %.3f ms, present %.3f ms, frame %.3f ms average, %.3f ms worst\n", PARTICLE_KERNEL_NAMES[kernel],
+			particles / BENCHMARK_FRAMES, draws / BENCHMARK_FRAMES, updateSeconds * 1000.0 / BENCHMARK_FRAMES, buildSeconds * 1000.0 / BENCHMARK_FRAMES,
+			renderSeconds * 1000.0 / BENCHMARK_FRAMES, presentSeconds * 1000.0 / BENCHMARK_FRAMES, average, worstSeconds * 1000.0);
+
+		widestAverage = average;
+		widestParticles = particles / BENCHMARK_FRAMES;
+	}
+
+	bool withinBudget = widestAverage <= BUDGET_MILLISECONDS;
+	printf("Budget %s: widest kernel %.3f ms average frame for %d particles, budget %.1f ms\n", withinBudget ? "PASS" : "FAIL", widestAverage, widestParticles, BUDGET_MILLISECONDS);
+
+	return withinBudget ? 0 : 2;
+}
+
+bool init(bool hidden)
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window, without vsync when hidden so the benchmark sees what a frame really costs
+			gRenderer = SDL_CreateRenderer(gWindow, -1, hidden ? SDL_RENDERER_ACCELERATED : SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+			}
+		}
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"selftest" checks the vector kernels against scalar and times them on MAX_PARTICLES, no window needed
+	if (argc >= 2 && strcmp(args[1], "selftest") == 0)
+	{
+		return runSelfTest() ? 0 : 1;
+	}
+
+	//"benchmark" draws MAX_PARTICLES in a hidden window and times whole frames against the budget
+	bool benchmark = argc >= 2 && strcmp(args[1], "benchmark") == 0;
+
+	//The benchmark exits 1 when it can't run and 2 over budget, so scripts can gate on it
+	int exitCode = 0;
+
+	//Start up SDL and create window
+	if (!init(benchmark))
+	{
+		printf("Failed to initialize!\n");
+		exitCode = benchmark ? 1 : 0;
+	}
+	else if (benchmark)
+	{
+		exitCode = runBenchmark();
+	}
+	else
+	{
+		//Main loop flag
+		bool quit = false;
+
+		//Event handler
+		SDL_Event e;
+
+		//Widest supported kernel first, the budget is split evenly between the emitters
+		ParticleKernel kernel = PARTICLE_SCALAR;
+		for (int i = 0; i < PARTICLE_TOTAL; ++i)
+		{
+			if (isParticleKernelSupported(i))
+			{
+				kernel = (ParticleKernel)i;
+			}
+		}
+		int budget = DEFAULT_PARTICLES;
+		for (int i = 0; i < TOTAL_EMITTERS; ++i)
+		{
+			gEmitters[i].create(EMITTER_SETTINGS[i], budget / TOTAL_EMITTERS, 1000 + i);
+		}
+		bool geometry = true;
+
+		//Glowing sparks add up where they overlap
+		SDL_SetRenderDrawBlendMode(gRenderer, SDL_BLENDMODE_ADD);
+
+		//Frame costs for the title, averaged over a second
+		Uint32 titleTicks = SDL_GetTicks();
+		Uint32 lastTicks = titleTicks;
+		double updateSeconds = 0.0;
+		double buildSeconds = 0.0;
+		double renderSeconds = 0.0;
+		int draws = 0;
+		int frames = 0;
+
+		//While application is running
+		while (!quit)
+		{
+			//Handle events on queue
+			while (SDL_PollEvent(&e) != 0)
+			{
+				//User requests quit
+				if (e.type == SDL_QUIT)
+				{
+					quit = true;
+				}
+				else if (e.type == SDL_MOUSEMOTION)
+				{
+					gEmitters[0].setPosition((float)e.motion.x, (float)e.motion.y);
+				}
+				else if (e.type == SDL_KEYDOWN)
+				{
+					switch (e.key.keysym.sym)
+					{
+						//Up/down doubles/halves the particles
+						case SDLK_UP:
+						case SDLK_DOWN:
+						budget = e.key.keysym.sym == SDLK_UP ? SDL_min(budget * 2, MAX_PARTICLES) : SDL_max(budget / 2, MIN_PARTICLES);
+						for (int i = 0; i < TOTAL_EMITTERS; ++i)
+						{
+							gEmitters[i].setCapacity(budget / TOTAL_EMITTERS);
+						}
+						break;
+
+						//Tab cycles the kernels
+						case SDLK_TAB:
+						do
+						{
+							kernel = (ParticleKernel)((kernel + 1) % PARTICLE_TOTAL);
+						} while (!isParticleKernelSupported(kernel));
+						break;
+
+						//G switches between one geometry call per emitter and a point per particle
+						case SDLK_g:
+						geometry = !geometry;
+						break;
+					}
+				}
+			}
+
+			//Real elapsed time, capped so a stall doesn't launch everything at once
+			Uint32 ticks = SDL_GetTicks();
+			float seconds = SDL_min(ticks - lastTicks, 100) / 1000.0f;
+			lastTicks = ticks;
+
+			//Spawn, move and build the triangles
+			int particles = 0;
+			Uint64 updateStart = SDL_GetPerformanceCounter();
+			for (int i = 0; i < TOTAL_EMITTERS; ++i)
+			{
+				gEmitters[i].emit(seconds);
+				gEmitters[i].update(seconds, kernel);
+				particles += gEmitters[i].getCount();
+			}
+			Uint64 buildStart = SDL_GetPerformanceCounter();
+			if (geometry)
+			{
+				for (int i = 0; i < TOTAL_EMITTERS; ++i)
+				{
+					gEmitters[i].buildGeometry(kernel);
+				}
+			}
+			Uint64 renderStart = SDL_GetPerformanceCounter();
+
+			//Clear screen
+			SDL_SetRenderDrawColor(gRenderer, 0x00, 0x00, 0x00, 0xFF);
+			SDL_RenderClear(gRenderer);
+
+			//Every emitter in one call each
+			draws = 0;
+			for (int i = 0; i < TOTAL_EMITTERS; ++i)
+			{
+				draws += gEmitters[i].render(geometry);
+			}
+			Uint64 renderEnd = SDL_GetPerformanceCounter();
+
+			updateSeconds += getSeconds(updateStart, buildStart);
+			buildSeconds += getSeconds(buildStart, renderStart);
+			renderSeconds += getSeconds(renderStart, renderEnd);
+			++frames;
+
+			//Show the kernel, the particles and what they cost
+			if (ticks - titleTicks >= 1000)
+			{
+				char title[160];
+				SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s, %s: %d particles, %d draws, update %.2f ms, build %.2f ms, draw %.2f ms", PARTICLE_KERNEL_NAMES[kernel], geometry ? "geometry" : "points", particles, draws, updateSeconds * 1000.0 / frames, buildSeconds * 1000.0 / frames, renderSeconds * 1000.0 / frames);
+				SDL_SetWindowTitle(gWindow, title);
+				titleTicks = ticks;
+				updateSeconds = 0.0;
+				buildSeconds = 0.0;
+				renderSeconds = 0.0;
+				frames = 0;
+			}
+
+			//Update screen
+			SDL_RenderPresent(gRenderer);
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return exitCode;
+}
@@ -0,0 +1,979 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, standard IO, math, strings, atomics, and vectors
+#include <SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <atomic>
+#include <vector>
+
+//SSE2 is always there on x64 and on x86 builds compiled with /arch:SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIXER_USE_SSE2 1
+#endif
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Output format: stereo floats, small buffers for low latency
+const int MIXER_FREQUENCY = 48000;
+const int MIXER_BUFFER_FRAMES = 256;
+
+//Sounds that can play at once, the one furthest along is cut when another starts
+const int MAX_VOICES = 32;
+
+//Commands the game can queue before the callback picks them up, a power of two
+const int AUDIO_COMMAND_CAPACITY = 256;
+
+//Voices started by the burst key
+const int BURST_VOICES = 16;
+
+//Buffers the self test mixes offline, and how long it runs the device
+const int SELFTEST_BUFFERS = 400;
+const int SELFTEST_DEVICE_MS = 2000;
+
+//Mixing kernel implementations
+enum MixerKernel
+{
+	MIXER_SCALAR,
+	MIXER_SSE2,
+	MIXER_TOTAL
+};
+
+//Names used in the title and the self test
+const char* MIXER_KERNEL_NAMES[MIXER_TOTAL] = { "scalar", "SSE2" };
+
+//The sounds the demo loads
+enum SoundEffect
+{
+	SOUND_HIGH,
+	SOUND_MEDIUM,
+	SOUND_LOW,
+	SOUND_SCRATCH,
+	SOUND_TOTAL
+};
+
+const char* SOUND_PATHS[SOUND_TOTAL] = { "Sounds/high.wav", "Sounds/medium.wav", "Sounds/low.wav", "Sounds/scratch.wav" };
+
+//A sound converted to the mixer's format at load time: interleaved stereo floats, never changed afterwards
+struct AudioSound
+{
+	std::vector<float> samples;
+	int frames;
+};
+
+//What the game can ask of the callback
+enum AudioCommandType
+{
+	AUDIO_PLAY,
+	AUDIO_STOP_ALL,
+	AUDIO_SET_KERNEL,
+	AUDIO_RESET_PEAK
+};
+
+//One queued request, everything the callback needs is worked out before it is queued
+struct AudioCommand
+{
+	AudioCommandType type;
+	const AudioSound* sound;
+	float gainLeft;
+	float gainRight;
+	int kernel;
+};
+
+//A playing sound
+struct AudioVoice
+{
+	const AudioSound* sound;
+	int position;
+	float gainLeft;
+	float gainRight;
+};
+
+//What the callback has been up to, counters only ever go up
+struct AudioStats
+{
+	Uint32 callbacks;
+	Uint32 underruns;
+	Uint64 callbackTicks;
+	Uint64 peakCallbackTicks;
+	int activeVoices;
+};
+
+//Mixes voices in the audio callback. Only one game thread may call the queueing functions.
+//The callback never locks or allocates: it hears from the game through a single producer, single consumer ring.
+class AudioMixer
+{
+	public:
+		//Initializes variables
+		AudioMixer();
+
+		//Deallocates memory
+		~AudioMixer();
+
+		//Opens the default output device and starts the callback
+		bool open(int frequency, int bufferFrames);
+
+		//Sets the format without a device, mix() is then called by hand
+		void openOffline(int frequency, int bufferFrames);
+
+		//Stops the device and frees the sounds
+		void close();
+
+		//Loads a WAV and converts it to the mixer's format, the mixer owns the result
+		const AudioSound* loadSound(std::string path);
+
+		//Queues a sound at a volume of 0 to 1 and a pan of -1 (left) to 1 (right), false if the queue is full
+		bool play(const AudioSound* sound, float volume, float pan);
+
+		//Queues stopping everything
+		bool stopAll();
+
+		//Queues a kernel switch
+		bool setKernel(MixerKernel kernel);
+
+		//Queues restarting the peak callback time
+		bool resetPeak();
+
+		//Gets what the callback has published
+		void getStats(AudioStats* stats);
+
+		//Gets commands that didn't fit in the queue
+		int getDroppedCommands();
+
+		//Gets the output format
+		int getFrequency();
+		int getBufferFrames();
+
+		//Fills frames of interleaved stereo, the callback's work
+		void mix(float* out, int frames);
+
+	private:
+		//Adds a command for the callback, game thread only
+		bool pushCommand(const AudioCommand& command);
+
+		//Runs everything queued since the last callback, callback only
+		void runCommands();
+
+		//SDL's audio callback, hands off to mix()
+		static void SDLCALL audioCallback(void* userdata, Uint8* stream, int length);
+
+		//Output device and format
+		SDL_AudioDeviceID mDevice;
+		int mFrequency;
+		int mBufferFrames;
+
+		//Loaded sounds, only freed once the device is closed
+		std::vector<AudioSound*> mSounds;
+
+		//Command ring, the game only stores the head and the callback only stores the tail
+		AudioCommand mCommands[AUDIO_COMMAND_CAPACITY];
+		alignas(64) std::atomic<Uint32> mCommandHead;
+		alignas(64) std::atomic<Uint32> mCommandTail;
+
+		//Game side count of commands the full ring turned away
+		int mDroppedCommands;
+
+		//Callback side state
+		AudioVoice mVoices[MAX_VOICES];
+		int mKernel;
+		Uint64 mLastCallbackStart;
+		Uint64 mLateTicks;
+
+		//Published by the callback, read by the game
+		alignas(64) std::atomic<Uint32> mCallbacks;
+		std::atomic<Uint32> mUnderruns;
+		std::atomic<Uint64> mCallbackTicks;
+		std::atomic<Uint64> mPeakCallbackTicks;
+		std::atomic<int> mActiveVoices;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Checks the kernels agree and the command ring holds, then runs a device for a while
+bool runSelfTest(const char* driver);
+
+//Checks whether a kernel was compiled in and the CPU can run it
+bool isMixerKernelSupported(int kernel);
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//The mixer and the sounds it plays
+AudioMixer gMixer;
+const AudioSound* gSounds[SOUND_TOTAL];
+
+
+//Adds a voice's frames into out at per channel gains
+static void mixVoiceScalar(float* out, const float* samples, int frames, float gainLeft, float gainRight)
+{
+	for (int i = 0; i < frames; ++i)
+	{
+		out[i * 2] += samples[i * 2] * gainLeft;
+		out[i * 2 + 1] += samples[i * 2 + 1] * gainRight;
+	}
+}
+
+//Keeps the mixed output between -1 and 1
+static void clampScalar(float* out, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		out[i] = SDL_min(SDL_max(out[i], -1.0f), 1.0f);
+	}
+}
+
+#ifdef MIXER_USE_SSE2
+static void mixVoiceSSE2(float* out, const float* samples, int frames, float gainLeft, float gainRight)
+{
+	//Two stereo frames per step, the gains repeat left, right
+	__m128 gains = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+	int count = frames * 2;
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(samples + i), gains)));
+	}
+
+	//An odd frame left over
+	if (i < count)
+	{
+		mixVoiceScalar(out + i, samples + i, (count - i) / 2, gainLeft, gainRight);
+	}
+}
+
+static void clampSSE2(float* out, int count)
+{
+	__m128 low = _mm_set1_ps(-1.0f);
+	__m128 high = _mm_set1_ps(1.0f);
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_ps(out + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(out + i), low), high));
+	}
+	clampScalar(out + i, count - i);
+}
+#endif
+
+bool isMixerKernelSupported(int kernel)
+{
+	switch (kernel)
+	{
+		case MIXER_SCALAR:
+		return true;
+
+#ifdef MIXER_USE_SSE2
+		case MIXER_SSE2:
+		return SDL_HasSSE2() == SDL_TRUE;
+#endif
+
+		default:
+		return false;
+	}
+}
+
+
+AudioMixer::AudioMixer()
+{
+	//Initialize
+	mDevice = 0;
+	mFrequency = 0;
+	mBufferFrames = 0;
+	memset(mCommands, 0, sizeof(mCommands));
+	mCommandHead = 0;
+	mCommandTail = 0;
+	mDroppedCommands = 0;
+	memset(mVoices, 0, sizeof(mVoices));
+	mKernel = MIXER_SCALAR;
+	mLastCallbackStart = 0;
+	mLateTicks = 0;
+	mCallbacks = 0;
+	mUnderruns = 0;
+	mCallbackTicks = 0;
+	mPeakCallbackTicks = 0;
+	mActiveVoices = 0;
+}
+
+AudioMixer::~AudioMixer()
+{
+	//Deallocate
+	close();
+}
+
+bool AudioMixer::open(int frequency, int bufferFrames)
+{
+	//Get rid of preexisting device
+	close();
+
+	//Ask for exactly the mixing format, SDL converts if the hardware wants something else
+	SDL_AudioSpec desired;
+	SDL_AudioSpec obtained;
+	memset(&desired, 0, sizeof(desired));
+	desired.freq = frequency;
+	desired.format = AUDIO_F32SYS;
+	desired.channels = 2;
+	desired.samples = (Uint16)bufferFrames;
+	desired.callback = audioCallback;
+	desired.userdata = this;
+
+	mDevice = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+	if (mDevice == 0)
+	{
+		printf("Unable to open audio device! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	mFrequency = obtained.freq;
+	mBufferFrames = obtained.samples;
+	mKernel = isMixerKernelSupported(MIXER_SSE2) ? MIXER_SSE2 : MIXER_SCALAR;
+
+	//SDL doesn't say when the device ran dry, a callback arriving half a buffer late is counted as one
+	mLastCallbackStart = 0;
+	mLateTicks = SDL_GetPerformanceFrequency() * mBufferFrames * 3 / (mFrequency * 2);
+
+	//Start the callback
+	SDL_PauseAudioDevice(mDevice, 0);
+	return true;
+}
+
+void AudioMixer::openOffline(int frequency, int bufferFrames)
+{
+	close();
+	mFrequency = frequency;
+	mBufferFrames = bufferFrames;
+	mKernel = MIXER_SCALAR;
+
+	//Nobody is waiting on an offline mix, so nothing is late
+	mLateTicks = 0;
+}
+
+void AudioMixer::close()
+{
+	//The callback is done once the device is closed, then nothing can be reading the sounds
+	if (mDevice != 0)
+	{
+		SDL_CloseAudioDevice(mDevice);
+		mDevice = 0;
+	}
+
+	for (size_t i = 0; i < mSounds.size(); ++i)
+	{
+		delete mSounds[i];
+	}
+	mSounds.clear();
+	memset(mVoices, 0, sizeof(mVoices));
+	mCommandHead = 0;
+	mCommandTail = 0;
+	mActiveVoices = 0;
+}
+
+const AudioSound* AudioMixer::loadSound(std::string path)
+{
+	//Load the file in whatever format it was saved in
+	SDL_AudioSpec spec;
+	Uint8* buffer = NULL;
+	Uint32 length = 0;
+	if (SDL_LoadWAV(path.c_str(), &spec, &buffer, &length) == NULL)
+	{
+		printf("Unable to load sound %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return NULL;
+	}
+
+	//Convert to stereo floats at the mixer's rate, the converter needs room to grow into
+	SDL_AudioCVT cvt;
+	if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, AUDIO_F32SYS, 2, mFrequency) < 0)
+	{
+		printf("Unable to convert sound %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		SDL_FreeWAV(buffer);
+		return NULL;
+	}
+	cvt.len = (int)length;
+	cvt.buf = (Uint8*)SDL_malloc(length * cvt.len_mult);
+	if (cvt.buf == NULL)
+	{
+		printf("Unable to allocate conversion buffer for %s!\n", path.c_str());
+		SDL_FreeWAV(buffer);
+		return NULL;
+	}
+	memcpy(cvt.buf, buffer, length);
+	SDL_FreeWAV(buffer);
+
+	if (SDL_ConvertAudio(&cvt) < 0)
+	{
+		printf("Unable to convert sound %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		SDL_free(cvt.buf);
+		return NULL;
+	}
+
+	AudioSound* sound = new AudioSound();
+	sound->frames = cvt.len_cvt / (int)(sizeof(float) * 2);
+	sound->samples.assign((float*)cvt.buf, (float*)cvt.buf + sound->frames * 2);
+	SDL_free(cvt.buf);
+
+	mSounds.push_back(sound);
+	return sound;
+}
+
+bool AudioMixer::play(const AudioSound* sound, float volume, float pan)
+{
+	if (sound == NULL || sound->frames == 0)
+	{
+		return false;
+	}
+
+	//Constant power pan, worked out here so the callback only multiplies
+	float angle = (SDL_min(SDL_max(pan, -1.0f), 1.0f) + 1.0f) * 0.25f * (float)M_PI;
+	AudioCommand command;
+	memset(&command, 0, sizeof(command));
+	command.type = AUDIO_PLAY;
+	command.sound = sound;
+	command.gainLeft = volume * cosf(angle);
+	command.gainRight = volume * sinf(angle);
+	return pushCommand(command);
+}
+
+bool AudioMixer::stopAll()
+{
+	AudioCommand command;
+	memset(&command, 0, sizeof(command));
+	command.type = AUDIO_STOP_ALL;
+	return pushCommand(command);
+}
+
+bool AudioMixer::setKernel(MixerKernel kernel)
+{
+	if (!isMixerKernelSupported(kernel))
+	{
+		return false;
+	}
+
+	AudioCommand command;
+	memset(&command, 0, sizeof(command));
+	command.type = AUDIO_SET_KERNEL;
+	command.kernel = kernel;
+	return pushCommand(command);
+}
+
+bool AudioMixer::resetPeak()
+{
+	AudioCommand command;
+	memset(&command, 0, sizeof(command));
+	command.type = AUDIO_RESET_PEAK;
+	return pushCommand(command);
+}
+
+bool AudioMixer::pushCommand(const AudioCommand& command)
+{
+	//The tail is acquired so the slot we're about to reuse is really done with
+	Uint32 head = mCommandHead.load(std::memory_order_relaxed);
+	Uint32 tail = mCommandTail.load(std::memory_order_acquire);
+	if (head - tail >= (Uint32)AUDIO_COMMAND_CAPACITY)
+	{
+		++mDroppedCommands;
+		return false;
+	}
+
+	//Fill the slot, then release it to the callback
+	mCommands[head & (AUDIO_COMMAND_CAPACITY - 1)] = command;
+	mCommandHead.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+void AudioMixer::runCommands()
+{
+	Uint32 tail = mCommandTail.load(std::memory_order_relaxed);
+	Uint32 head = mCommandHead.load(std::memory_order_acquire);
+	for (; tail != head; ++tail)
+	{
+		const AudioCommand& command = mCommands[tail & (AUDIO_COMMAND_CAPACITY - 1)];
+		switch (command.type)
+		{
+			case AUDIO_PLAY:
+			{
+				//A free voice, or else the one closest to finishing
+				int chosen = 0;
+				for (int i = 0; i < MAX_VOICES; ++i)
+				{
+					if (mVoices[i].sound == NULL)
+					{
+						chosen = i;
+						break;
+					}
+					if (mVoices[i].sound->frames - mVoices[i].position < mVoices[chosen].sound->frames - mVoices[chosen].position)
+					{
+						chosen = i;
+					}
+				}
+				mVoices[chosen].sound = command.sound;
+				mVoices[chosen].position = 0;
+				mVoices[chosen].gainLeft = command.gainLeft;
+				mVoices[chosen].gainRight = command.gainRight;
+				break;
+			}
+
+			case AUDIO_STOP_ALL:
+			for (int i = 0; i < MAX_VOICES; ++i)
+			{
+				mVoices[i].sound = NULL;
+			}
+			break;
+
+			case AUDIO_SET_KERNEL:
+			mKernel = command.kernel;
+			break;
+
+			case AUDIO_RESET_PEAK:
+			mPeakCallbackTicks.store(0, std::memory_order_relaxed);
+			break;
+		}
+	}
+
+	//Hand the slots back
+	mCommandTail.store(tail, std::memory_order_release);
+}
+
+void AudioMixer::mix(float* out, int frames)
+{
+	Uint64 start = SDL_GetPerformanceCounter();
+	if (mLateTicks != 0 && mLastCallbackStart != 0 && start - mLastCallbackStart > mLateTicks)
+	{
+		mUnderruns.store(mUnderruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+	mLastCallbackStart = start;
+
+	runCommands();
+
+	//Silence, then every voice on top
+	memset(out, 0, frames * 2 * sizeof(float));
+	int activeVoices = 0;
+	for (int i = 0; i < MAX_VOICES; ++i)
+	{
+		AudioVoice& voice = mVoices[i];
+		if (voice.sound == NULL)
+		{
+			continue;
+		}
+
+		int count = SDL_min(frames, voice.sound->frames - voice.position);
+		const float* samples = &voice.sound->samples[voice.position * 2];
+#ifdef MIXER_USE_SSE2
+		if (mKernel == MIXER_SSE2)
+		{
+			mixVoiceSSE2(out, samples, count, voice.gainLeft, voice.gainRight);
+		}
+		else
+#endif
+		{
+			mixVoiceScalar(out, samples, count, voice.gainLeft, voice.gainRight);
+		}
+
+		voice.position += count;
+		if (voice.position >= voice.sound->frames)
+		{
+			voice.sound = NULL;
+		}
+		++activeVoices;
+	}
+
+	//Loud pileups clip instead of wrapping
+#ifdef MIXER_USE_SSE2
+	if (mKernel == MIXER_SSE2)
+	{
+		clampSSE2(out, frames * 2);
+	}
+	else
+#endif
+	{
+		clampScalar(out, frames * 2);
+	}
+
+	//Publish, the callback is the only writer so plain loads and stores are enough
+	Uint64 ticks = SDL_GetPerformanceCounter() - start;
+	mCallbackTicks.store(mCallbackTicks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+	if (ticks > mPeakCallbackTicks.load(std::memory_order_relaxed))
+	{
+		mPeakCallbackTicks.store(ticks, std::memory_order_relaxed);
+	}
+	mActiveVoices.store(activeVoices, std::memory_order_relaxed);
+	mCallbacks.store(mCallbacks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void SDLCALL AudioMixer::audioCallback(void* userdata, Uint8* stream, int length)
+{
+	((AudioMixer*)userdata)->mix((float*)stream, length / (int)(sizeof(float) * 2));
+}
+
+void AudioMixer::getStats(AudioStats* stats)
+{
+	stats->callbacks = mCallbacks.load(std::memory_order_acquire);
+	stats->underruns = mUnderruns.load(std::memory_order_relaxed);
+	stats->callbackTicks = mCallbackTicks.load(std::memory_order_relaxed);
+	stats->peakCallbackTicks = mPeakCallbackTicks.load(std::memory_order_relaxed);
+	stats->activeVoices = mActiveVoices.load(std::memory_order_relaxed);
+}
+
+int AudioMixer::getDroppedCommands()
+{
+	return mDroppedCommands;
+}
+
+int AudioMixer::getFrequency()
+{
+	return mFrequency;
+}
+
+int AudioMixer::getBufferFrames()
+{
+	return mBufferFrames;
+}
+
+bool runSelfTest(const char* driver)
+{
+	bool success = true;
+
+	//Scalar and SSE2 mix the same voices into buffers that must match exactly
+	AudioMixer mixers[MIXER_TOTAL];
+	std::vector<float> outputs[MIXER_TOTAL];
+	for (int kernel = 0; kernel < MIXER_TOTAL; ++kernel)
+	{
+		if (!isMixerKernelSupported(kernel))
+		{
+			printf("%s: not supported here, skipped\n", MIXER_KERNEL_NAMES[kernel]);
+			continue;
+		}
+
+		AudioMixer& mixer = mixers[kernel];
+		mixer.openOffline(MIXER_FREQUENCY, MIXER_BUFFER_FRAMES);
+		mixer.setKernel((MixerKernel)kernel);
+		const AudioSound* sounds[SOUND_TOTAL];
+		for (int i = 0; i < SOUND_TOTAL; ++i)
+		{
+			sounds[i] = mixer.loadSound(SOUND_PATHS[i]);
+			if (sounds[i] == NULL)
+			{
+				return false;
+			}
+		}
+
+		//A new voice every few buffers, sometimes several, so voices overlap and get cut
+		outputs[kernel].resize(SELFTEST_BUFFERS * MIXER_BUFFER_FRAMES * 2);
+		Uint64 mixTicks = 0;
+		for (int buffer = 0; buffer < SELFTEST_BUFFERS; ++buffer)
+		{
+			for (int voice = 0; voice < buffer % 5; ++voice)
+			{
+				mixer.play(sounds[(buffer + voice) % SOUND_TOTAL], 0.8f, ((buffer * 7 + voice * 3) % 21 - 10) / 10.0f);
+			}
+			Uint64 start = SDL_GetPerformanceCounter();
+			mixer.mix(&outputs[kernel][buffer * MIXER_BUFFER_FRAMES * 2], MIXER_BUFFER_FRAMES);
+			mixTicks += SDL_GetPerformanceCounter() - start;
+		}
+		printf("%s: %.2f us per %d frame buffer\n", MIXER_KERNEL_NAMES[kernel], mixTicks * 1000000.0 / SDL_GetPerformanceFrequency() / SELFTEST_BUFFERS, MIXER_BUFFER_FRAMES);
+	}
+	if (!outputs[MIXER_SSE2].empty())
+	{
+		int mismatches = 0;
+		for (size_t i = 0; i < outputs[MIXER_SCALAR].size(); ++i)
+		{
+			mismatches += outputs[MIXER_SCALAR][i] != outputs[MIXER_SSE2][i] ? 1 : 0;
+		}
+		printf("SSE2 %s scalar (%d of %d samples differ)\n", mismatches == 0 ? "matches" : "DIFFERS from", mismatches, (int)outputs[MIXER_SCALAR].size());
+		success = success && mismatches == 0;
+	}
+
+	//With nobody draining it the ring takes exactly its capacity, then turns commands away
+	AudioMixer ringMixer;
+	ringMixer.openOffline(MIXER_FREQUENCY, MIXER_BUFFER_FRAMES);
+	int accepted = 0;
+	for (int i = 0; i < AUDIO_COMMAND_CAPACITY + 10; ++i)
+	{
+		accepted += ringMixer.resetPeak() ? 1 : 0;
+	}
+	std::vector<float> scratch(MIXER_BUFFER_FRAMES * 2);
+	ringMixer.mix(&scratch[0], MIXER_BUFFER_FRAMES);
+	bool drained = ringMixer.resetPeak();
+	bool ringHeld = accepted == AUDIO_COMMAND_CAPACITY && ringMixer.getDroppedCommands() == 10 && drained;
+	printf("Command ring %s (%d accepted, %d dropped, %s after a mix)\n", ringHeld ? "holds" : "BROKEN", accepted, ringMixer.getDroppedCommands(), drained ? "accepting" : "still full");
+	success = success && ringHeld;
+
+	//A real device on the requested driver, "dummy" and "disk" need no sound card
+	if (SDL_AudioInit(driver) < 0)
+	{
+		printf("Unable to start the %s audio driver! SDL Error: %s\n", driver, SDL_GetError());
+		return false;
+	}
+
+	AudioMixer mixer;
+	if (!mixer.open(MIXER_FREQUENCY, MIXER_BUFFER_FRAMES))
+	{
+		SDL_AudioQuit();
+		return false;
+	}
+	const AudioSound* sounds[SOUND_TOTAL];
+	for (int i = 0; i < SOUND_TOTAL; ++i)
+	{
+		sounds[i] = mixer.loadSound(SOUND_PATHS[i]);
+	}
+
+	//Keep it busy from this thread the way a game would
+	Uint32 startTicks = SDL_GetTicks();
+	for (int i = 0; SDL_GetTicks() - startTicks < (Uint32)SELFTEST_DEVICE_MS; ++i)
+	{
+		mixer.play(sounds[i % SOUND_TOTAL], 0.5f, 0.0f);
+		SDL_Delay(20);
+	}
+
+	AudioStats stats;
+	mixer.getStats(&stats);
+	double frequency = (double)SDL_GetPerformanceFrequency();
+	printf("%s driver: %d Hz, %d frame buffers, %u callbacks, %.2f us average, %.2f us peak, %u underruns, %d dropped commands\n",
+		SDL_GetCurrentAudioDriver(), mixer.getFrequency(), mixer.getBufferFrames(), stats.callbacks,
+		stats.callbacks > 0 ? stats.callbackTicks * 1000000.0 / frequency / stats.callbacks : 0.0,
+		stats.peakCallbackTicks * 1000000.0 / frequency, stats.underruns, mixer.getDroppedCommands());
+	success = success && stats.callbacks > 0;
+
+	mixer.close();
+	SDL_AudioQuit();
+	return success;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Open the output device
+				if (!gMixer.open(MIXER_FREQUENCY, MIXER_BUFFER_FRAMES))
+				{
+					printf("Audio mixer could not be opened!\n");
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load sound effects
+	for (int i = 0; i < SOUND_TOTAL; ++i)
+	{
+		gSounds[i] = gMixer.loadSound(SOUND_PATHS[i]);
+		if (gSounds[i] == NULL)
+		{
+			printf("Failed to load sound effect %s!\n", SOUND_PATHS[i]);
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Stop the callback and free the sounds
+	gMixer.close();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"selftest [driver]" checks the mixer without a window, on the dummy driver unless told otherwise
+	if (argc >= 2 && strcmp(args[1], "selftest") == 0)
+	{
+		if (SDL_Init(0) < 0)
+		{
+			printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+			return 1;
+		}
+		bool passed = runSelfTest(argc >= 3 ? args[2] : "dummy");
+		SDL_Quit();
+		return passed ? 0 : 1;
+	}
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Sounds pan toward the mouse
+			float pan = 0.0f;
+			MixerKernel kernel = isMixerKernelSupported(MIXER_SSE2) ? MIXER_SSE2 : MIXER_SCALAR;
+
+			//Callback counters at the last title update
+			Uint32 titleTicks = SDL_GetTicks();
+			AudioStats lastStats;
+			gMixer.getStats(&lastStats);
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_MOUSEMOTION)
+					{
+						pan = e.motion.x * 2.0f / SCREEN_WIDTH - 1.0f;
+					}
+					else if (e.type == SDL_KEYDOWN)
+					{
+						switch (e.key.keysym.sym)
+						{
+							//1-4 play the sounds
+							case SDLK_1: gMixer.play(gSounds[SOUND_HIGH], 0.8f, pan); break;
+							case SDLK_2: gMixer.play(gSounds[SOUND_MEDIUM], 0.8f, pan); break;
+							case SDLK_3: gMixer.play(gSounds[SOUND_LOW], 0.8f, pan); break;
+							case SDLK_4: gMixer.play(gSounds[SOUND_SCRATCH], 0.8f, pan); break;
+
+							//Space starts a burst of voices across the stereo field
+							case SDLK_SPACE:
+							for (int i = 0; i < BURST_VOICES; ++i)
+							{
+								gMixer.play(gSounds[i % SOUND_TOTAL], 0.3f, i * 2.0f / (BURST_VOICES - 1) - 1.0f);
+							}
+							break;
+
+							//0 stops everything
+							case SDLK_0:
+							gMixer.stopAll();
+							break;
+
+							//Tab switches kernels
+							case SDLK_TAB:
+							do
+							{
+								kernel = (MixerKernel)((kernel + 1) % MIXER_TOTAL);
+							} while (!isMixerKernelSupported(kernel));
+							gMixer.setKernel(kernel);
+							break;
+						}
+					}
+				}
+
+				//Show the kernel, voices and what the callback costs
+				Uint32 ticks = SDL_GetTicks();
+				if (ticks - titleTicks >= 1000)
+				{
+					AudioStats stats;
+					gMixer.getStats(&stats);
+					Uint32 callbacks = stats.callbacks - lastStats.callbacks;
+					double frequency = (double)SDL_GetPerformanceFrequency();
+					char title[160];
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s mixer: %d voices, callback %.1f us avg %.1f us peak, %u underruns, %d dropped",
+						MIXER_KERNEL_NAMES[kernel], stats.activeVoices,
+						callbacks > 0 ? (stats.callbackTicks - lastStats.callbackTicks) * 1000000.0 / frequency / callbacks : 0.0,
+						stats.peakCallbackTicks * 1000000.0 / frequency, stats.underruns, gMixer.getDroppedCommands());
+					SDL_SetWindowTitle(gWindow, title);
+					titleTicks = ticks;
+					lastStats = stats;
+					gMixer.resetPeak();
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//A bar per voice slot lights up while it plays
+				AudioStats stats;
+				gMixer.getStats(&stats);
+				SDL_Rect bar = { 20, SCREEN_HEIGHT - 40, (SCREEN_WIDTH - 40) / MAX_VOICES - 2, 20 };
+				SDL_SetRenderDrawColor(gRenderer, 0x00, 0x80, 0xFF, 0xFF);
+				for (int i = 0; i < stats.activeVoices; ++i)
+				{
+					SDL_RenderFillRect(gRenderer, &bar);
+					bar.x += bar.w + 2;
+				}
+
+				//The pan position
+				SDL_Rect marker = { (int)((pan + 1.0f) * 0.5f * (SCREEN_WIDTH - 10)), SCREEN_HEIGHT / 2 - 5, 10, 10 };
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0x00, 0x00, 0xFF);
+				SDL_RenderFillRect(gRenderer, &marker);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,606 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// screen size
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+// frame caps the pacing can cycle through, 0 is uncapped
+const int TOTAL_FRAME_CAPS = 3;
+const int FRAME_CAPS[TOTAL_FRAME_CAPS] = { 60, 30, 0 };
+
+// how far the presented frame can trail the frame that handled the input, like a render thread running behind
+const int MAX_FRAMES_IN_FLIGHT = 3;
+
+// simulated frame work the pacing can cycle through, in milliseconds
+const int TOTAL_WORK_STEPS = 3;
+const int WORK_STEPS[TOTAL_WORK_STEPS] = { 0, 5, 10 };
+
+// one millisecond per bucket, the last one holds everything slower
+const int LATENCY_BUCKETS = 128;
+
+// the fake typist presses a key every this many milliseconds, give or take
+const int TYPIST_MIN_DELAY = 20;
+const int TYPIST_MAX_DELAY = 80;
+
+// how long the benchmark runs each pacing
+const Uint32 BENCHMARK_TICKS = 3000;
+
+// key press surface constants
+enum KeyPressSurfaces {
+	KEY_PRESS_SURFACE_DEFAULT,
+	KEY_PRESS_SURFACE_UP,
+	KEY_PRESS_SURFACE_DOWN,
+	KEY_PRESS_SURFACE_LEFT,
+	KEY_PRESS_SURFACE_RIGHT,
+	KEY_PRESS_SURFACE_TOTAL
+};
+
+// input kinds that get their own histogram
+enum LatencyKind {
+	LATENCY_KEY,
+	LATENCY_MOUSE_BUTTON,
+	LATENCY_KIND_TOTAL
+};
+
+// names used in the title and the reports
+const char* LATENCY_KIND_NAMES[LATENCY_KIND_TOTAL] = { "key", "mouse button" };
+
+// how the main loop paces itself
+struct PacingSettings {
+	int frameCap;
+	int framesInFlight;
+	int work;
+};
+
+// Counts latencies in one millisecond buckets
+class LatencyHistogram {
+	public:
+		// initialize variables
+		LatencyHistogram();
+
+		// adds one latency in microseconds
+		void add(Uint32 microseconds);
+
+		// forgets everything added
+		void clear();
+
+		// number of latencies added
+		int getCount();
+
+		// milliseconds under which this fraction of the latencies fall, rounded up to the bucket edge
+		int getPercentile(double fraction);
+
+		// mean and slowest, in milliseconds
+		double getMean();
+		double getMax();
+
+		// prints the summary and a bar per bucket in use
+		void print(const char* name);
+
+	private:
+		Uint32 mBuckets[LATENCY_BUCKETS];
+		int mCount;
+		Uint64 mTotal;
+		Uint32 mMax;
+};
+
+// Follows input events from the moment SDL queued them until the frame showing their effect is presented.
+// SDL stamps an event when it enters its queue, for OS input that's when the loop pumps,
+// so time spent in the OS before that isn't seen. Presenting is as far as we can see, not the photons themselves.
+class LatencyTracker {
+	public:
+		// notes an input event as it's polled, frame is the one whose state it changes
+		void onEvent(const SDL_Event& e, Uint32 frame);
+
+		// closes every pending event the just presented frame reflects
+		void onPresent(Uint32 frame);
+
+		// event timestamp to present, per input kind
+		LatencyHistogram& getHistogram(LatencyKind kind);
+
+		// the two halves for all kinds: waiting in the queue, and polled to presented
+		LatencyHistogram& getQueuedHistogram();
+		LatencyHistogram& getPipelineHistogram();
+
+		// forgets everything, pending events included
+		void clear();
+
+		// prints every histogram
+		void print();
+
+	private:
+		// an event waiting for its frame to be presented
+		struct PendingInput {
+			LatencyKind kind;
+			Uint32 frame;
+			Uint32 queuedMicroseconds;
+			Uint64 pollCounter;
+		};
+
+		vector<PendingInput> mPending;
+		LatencyHistogram mTotal[LATENCY_KIND_TOTAL];
+		LatencyHistogram mQueued;
+		LatencyHistogram mPipeline;
+};
+
+// Starts up SDL and creates a window
+bool init(bool hidden);
+
+// Loads media
+bool loadMedia();
+
+// Frees media and shuts down SDL
+void close();
+
+// Runs the main loop until the user quits, or for runTicks when it isn't 0. Returns false if the user quit.
+bool runLoop(PacingSettings& settings, LatencyTracker& tracker, Uint32 runTicks);
+
+// Pushes arrow key presses at random moments until told to stop, so input lands mid-frame the way a player's does
+int typistThread(void* data);
+
+// Starts and stops the typist
+void startTypist();
+void stopTypist();
+
+// Formats the pacing for titles and reports
+void describePacing(const PacingSettings& settings, char* text, size_t size);
+
+// Global variables:
+
+// Loads individual image
+SDL_Surface* loadSurface(string path);
+
+// The window we will be drawing to
+SDL_Window* gWindow = NULL;
+
+// The surface we will be adding to the window to draw to
+SDL_Surface* gScreenSurface = NULL;
+
+// The images that correspond to a keypress
+SDL_Surface* gKeyPressSurfaces[KEY_PRESS_SURFACE_TOTAL];
+
+// The typist and its stop flag
+SDL_Thread* gTypist = NULL;
+atomic<bool> gTypistRunning(false);
+
+// implementation of LatencyHistogram class
+LatencyHistogram::LatencyHistogram() {
+	clear();
+}
+
+void LatencyHistogram::add(Uint32 microseconds) {
+	int bucket = SDL_min((int)(microseconds / 1000), LATENCY_BUCKETS - 1);
+	++mBuckets[bucket];
+	++mCount;
+	mTotal += microseconds;
+	mMax = SDL_max(mMax, microseconds);
+}
+
+void LatencyHistogram::clear() {
+	memset(mBuckets, 0, sizeof(mBuckets));
+	mCount = 0;
+	mTotal = 0;
+	mMax = 0;
+}
+
+int LatencyHistogram::getCount() {
+	return mCount;
+}
+
+int LatencyHistogram::getPercentile(double fraction) {
+	if (mCount == 0) {
+		return 0;
+	}
+
+	// walk the buckets until enough latencies are behind us
+	Uint32 needed = (Uint32)(fraction * mCount + 0.5);
+	Uint32 seen = 0;
+	for (int i = 0; i < LATENCY_BUCKETS; ++i) {
+		seen += mBuckets[i];
+		if (seen >= needed && seen > 0) {
+			return i + 1;
+		}
+	}
+	return LATENCY_BUCKETS;
+}
+
+double LatencyHistogram::getMean() {
+	return mCount > 0 ? mTotal / 1000.0 / mCount : 0.0;
+}
+
+double LatencyHistogram::getMax() {
+	return mMax / 1000.0;
+}
+
+void LatencyHistogram::print(const char* name) {
+	printf("%s: %d events, mean %.2f ms, p50 %d ms, p95 %d ms, p99 %d ms, max %.2f ms\n", name, mCount, getMean(), getPercentile(0.50), getPercentile(0.95), getPercentile(0.99), getMax());
+	if (mCount == 0) {
+		return;
+	}
+
+	// bars scaled to the busiest bucket
+	Uint32 busiest = 0;
+	int last = 0;
+	for (int i = 0; i < LATENCY_BUCKETS; ++i) {
+		busiest = SDL_max(busiest, mBuckets[i]);
+		if (mBuckets[i] > 0) {
+			last = i;
+		}
+	}
+	for (int i = 0; i <= last; ++i) {
+		char bar[41];
+		int length = (int)((Uint64)mBuckets[i] * 40 / busiest);
+		memset(bar, '#', length);
+		bar[length] = '\0';
+		if (i == LATENCY_BUCKETS - 1) {
+			printf("  >=%3d ms %6u %s\n", i, (unsigned)mBuckets[i], bar);
+		}
+		else {
+			printf("  < %3d ms %6u %s\n", i + 1, (unsigned)mBuckets[i], bar);
+		}
+	}
+}
+
+// implementation of LatencyTracker class
+void LatencyTracker::onEvent(const SDL_Event& e, Uint32 frame) {
+	PendingInput input;
+	if (e.type == SDL_KEYDOWN) {
+		input.kind = LATENCY_KEY;
+	}
+	else if (e.type == SDL_MOUSEBUTTONDOWN) {
+		input.kind = LATENCY_MOUSE_BUTTON;
+	}
+	else {
+		return;
+	}
+
+	// the queued half only has SDL's millisecond timestamps, the rest is timed with the performance counter
+	Uint32 now = SDL_GetTicks();
+	input.frame = frame;
+	input.queuedMicroseconds = (now - e.common.timestamp) * 1000;
+	input.pollCounter = SDL_GetPerformanceCounter();
+	mPending.push_back(input);
+}
+
+void LatencyTracker::onPresent(Uint32 frame) {
+	Uint64 now = SDL_GetPerformanceCounter();
+	Uint64 frequency = SDL_GetPerformanceFrequency();
+
+	// pending events are in frame order, everything up to the presented frame is done
+	size_t done = 0;
+	while (done < mPending.size() && (Sint32)(mPending[done].frame - frame) <= 0) {
+		const PendingInput& input = mPending[done];
+		Uint32 pipeline = (Uint32)((now - input.pollCounter) * 1000000 / frequency);
+		mQueued.add(input.queuedMicroseconds);
+		mPipeline.add(pipeline);
+		mTotal[input.kind].add(input.queuedMicroseconds + pipeline);
+		++done;
+	}
+	mPending.erase(mPending.begin(), mPending.begin() + done);
+}
+
+LatencyHistogram& LatencyTracker::getHistogram(LatencyKind kind) {
+	return mTotal[kind];
+}
+
+LatencyHistogram& LatencyTracker::getQueuedHistogram() {
+	return mQueued;
+}
+
+LatencyHistogram& LatencyTracker::getPipelineHistogram() {
+	return mPipeline;
+}
+
+void LatencyTracker::clear() {
+	mPending.clear();
+	for (int i = 0; i < LATENCY_KIND_TOTAL; ++i) {
+		mTotal[i].clear();
+	}
+	mQueued.clear();
+	mPipeline.clear();
+}
+
+void LatencyTracker::print() {
+	for (int i = 0; i < LATENCY_KIND_TOTAL; ++i) {
+		char name[64];
+		SDL_snprintf(name, sizeof(name), "%s to present", LATENCY_KIND_NAMES[i]);
+		mTotal[i].print(name);
+	}
+	mQueued.print("queued to polled");
+	mPipeline.print("polled to present");
+}
+
+int typistThread(void* data) {
+	while (gTypistRunning.load()) {
+		SDL_Delay(TYPIST_MIN_DELAY + rand() % (TYPIST_MAX_DELAY - TYPIST_MIN_DELAY + 1));
+
+		// SDL_PushEvent stamps the event with the time it was pushed
+		const SDL_Keycode keys[4] = { SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RIGHT };
+		SDL_Event e;
+		SDL_zero(e);
+		e.type = SDL_KEYDOWN;
+		e.key.state = SDL_PRESSED;
+		e.key.keysym.sym = keys[rand() % 4];
+		SDL_PushEvent(&e);
+	}
+	return 0;
+}
+
+void startTypist() {
+	if (gTypist == NULL) {
+		gTypistRunning.store(true);
+		gTypist = SDL_CreateThread(typistThread, "Typist", NULL);
+		if (gTypist == NULL) {
+			printf("Unable to start the typist! SDL Error: %s\n", SDL_GetError());
+			gTypistRunning.store(false);
+		}
+	}
+}
+
+void stopTypist() {
+	if (gTypist != NULL) {
+		gTypistRunning.store(false);
+		SDL_WaitThread(gTypist, NULL);
+		gTypist = NULL;
+	}
+}
+
+void describePacing(const PacingSettings& settings, char* text, size_t size) {
+	char cap[16];
+	if (FRAME_CAPS[settings.frameCap] > 0) {
+		SDL_snprintf(cap, sizeof(cap), "%d fps", FRAME_CAPS[settings.frameCap]);
+	}
+	else {
+		SDL_snprintf(cap, sizeof(cap), "uncapped");
+	}
+	SDL_snprintf(text, size, "%s, %d in flight, %d ms work", cap, settings.framesInFlight, WORK_STEPS[settings.work]);
+}
+
+bool runLoop(PacingSettings& settings, LatencyTracker& tracker, Uint32 runTicks) {
+	// Event handler- it handles events like key presses, mouse motion, joy button presses, etc.
+	SDL_Event e;
+
+	// the picture each recent frame decided on, the one presented trails by the frames in flight
+	int frameSurfaces[MAX_FRAMES_IN_FLIGHT + 1];
+	for (int i = 0; i <= MAX_FRAMES_IN_FLIGHT; i++) {
+		frameSurfaces[i] = KEY_PRESS_SURFACE_DEFAULT;
+	}
+	int currentSurface = KEY_PRESS_SURFACE_DEFAULT;
+
+	Uint32 frame = 0;
+	Uint32 startTicks = SDL_GetTicks();
+	Uint32 titleTicks = startTicks;
+
+	// While the application runs; initiating the game loop
+	while (runTicks == 0 || SDL_GetTicks() - startTicks < runTicks) {
+		Uint32 frameStart = SDL_GetTicks();
+
+		// handles events on the *event queue*, every input is tagged with the frame it lands in
+		while (SDL_PollEvent(&e) != 0) {
+			tracker.onEvent(e, frame);
+
+			// User requests to quit by pressing the X button outside the window.
+			if (e.type == SDL_QUIT) {
+				return false;
+			}
+			// User presses a keyboard key
+			else if (e.type == SDL_KEYDOWN) {
+				// arrows pick the picture, the rest change the pacing
+				switch (e.key.keysym.sym) {
+					case SDLK_UP:
+						currentSurface = KEY_PRESS_SURFACE_UP;
+						break;
+					case SDLK_DOWN:
+						currentSurface = KEY_PRESS_SURFACE_DOWN;
+						break;
+					case SDLK_LEFT:
+						currentSurface = KEY_PRESS_SURFACE_LEFT;
+						break;
+					case SDLK_RIGHT:
+						currentSurface = KEY_PRESS_SURFACE_RIGHT;
+						break;
+					case SDLK_f:
+						settings.frameCap = (settings.frameCap + 1) % TOTAL_FRAME_CAPS;
+						break;
+					case SDLK_d:
+						settings.framesInFlight = (settings.framesInFlight + 1) % (MAX_FRAMES_IN_FLIGHT + 1);
+						break;
+					case SDLK_w:
+						settings.work = (settings.work + 1) % TOTAL_WORK_STEPS;
+						break;
+					case SDLK_t:
+						if (gTypist == NULL) {
+							startTypist();
+						}
+						else {
+							stopTypist();
+						}
+						break;
+					case SDLK_h:
+						tracker.print();
+						break;
+					case SDLK_r:
+						tracker.clear();
+						break;
+					default:
+						currentSurface = KEY_PRESS_SURFACE_DEFAULT;
+						break;
+				}
+			}
+		}
+		frameSurfaces[frame % (MAX_FRAMES_IN_FLIGHT + 1)] = currentSurface;
+
+		// stand-in for the frame's real work
+		if (WORK_STEPS[settings.work] > 0) {
+			SDL_Delay(WORK_STEPS[settings.work]);
+		}
+
+		// apply the image of the frame being presented, frames before the first show the default
+		Uint32 presented = frame - settings.framesInFlight;
+		bool hasPresented = frame >= (Uint32)settings.framesInFlight;
+		int surface = hasPresented ? frameSurfaces[presented % (MAX_FRAMES_IN_FLIGHT + 1)] : KEY_PRESS_SURFACE_DEFAULT;
+		SDL_BlitSurface(gKeyPressSurfaces[surface], NULL, gScreenSurface, NULL);
+
+		// Always need to update surface to see the image on the screen, the events it shows are done once it returns
+		SDL_UpdateWindowSurface(gWindow);
+		if (hasPresented) {
+			tracker.onPresent(presented);
+		}
+
+		// key latency and pacing in the title once a second
+		Uint32 ticks = SDL_GetTicks();
+		if (runTicks == 0 && ticks - titleTicks >= 1000) {
+			char pacing[64];
+			char title[192];
+			LatencyHistogram& keys = tracker.getHistogram(LATENCY_KEY);
+			describePacing(settings, pacing, sizeof(pacing));
+			SDL_snprintf(title, sizeof(title), "SDL_Tutorial_2 - %s%s: %d keys, p50 %d ms, p95 %d ms, p99 %d ms, max %.1f ms", pacing, gTypist != NULL ? ", typist" : "", keys.getCount(), keys.getPercentile(0.50), keys.getPercentile(0.95), keys.getPercentile(0.99), keys.getMax());
+			SDL_SetWindowTitle(gWindow, title);
+			titleTicks = ticks;
+		}
+
+		// hold the frame rate
+		if (FRAME_CAPS[settings.frameCap] > 0) {
+			Uint32 frameTicks = 1000 / FRAME_CAPS[settings.frameCap];
+			Uint32 elapsed = SDL_GetTicks() - frameStart;
+			if (elapsed < frameTicks) {
+				SDL_Delay(frameTicks - elapsed);
+			}
+		}
+
+		++frame;
+	}
+
+	return true;
+}
+
+bool init(bool hidden) {
+	// Initialization flag; this will be returned as it is if everything is successful
+	bool success = true;
+
+	// Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else {
+		// Create window, the benchmark keeps it hidden so nothing on the desktop can interfere
+		gWindow = SDL_CreateWindow("SDL_Tutorial_2", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
+		if (gWindow == NULL) {
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else {
+			// Get the window surface
+			gScreenSurface = SDL_GetWindowSurface(gWindow);
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia() {
+	// Loading succes flag
+	bool success = true;
+
+	// the files for each key, in KeyPressSurfaces order
+	const char* paths[KEY_PRESS_SURFACE_TOTAL] = { "Images/press.bmp", "Images/up.bmp", "Images/down.bmp", "Images/left.bmp", "Images/right.bmp" };
+
+	for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; i++) {
+		gKeyPressSurfaces[i] = loadSurface(paths[i]);
+		if (gKeyPressSurfaces[i] == NULL) {
+			printf("Failed to load %s!\n", paths[i]);
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+
+void close() {
+	// Stop the typist before the event queue goes away
+	stopTypist();
+
+	// Deallocate surfaces
+	for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; i++) {
+		SDL_FreeSurface(gKeyPressSurfaces[i]);
+		gKeyPressSurfaces[i] = NULL;
+	}
+
+	// Destroy window
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+
+	// Quit SDL subsystems
+	SDL_Quit();
+}
+
+// generalized function to load a surface in the future
+SDL_Surface* loadSurface(string path) {
+	// Load image at specified path
+	SDL_Surface* loadedSurface = SDL_LoadBMP(path.c_str());
+	if (loadedSurface == NULL) {
+		printf("Unable to load image %s! SDL Error: %s", path.c_str(), SDL_GetError());
+	}
+
+	return loadedSurface;
+}
+
+int main(int argc, char* args[]) {
+	// "benchmark" runs the typist against each pacing in a hidden window and prints the histograms
+	bool benchmark = argc >= 2 && strcmp(args[1], "benchmark") == 0;
+
+	if (!init(benchmark)) {
+		printf("Cannot initialize!");
+	}
+	else {
+		if (!loadMedia()) {
+			printf("Cannot load media!");
+		}
+		else {
+			LatencyTracker tracker;
+			PacingSettings settings = { 0, 0, 0 };
+
+			if (benchmark) {
+				// the same typing against every cap, with and without a trailing render
+				startTypist();
+				const int inFlight[2] = { 0, 2 };
+				bool quit = false;
+				for (int cap = 0; cap < TOTAL_FRAME_CAPS && !quit; cap++) {
+					for (int i = 0; i < 2 && !quit; i++) {
+						settings.frameCap = cap;
+						settings.framesInFlight = inFlight[i];
+						settings.work = 1;
+						tracker.clear();
+						quit = !runLoop(settings, tracker, BENCHMARK_TICKS);
+
+						char pacing[64];
+						describePacing(settings, pacing, sizeof(pacing));
+						printf("== %s ==\n", pacing);
+						tracker.print();
+					}
+				}
+				stopTypist();
+			}
+			else {
+				// F cycles the frame cap, D the frames in flight, W the work, T the typist, H prints, R resets
+				runLoop(settings, tracker, 0);
+				tracker.print();
+			}
+		}
+	}
+
+	// Free resources and close SDL
+	close();
+
+	return 0;
+}
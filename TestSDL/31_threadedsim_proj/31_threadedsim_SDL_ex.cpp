@@ -0,0 +1,917 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, SDL_thread, standard IO, strings, atomics, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_thread.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <atomic>
+#include <vector>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//The simulation steps at a fixed rate whichever thread runs it
+const int SIMULATION_HZ = 60;
+
+//Steps the single threaded loop will catch up in one frame before it gives up on real time
+const int MAX_STEPS_PER_FRAME = 4;
+
+//Sprite counts, up/down doubles/halves between these
+const int DEFAULT_SPRITES = 256;
+const int MIN_SPRITES = 16;
+const int MAX_SPRITES = 16384;
+
+//Sprites are drawn at this size in the main view
+const int SPRITE_WIDTH = 32;
+const int SPRITE_HEIGHT = 64;
+
+//Slow update and slow render stand-ins the keys cycle through, in milliseconds
+const int TOTAL_WORK_STEPS = 4;
+const int WORK_STEPS[TOTAL_WORK_STEPS] = { 0, 10, 30, 60 };
+
+//How long the self test hammers the snapshot buffer
+const Uint32 SELFTEST_TICKS = 1000;
+
+//Textures a snapshot can refer to
+enum TextureId
+{
+	TEXTURE_FOO,
+	TEXTURE_BACKGROUND,
+	TEXTURE_MINIMAP,
+	TEXTURE_TOTAL
+};
+
+const char* TEXTURE_PATHS[TEXTURE_TOTAL] = { "Images/foo.png", "Images/background.png", "Images/viewport.png" };
+
+//One textured quad, already transformed into its viewport
+struct SnapshotSprite
+{
+	int texture;
+	SDL_Rect dst;
+	double angle;
+	SDL_RendererFlip flip;
+};
+
+//A viewport and the run of sprites drawn in it
+struct SnapshotViewport
+{
+	SDL_Rect rect;
+	int firstSprite;
+	int spriteCount;
+};
+
+//Everything the renderer needs for a frame. Never changed once published.
+struct RenderSnapshot
+{
+	//Simulation step it was taken after, 0 before the first one
+	Uint32 sequence;
+
+	//Performance counter when it was published
+	Uint64 publishCounter;
+
+	std::vector<SnapshotViewport> viewports;
+	std::vector<SnapshotSprite> sprites;
+};
+
+//Lock-free triple buffer: the writer always has a snapshot to fill, the reader always has the newest one
+//and neither waits on the other. The third snapshot sits in between and the two swap with it.
+//The vectors keep their capacity as snapshots go round, so nothing is allocated once the counts settle.
+class SnapshotBuffer
+{
+	public:
+		//Initializes variables
+		SnapshotBuffer();
+
+		//Writer side: the snapshot to fill, it is the writer's until publish()
+		RenderSnapshot& getWriteSnapshot();
+
+		//Writer side: hands the filled snapshot over and takes back a free one
+		void publish();
+
+		//Reader side: swaps in the newest snapshot if there is one. Valid until the next acquire().
+		const RenderSnapshot& acquire(bool* fresh);
+
+		//Empties every snapshot, only while neither side is running
+		void reset();
+
+	private:
+		//Set on the middle index while it holds something the reader hasn't seen
+		static const int SNAPSHOT_FRESH = 4;
+
+		RenderSnapshot mSnapshots[3];
+		int mWriteIndex;
+		int mReadIndex;
+		std::atomic<int> mMiddle;
+};
+
+//A bouncing Foo'
+struct Sprite
+{
+	float x;
+	float y;
+	float velX;
+	float velY;
+};
+
+//The world. Owned by one thread at a time: the simulation thread while it runs, otherwise the main thread.
+class Simulation
+{
+	public:
+		//Initializes variables
+		Simulation();
+
+		//Changes how many sprites there are, new ones start somewhere random
+		void setSpriteCount(int count);
+
+		//Advances one fixed step
+		void step(float seconds);
+
+		//Writes what should be on screen after this step
+		void fillSnapshot(RenderSnapshot& snapshot);
+
+		//Gets steps run so far
+		Uint32 getStep();
+
+	private:
+		//Cheap random numbers in [0, 1)
+		float random();
+
+		std::vector<Sprite> mSprites;
+		Uint32 mStep;
+		Uint32 mRandom;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Runs the simulation at SIMULATION_HZ until told to stop
+int simulationThread(void* data);
+
+//Starts and stops the simulation thread, the world belongs to the main thread while it's stopped
+void startSimulationThread();
+void stopSimulationThread();
+
+//Applies the controls the main thread has set and runs one step, either thread
+void runSimulationStep();
+
+//Draws a snapshot, main thread only
+void renderSnapshot(const RenderSnapshot& snapshot);
+
+//Checks a reader never sees a torn or older snapshot while a writer publishes flat out
+bool runSelfTest();
+
+//Texture wrapper class
+class LTexture
+{
+	public:
+		//Initializes variables
+		LTexture();
+
+		//Deallocates memory
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture into a rect, rotated about its center and flipped
+		void render(const SDL_Rect& dst, double angle = 0.0, SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Textures by TextureId
+LTexture gTextures[TEXTURE_TOTAL];
+
+//The world and the snapshots it's seen through
+Simulation gSimulation;
+SnapshotBuffer gSnapshots;
+
+//The simulation thread and its stop flag
+SDL_Thread* gSimulationThread = NULL;
+std::atomic<bool> gSimulationRunning(false);
+
+//Controls the main thread sets and the simulation reads
+std::atomic<int> gSpriteTarget(DEFAULT_SPRITES);
+std::atomic<int> gUpdateWork(0);
+
+//Steps published, for the title
+std::atomic<Uint32> gPublishedSteps(0);
+
+
+SnapshotBuffer::SnapshotBuffer()
+{
+	//Initialize
+	reset();
+}
+
+RenderSnapshot& SnapshotBuffer::getWriteSnapshot()
+{
+	return mSnapshots[mWriteIndex];
+}
+
+void SnapshotBuffer::publish()
+{
+	//Release our writes with the snapshot, acquire the reader's last use of the one we get back
+	int previous = mMiddle.exchange(mWriteIndex | SNAPSHOT_FRESH, std::memory_order_acq_rel);
+	mWriteIndex = previous & ~SNAPSHOT_FRESH;
+}
+
+const RenderSnapshot& SnapshotBuffer::acquire(bool* fresh)
+{
+	*fresh = (mMiddle.load(std::memory_order_relaxed) & SNAPSHOT_FRESH) != 0;
+	if (*fresh)
+	{
+		int previous = mMiddle.exchange(mReadIndex, std::memory_order_acq_rel);
+		mReadIndex = previous & ~SNAPSHOT_FRESH;
+	}
+	return mSnapshots[mReadIndex];
+}
+
+void SnapshotBuffer::reset()
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		mSnapshots[i].sequence = 0;
+		mSnapshots[i].publishCounter = 0;
+		mSnapshots[i].viewports.clear();
+		mSnapshots[i].sprites.clear();
+	}
+	mWriteIndex = 0;
+	mMiddle.store(1);
+	mReadIndex = 2;
+}
+
+
+Simulation::Simulation()
+{
+	//Initialize
+	mStep = 0;
+	mRandom = 0x12345678;
+}
+
+void Simulation::setSpriteCount(int count)
+{
+	while ((int)mSprites.size() < count)
+	{
+		Sprite sprite;
+		sprite.x = random() * (SCREEN_WIDTH - SPRITE_WIDTH);
+		sprite.y = random() * (SCREEN_HEIGHT - SPRITE_HEIGHT);
+		sprite.velX = (random() - 0.5f) * 400.0f;
+		sprite.velY = (random() - 0.5f) * 400.0f;
+		mSprites.push_back(sprite);
+	}
+	mSprites.resize(count);
+}
+
+void Simulation::step(float seconds)
+{
+	//Bounce around the world, which is the size of the screen
+	for (size_t i = 0; i < mSprites.size(); ++i)
+	{
+		Sprite& sprite = mSprites[i];
+		sprite.x += sprite.velX * seconds;
+		sprite.y += sprite.velY * seconds;
+		if ((sprite.x < 0.0f && sprite.velX < 0.0f) || (sprite.x > SCREEN_WIDTH - SPRITE_WIDTH && sprite.velX > 0.0f))
+		{
+			sprite.velX = -sprite.velX;
+		}
+		if ((sprite.y < 0.0f && sprite.velY < 0.0f) || (sprite.y > SCREEN_HEIGHT - SPRITE_HEIGHT && sprite.velY > 0.0f))
+		{
+			sprite.velY = -sprite.velY;
+		}
+	}
+	++mStep;
+}
+
+void Simulation::fillSnapshot(RenderSnapshot& snapshot)
+{
+	snapshot.sequence = mStep;
+	snapshot.viewports.clear();
+	snapshot.sprites.clear();
+
+	//Full screen view: the background, then every Foo' facing the way it moves and leaning into it
+	SnapshotViewport main;
+	main.rect.x = 0;
+	main.rect.y = 0;
+	main.rect.w = SCREEN_WIDTH;
+	main.rect.h = SCREEN_HEIGHT;
+	main.firstSprite = (int)snapshot.sprites.size();
+	SnapshotSprite background = { TEXTURE_BACKGROUND, { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, 0.0, SDL_FLIP_NONE };
+	snapshot.sprites.push_back(background);
+	for (size_t i = 0; i < mSprites.size(); ++i)
+	{
+		const Sprite& sprite = mSprites[i];
+		SnapshotSprite foo = { TEXTURE_FOO, { (int)sprite.x, (int)sprite.y, SPRITE_WIDTH, SPRITE_HEIGHT }, sprite.velX * 0.05, sprite.velX < 0.0f ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE };
+		snapshot.sprites.push_back(foo);
+	}
+	main.spriteCount = (int)snapshot.sprites.size() - main.firstSprite;
+	snapshot.viewports.push_back(main);
+
+	//Quarter size minimap in the top right corner
+	SnapshotViewport minimap;
+	minimap.rect.x = SCREEN_WIDTH * 3 / 4 - 8;
+	minimap.rect.y = 8;
+	minimap.rect.w = SCREEN_WIDTH / 4;
+	minimap.rect.h = SCREEN_HEIGHT / 4;
+	minimap.firstSprite = (int)snapshot.sprites.size();
+	SnapshotSprite frame = { TEXTURE_MINIMAP, { 0, 0, minimap.rect.w, minimap.rect.h }, 0.0, SDL_FLIP_NONE };
+	snapshot.sprites.push_back(frame);
+	for (size_t i = 0; i < mSprites.size(); ++i)
+	{
+		const Sprite& sprite = mSprites[i];
+		SnapshotSprite dot = { TEXTURE_FOO, { (int)sprite.x / 4, (int)sprite.y / 4, SPRITE_WIDTH / 4, SPRITE_HEIGHT / 4 }, 0.0, SDL_FLIP_NONE };
+		snapshot.sprites.push_back(dot);
+	}
+	minimap.spriteCount = (int)snapshot.sprites.size() - minimap.firstSprite;
+	snapshot.viewports.push_back(minimap);
+}
+
+Uint32 Simulation::getStep()
+{
+	return mStep;
+}
+
+float Simulation::random()
+{
+	//xorshift32, top 24 bits as the fraction
+	mRandom ^= mRandom << 13;
+	mRandom ^= mRandom >> 17;
+	mRandom ^= mRandom << 5;
+	return (mRandom >> 8) * (1.0f / 16777216.0f);
+}
+
+
+LTexture::LTexture()
+{
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture()
+{
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path)
+{
+	//Get rid of preexisting texture
+	free();
+
+	//The final texture
+	SDL_Texture* newTexture = NULL;
+
+	//Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL)
+	{
+		printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else
+	{
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL)
+		{
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else
+		{
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	//Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free()
+{
+	//Free texture if it exists
+	if (mTexture != NULL)
+	{
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(const SDL_Rect& dst, double angle, SDL_RendererFlip flip)
+{
+	if (angle == 0.0 && flip == SDL_FLIP_NONE)
+	{
+		SDL_RenderCopy(gRenderer, mTexture, NULL, &dst);
+	}
+	else
+	{
+		SDL_RenderCopyEx(gRenderer, mTexture, NULL, &dst, angle, NULL, flip);
+	}
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+
+void runSimulationStep()
+{
+	gSimulation.setSpriteCount(gSpriteTarget.load(std::memory_order_relaxed));
+	gSimulation.step(1.0f / SIMULATION_HZ);
+
+	//Stand-in for an expensive update
+	int work = gUpdateWork.load(std::memory_order_relaxed);
+	if (work > 0)
+	{
+		SDL_Delay(work);
+	}
+
+	RenderSnapshot& snapshot = gSnapshots.getWriteSnapshot();
+	gSimulation.fillSnapshot(snapshot);
+	snapshot.publishCounter = SDL_GetPerformanceCounter();
+	gSnapshots.publish();
+	gPublishedSteps.fetch_add(1, std::memory_order_relaxed);
+}
+
+int simulationThread(void* data)
+{
+	//Fixed steps against the performance counter, falling behind by more than a step drops the time instead of racing
+	Uint64 period = SDL_GetPerformanceFrequency() / SIMULATION_HZ;
+	Uint64 next = SDL_GetPerformanceCounter();
+	while (gSimulationRunning.load(std::memory_order_relaxed))
+	{
+		runSimulationStep();
+
+		next += period;
+		Uint64 now = SDL_GetPerformanceCounter();
+		if (now < next)
+		{
+			SDL_Delay((Uint32)((next - now) * 1000 / SDL_GetPerformanceFrequency()));
+		}
+		else if (now - next > period)
+		{
+			next = now;
+		}
+	}
+	return 0;
+}
+
+void startSimulationThread()
+{
+	if (gSimulationThread == NULL)
+	{
+		gSimulationRunning.store(true);
+		gSimulationThread = SDL_CreateThread(simulationThread, "Simulation", NULL);
+		if (gSimulationThread == NULL)
+		{
+			printf("Unable to start the simulation thread! SDL Error: %s\n", SDL_GetError());
+			gSimulationRunning.store(false);
+		}
+	}
+}
+
+void stopSimulationThread()
+{
+	if (gSimulationThread != NULL)
+	{
+		gSimulationRunning.store(false);
+		SDL_WaitThread(gSimulationThread, NULL);
+		gSimulationThread = NULL;
+	}
+}
+
+void renderSnapshot(const RenderSnapshot& snapshot)
+{
+	for (size_t i = 0; i < snapshot.viewports.size(); ++i)
+	{
+		const SnapshotViewport& viewport = snapshot.viewports[i];
+		SDL_RenderSetViewport(gRenderer, &viewport.rect);
+		for (int j = viewport.firstSprite; j < viewport.firstSprite + viewport.spriteCount; ++j)
+		{
+			const SnapshotSprite& sprite = snapshot.sprites[j];
+			gTextures[sprite.texture].render(sprite.dst, sprite.angle, sprite.flip);
+		}
+	}
+	SDL_RenderSetViewport(gRenderer, NULL);
+}
+
+//Shared with the self test writer
+static std::atomic<bool> gSelfTestWriting(false);
+
+static int selfTestWriter(void* data)
+{
+	SnapshotBuffer* buffer = (SnapshotBuffer*)data;
+	Uint32 sequence = 0;
+	while (gSelfTestWriting.load(std::memory_order_relaxed))
+	{
+		//Every field of the snapshot says which sequence wrote it, and the sizes vary so the vectors move around
+		++sequence;
+		RenderSnapshot& snapshot = buffer->getWriteSnapshot();
+		snapshot.sequence = sequence;
+		snapshot.publishCounter = sequence;
+		snapshot.viewports.resize(sequence % 5 + 1);
+		snapshot.sprites.resize(sequence % 97 + 1);
+		for (size_t i = 0; i < snapshot.viewports.size(); ++i)
+		{
+			SnapshotViewport viewport = { { (int)sequence, (int)sequence, (int)sequence, (int)sequence }, (int)sequence, (int)sequence };
+			snapshot.viewports[i] = viewport;
+		}
+		for (size_t i = 0; i < snapshot.sprites.size(); ++i)
+		{
+			SnapshotSprite sprite = { (int)sequence, { (int)sequence, (int)sequence, (int)sequence, (int)sequence }, (double)sequence, SDL_FLIP_NONE };
+			snapshot.sprites[i] = sprite;
+		}
+		buffer->publish();
+	}
+	return (int)sequence;
+}
+
+bool runSelfTest()
+{
+	SnapshotBuffer buffer;
+	gSelfTestWriting.store(true);
+	SDL_Thread* writer = SDL_CreateThread(selfTestWriter, "SnapshotWriter", &buffer);
+	if (writer == NULL)
+	{
+		printf("Unable to start the writer thread! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	//Read flat out, every snapshot has to be whole and no older than the last one
+	Uint32 last = 0;
+	int reads = 0;
+	int fresh = 0;
+	int torn = 0;
+	int backwards = 0;
+	Uint32 start = SDL_GetTicks();
+	while (SDL_GetTicks() - start < SELFTEST_TICKS)
+	{
+		bool isFresh = false;
+		const RenderSnapshot& snapshot = buffer.acquire(&isFresh);
+		++reads;
+		fresh += isFresh ? 1 : 0;
+
+		Uint32 sequence = snapshot.sequence;
+		if (sequence < last)
+		{
+			++backwards;
+		}
+		last = sequence;
+		if (sequence == 0)
+		{
+			continue;
+		}
+
+		bool whole = snapshot.publishCounter == sequence && snapshot.viewports.size() == sequence % 5 + 1 && snapshot.sprites.size() == sequence % 97 + 1;
+		for (size_t i = 0; whole && i < snapshot.viewports.size(); ++i)
+		{
+			const SnapshotViewport& viewport = snapshot.viewports[i];
+			whole = viewport.rect.x == (int)sequence && viewport.rect.h == (int)sequence && viewport.spriteCount == (int)sequence;
+		}
+		for (size_t i = 0; whole && i < snapshot.sprites.size(); ++i)
+		{
+			const SnapshotSprite& sprite = snapshot.sprites[i];
+			whole = sprite.texture == (int)sequence && sprite.dst.x == (int)sequence && sprite.dst.h == (int)sequence && sprite.angle == (double)sequence;
+		}
+		torn += whole ? 0 : 1;
+	}
+
+	gSelfTestWriting.store(false);
+	int published = 0;
+	SDL_WaitThread(writer, &published);
+
+	bool success = torn == 0 && backwards == 0 && fresh > 0;
+	printf("Snapshot buffer %s: %d published, %d reads, %d fresh, %d torn, %d went backwards\n", success ? "holds" : "BROKEN", published, reads, fresh, torn, backwards);
+	return success;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create vsynced renderer for window, it stays on this thread
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load every texture a snapshot can name
+	for (int i = 0; i < TEXTURE_TOTAL; ++i)
+	{
+		if (!gTextures[i].loadFromFile(TEXTURE_PATHS[i]))
+		{
+			printf("Failed to load %s!\n", TEXTURE_PATHS[i]);
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+void close()
+{
+	//The simulation thread goes first, nothing can publish after this
+	stopSimulationThread();
+
+	//Free loaded images
+	for (int i = 0; i < TEXTURE_TOTAL; ++i)
+	{
+		gTextures[i].free();
+	}
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"selftest" checks the snapshot buffer between two threads, no window needed
+	if (argc >= 2 && strcmp(args[1], "selftest") == 0)
+	{
+		if (SDL_Init(0) < 0)
+		{
+			printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+			return 1;
+		}
+		bool passed = runSelfTest();
+		SDL_Quit();
+		return passed ? 0 : 1;
+	}
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Threaded whenever there's a second core to put it on
+			bool threaded = SDL_GetCPUCount() > 1;
+			int updateWork = 0;
+			int renderWork = 0;
+			if (threaded)
+			{
+				startSimulationThread();
+			}
+
+			//Single threaded stepping keeps its own clock
+			Uint64 frequency = SDL_GetPerformanceFrequency();
+			Uint64 period = frequency / SIMULATION_HZ;
+			Uint64 nextStep = SDL_GetPerformanceCounter();
+
+			//Title statistics over a second
+			Uint32 titleTicks = SDL_GetTicks();
+			Uint32 titleSteps = gPublishedSteps.load();
+			Uint32 lastSequence = 0;
+			int frames = 0;
+			int repeated = 0;
+			int skipped = 0;
+			double ageSeconds = 0.0;
+			int ageSamples = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue, input stays on this thread and reaches the simulation through the controls
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_KEYDOWN)
+					{
+						switch (e.key.keysym.sym)
+						{
+							//Up/down doubles/halves the sprites
+							case SDLK_UP:
+							gSpriteTarget.store(SDL_min(gSpriteTarget.load() * 2, MAX_SPRITES));
+							break;
+
+							case SDLK_DOWN:
+							gSpriteTarget.store(SDL_max(gSpriteTarget.load() / 2, MIN_SPRITES));
+							break;
+
+							//Tab switches between one thread and two, the world changes hands while the thread is stopped
+							case SDLK_TAB:
+							threaded = !threaded;
+							if (threaded)
+							{
+								startSimulationThread();
+							}
+							else
+							{
+								stopSimulationThread();
+								nextStep = SDL_GetPerformanceCounter();
+							}
+							break;
+
+							//U and R cycle a slow update and a slow render
+							case SDLK_u:
+							updateWork = (updateWork + 1) % TOTAL_WORK_STEPS;
+							gUpdateWork.store(WORK_STEPS[updateWork]);
+							break;
+
+							case SDLK_r:
+							renderWork = (renderWork + 1) % TOTAL_WORK_STEPS;
+							break;
+						}
+					}
+				}
+
+				//Without the thread the steps that are due run here, before the frame can be drawn
+				if (!threaded)
+				{
+					int steps = 0;
+					while (SDL_GetPerformanceCounter() >= nextStep && steps < MAX_STEPS_PER_FRAME)
+					{
+						runSimulationStep();
+						nextStep += period;
+						++steps;
+					}
+					if (steps == MAX_STEPS_PER_FRAME)
+					{
+						nextStep = SDL_GetPerformanceCounter();
+					}
+				}
+
+				//Newest snapshot, whichever thread made it
+				bool fresh = false;
+				const RenderSnapshot& snapshot = gSnapshots.acquire(&fresh);
+				if (!fresh)
+				{
+					++repeated;
+				}
+				else if (snapshot.sequence > lastSequence + 1 && lastSequence != 0)
+				{
+					skipped += snapshot.sequence - lastSequence - 1;
+				}
+				lastSequence = snapshot.sequence;
+				//Sequence 0 is the empty snapshot from before anything was published, it has no age
+				if (snapshot.sequence != 0)
+				{
+					ageSeconds += (double)(SDL_GetPerformanceCounter() - snapshot.publishCounter) / frequency;
+					++ageSamples;
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Draw what the snapshot says
+				renderSnapshot(snapshot);
+
+				//Stand-in for an expensive render
+				if (WORK_STEPS[renderWork] > 0)
+				{
+					SDL_Delay(WORK_STEPS[renderWork]);
+				}
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+				++frames;
+
+				//Show the mode, both rates and how stale the snapshots were
+				Uint32 ticks = SDL_GetTicks();
+				if (ticks - titleTicks >= 1000)
+				{
+					Uint32 steps = gPublishedSteps.load();
+					char title[192];
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s, %d sprites, update +%d ms, render +%d ms: %d fps, %u steps/s, %d repeated, %d skipped, %.1f ms old",
+						threaded ? "threaded" : "single thread", gSpriteTarget.load(), WORK_STEPS[updateWork], WORK_STEPS[renderWork],
+						frames, steps - titleSteps, repeated, skipped, ageSamples > 0 ? ageSeconds * 1000.0 / ageSamples : 0.0);
+					SDL_SetWindowTitle(gWindow, title);
+					titleTicks = ticks;
+					titleSteps = steps;
+					frames = 0;
+					repeated = 0;
+					skipped = 0;
+					ageSeconds = 0.0;
+					ageSamples = 0;
+				}
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
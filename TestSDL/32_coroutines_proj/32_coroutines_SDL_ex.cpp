@@ -0,0 +1,1207 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//The timing wheel: WHEEL_LEVELS wheels of WHEEL_SLOTS one millisecond ticks each, every slot of a level
+//spanning a whole turn of the level below. Four levels of 64 reach a bit over four and a half hours ahead.
+const int WHEEL_BITS = 6;
+const int WHEEL_SLOTS = 1 << WHEEL_BITS;
+const int WHEEL_MASK = WHEEL_SLOTS - 1;
+const int WHEEL_LEVELS = 4;
+const Uint64 WHEEL_RANGE = (Uint64)1 << (WHEEL_BITS * WHEEL_LEVELS);
+
+//The blinking field, one cell per blinker to start with
+const int CELL_SIZE = 5;
+const int CELL_COLUMNS = SCREEN_WIDTH / CELL_SIZE;
+const int CELL_ROWS = SCREEN_HEIGHT / CELL_SIZE;
+const int CELL_COUNT = CELL_COLUMNS * CELL_ROWS;
+
+//Blinkers wait somewhere in this range before they toggle their cell, in milliseconds
+const Uint32 BLINK_MIN_MILLISECONDS = 250;
+const Uint32 BLINK_MAX_MILLISECONDS = 8000;
+
+//Enter adds another field's worth of blinkers up to this many
+const int MAX_BLINKERS = CELL_COUNT * 16;
+
+//How long the splash stays up and fades out, the two seconds lesson 2 sat in SDL_Delay() for
+const double SPLASH_SECONDS = 2.0;
+const Uint32 SPLASH_FADE_MILLISECONDS = 500;
+
+//Foo' walks across the screen in this long, then rests a second
+const Uint32 WALK_MILLISECONDS = 2000;
+
+//The loader brings in one asset this often, it stands in for a slow disk so the waits can be seen
+const Uint32 ASSET_LOAD_INTERVAL = 750;
+
+//Self test sizes
+const int SELFTEST_TIMERS = 100000;
+const int SELFTEST_ROUNDS = 3;
+const int SELFTEST_MAX_UPDATES = 1000000;
+const int BENCHMARK_SLEEPERS = 100000;
+const int BENCHMARK_FRAMES = 2000;
+const Uint32 BENCHMARK_FRAME_MILLISECONDS = 16;
+
+//Texture wrapper class
+class LTexture
+{
+	public:
+		//Initializes variables
+		LTexture();
+
+		//Deallocates memory
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Set alpha modulation
+		void setAlpha(Uint8 alpha);
+
+		//Renders texture at given point
+		void render(int x, int y, SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Something a task can wait to be loaded
+struct Asset
+{
+	std::string path;
+	LTexture texture;
+
+	//Set once the loader is done with it, whether or not it worked
+	bool loaded;
+};
+
+//What a task is waiting for when it hands control back
+enum TaskWait
+{
+	TASK_WAIT_FRAME,
+	TASK_WAIT_TIME,
+	TASK_WAIT_ASSET,
+	TASK_DONE
+};
+
+//A piece of game logic that runs over many frames. VS2015 has no C++20 coroutines, so a task is a stackless
+//coroutine written by hand: resume() is one switch and every wait records where to come back in. Anything that
+//has to survive a wait lives in members, locals are gone once resume() returns.
+class Task
+{
+	public:
+		//Initializes variables
+		Task();
+
+		//Deallocates memory
+		virtual ~Task();
+
+		//Runs from where the task last waited to its next wait and says what that is
+		virtual TaskWait resume() = 0;
+
+	protected:
+		//Case label resume() picks up from, 0 is the top
+		int mResumePoint;
+
+		//What the last wait is for
+		Uint32 mWaitMilliseconds;
+		Asset* mWaitAsset;
+
+	private:
+		friend class TaskScheduler;
+
+		//Tick the task is due on and the next task in its wheel slot
+		Uint64 mDueTick;
+		Task* mNextInSlot;
+};
+
+//Opens and closes a task body, falling off the end finishes the task
+#define TASK_BEGIN() switch (mResumePoint) { case 0:
+#define TASK_END() } return TASK_DONE
+
+//Hands control back and resumes right after. __COUNTER__ rather than __LINE__ because /ZI makes __LINE__ a variable.
+//Waits can't go inside another switch in the same task body.
+#define TASK_YIELD(wait) TASK_YIELD_AT(__COUNTER__ + 1, wait)
+#define TASK_YIELD_AT(point, wait) do { mResumePoint = (point); return (wait); case (point):; } while (0)
+
+//The awaitables: the next update, a game time delay, an asset being loaded
+#define TASK_NEXT_FRAME() TASK_YIELD(TASK_WAIT_FRAME)
+#define TASK_WAIT_MILLISECONDS(milliseconds) do { mWaitMilliseconds = (milliseconds); TASK_YIELD(TASK_WAIT_TIME); } while (0)
+#define TASK_WAIT_SECONDS(seconds) TASK_WAIT_MILLISECONDS((Uint32)((seconds) * 1000.0 + 0.5))
+#define TASK_WAIT_ASSET(asset) do { mWaitAsset = (asset); TASK_YIELD(TASK_WAIT_ASSET); } while (0)
+
+//Owns the tasks and resumes them from the frame loop once what they wait for comes round. Timed waits are parked
+//in a hierarchical timing wheel: a task goes in the slot of its due tick on the lowest level that reaches that
+//far and drops a level each time the level below turns over onto its slot. However long it sleeps a task is
+//touched at most WHEEL_LEVELS times before it's due, and ticks with nothing due are skipped over.
+class TaskScheduler
+{
+	public:
+		//Initializes variables
+		TaskScheduler();
+
+		//Deallocates tasks
+		~TaskScheduler();
+
+		//Takes the task over, it first runs in the next update
+		void start(Task* task);
+
+		//Moves game time on and resumes every task that's due
+		void update(Uint32 milliseconds);
+
+		//Wakes the tasks waiting for an asset, call once it's loaded
+		void onAssetLoaded(Asset* asset);
+
+		//Deletes every task
+		void clear();
+
+		//Gets game time in milliseconds
+		Uint64 getTicks();
+
+		//Gets how many tasks there are, how many are in the wheel, and how many ran in the last update
+		int getTaskCount();
+		int getSleepingCount();
+		int getResumedCount();
+
+	private:
+		//Puts a task where its wait says
+		void park(Task* task, TaskWait wait);
+
+		//Puts a timed task in the wheel, or on the ready list if it's due already
+		void insert(Task* task);
+
+		//Moves a slot's tasks down to the levels below
+		void cascade(int level, int slot);
+
+		//Walks time up to a tick, collecting due tasks on the ready list
+		void advance(Uint64 target);
+
+		//Index of the lowest set bit, bits can't be 0
+		static int lowestBit(Uint64 bits);
+
+		//The wheel and which slots have anything in them
+		Task* mWheel[WHEEL_LEVELS][WHEEL_SLOTS];
+		Uint64 mOccupied[WHEEL_LEVELS];
+
+		//Tasks to run next update, the ones running this update, and the ones waiting for assets
+		std::vector<Task*> mReady;
+		std::vector<Task*> mRunning;
+		std::vector<Task*> mAssetWaiters;
+
+		Uint64 mTick;
+		int mTaskCount;
+		int mSleepingCount;
+		int mResumedCount;
+};
+
+//Loads requested assets one at a time as game time goes on and tells the scheduler about each
+class AssetLoader
+{
+	public:
+		//Initializes variables
+		AssetLoader();
+
+		//Deallocates assets
+		~AssetLoader();
+
+		//Queues an asset up, the handle is good until free()
+		Asset* request(std::string path);
+
+		//Loads the next asset if its turn has come
+		void update(TaskScheduler& scheduler);
+
+		//Deallocates assets
+		void free();
+
+	private:
+		std::vector<Asset*> mAssets;
+		size_t mNextLoad;
+		Uint64 mNextLoadTick;
+};
+
+//Lesson 2's splash: hello_world for two seconds, without holding up the frame loop to do it
+class SplashTask : public Task
+{
+	public:
+		TaskWait resume();
+
+	private:
+		Uint64 mFadeStart;
+};
+
+//Toggles one cell of the field every so often, forever
+class BlinkerTask : public Task
+{
+	public:
+		//Takes the cell to toggle
+		BlinkerTask(int cell);
+
+		TaskWait resume();
+
+	private:
+		int mCell;
+};
+
+//Walks Foo' back and forth, resting at each end
+class WalkerTask : public Task
+{
+	public:
+		//Initializes variables
+		WalkerTask();
+
+		TaskWait resume();
+
+	private:
+		Uint64 mWalkStart;
+		int mFrom;
+		int mTo;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Cheap random numbers
+Uint32 randomNumber();
+
+//Adds blinkers up to a count
+void addBlinkers(int count);
+
+//Checks every timed wait comes back on the first update at or after its due tick, then times the wheel
+//against polling every task each frame
+bool runSelfTest();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//The tasks and what they wait on
+TaskScheduler gScheduler;
+AssetLoader gAssets;
+Asset* gSplashAsset = NULL;
+Asset* gBackgroundAsset = NULL;
+Asset* gFooAsset = NULL;
+
+//What the tasks leave for rendering
+std::vector<Uint8> gCells(CELL_COUNT, 0);
+std::vector<SDL_Rect> gLitCells;
+Uint8 gSplashAlpha = 0;
+int gFooX = 0;
+SDL_RendererFlip gFooFlip = SDL_FLIP_NONE;
+int gBlinkers = 0;
+
+//Random state
+Uint32 gRandom = 0x2545F491;
+
+
+LTexture::LTexture()
+{
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture()
+{
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path)
+{
+	//Get rid of preexisting texture
+	free();
+
+	//The final texture
+	SDL_Texture* newTexture = NULL;
+
+	//Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL)
+	{
+		printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else
+	{
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL)
+		{
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else
+		{
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+
+			//Set blending so alpha modulation shows
+			SDL_SetTextureBlendMode(newTexture, SDL_BLENDMODE_BLEND);
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	//Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free()
+{
+	//Free texture if it exists
+	if (mTexture != NULL)
+	{
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::setAlpha(Uint8 alpha)
+{
+	//Modulate texture alpha
+	SDL_SetTextureAlphaMod(mTexture, alpha);
+}
+
+void LTexture::render(int x, int y, SDL_RendererFlip flip)
+{
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopyEx(gRenderer, mTexture, NULL, &renderQuad, 0.0, NULL, flip);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+
+Task::Task()
+{
+	//Initialize
+	mResumePoint = 0;
+	mWaitMilliseconds = 0;
+	mWaitAsset = NULL;
+	mDueTick = 0;
+	mNextInSlot = NULL;
+}
+
+Task::~Task()
+{
+}
+
+
+TaskScheduler::TaskScheduler()
+{
+	//Initialize
+	memset(mWheel, 0, sizeof(mWheel));
+	memset(mOccupied, 0, sizeof(mOccupied));
+	mTick = 0;
+	mTaskCount = 0;
+	mSleepingCount = 0;
+	mResumedCount = 0;
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	//Deallocate
+	clear();
+}
+
+void TaskScheduler::start(Task* task)
+{
+	mReady.push_back(task);
+	++mTaskCount;
+}
+
+void TaskScheduler::update(Uint32 milliseconds)
+{
+	//Everything due by the new time joins the tasks waiting for this frame
+	advance(mTick + milliseconds);
+
+	//Run what's ready. Whatever waits for the next frame or starts now goes on a fresh ready list for the next update.
+	mResumedCount = 0;
+	mRunning.swap(mReady);
+	for (size_t i = 0; i < mRunning.size(); ++i)
+	{
+		Task* task = mRunning[i];
+		TaskWait wait = task->resume();
+		++mResumedCount;
+
+		//An asset that's already there doesn't cost a frame
+		while (wait == TASK_WAIT_ASSET && task->mWaitAsset->loaded)
+		{
+			wait = task->resume();
+		}
+		park(task, wait);
+	}
+	mRunning.clear();
+}
+
+void TaskScheduler::onAssetLoaded(Asset* asset)
+{
+	//Move the waiters over to the ready list, keeping the rest in order
+	size_t kept = 0;
+	for (size_t i = 0; i < mAssetWaiters.size(); ++i)
+	{
+		Task* task = mAssetWaiters[i];
+		if (task->mWaitAsset == asset)
+		{
+			mReady.push_back(task);
+		}
+		else
+		{
+			mAssetWaiters[kept++] = task;
+		}
+	}
+	mAssetWaiters.resize(kept);
+}
+
+void TaskScheduler::clear()
+{
+	//Ready and asset waiting tasks
+	for (size_t i = 0; i < mReady.size(); ++i)
+	{
+		delete mReady[i];
+	}
+	for (size_t i = 0; i < mAssetWaiters.size(); ++i)
+	{
+		delete mAssetWaiters[i];
+	}
+	mReady.clear();
+	mAssetWaiters.clear();
+
+	//Sleeping tasks
+	for (int level = 0; level < WHEEL_LEVELS; ++level)
+	{
+		for (int slot = 0; slot < WHEEL_SLOTS; ++slot)
+		{
+			Task* task = mWheel[level][slot];
+			while (task != NULL)
+			{
+				Task* next = task->mNextInSlot;
+				delete task;
+				task = next;
+			}
+			mWheel[level][slot] = NULL;
+		}
+		mOccupied[level] = 0;
+	}
+
+	mTaskCount = 0;
+	mSleepingCount = 0;
+}
+
+Uint64 TaskScheduler::getTicks()
+{
+	return mTick;
+}
+
+int TaskScheduler::getTaskCount()
+{
+	return mTaskCount;
+}
+
+int TaskScheduler::getSleepingCount()
+{
+	return mSleepingCount;
+}
+
+int TaskScheduler::getResumedCount()
+{
+	return mResumedCount;
+}
+
+void TaskScheduler::park(Task* task, TaskWait wait)
+{
+	switch (wait)
+	{
+		case TASK_WAIT_FRAME:
+		mReady.push_back(task);
+		break;
+
+		case TASK_WAIT_TIME:
+		task->mDueTick = mTick + task->mWaitMilliseconds;
+		insert(task);
+		break;
+
+		case TASK_WAIT_ASSET:
+		mAssetWaiters.push_back(task);
+		break;
+
+		case TASK_DONE:
+		delete task;
+		--mTaskCount;
+		break;
+	}
+}
+
+void TaskScheduler::insert(Task* task)
+{
+	//Due now, which includes a zero wait, means the next update
+	Uint64 due = task->mDueTick;
+	if (due <= mTick)
+	{
+		mReady.push_back(task);
+		return;
+	}
+
+	//The lowest level that reaches that far. Beyond the top level the task goes as far as it can
+	//and cascades back up to the top again until what's left is in reach.
+	Uint64 delta = due - mTick;
+	if (delta >= WHEEL_RANGE)
+	{
+		due = mTick + WHEEL_RANGE - 1;
+		delta = WHEEL_RANGE - 1;
+	}
+	int level = 0;
+	while (delta >= ((Uint64)1 << (WHEEL_BITS * (level + 1))))
+	{
+		++level;
+	}
+
+	//Into the slot of the due tick's digit on that level
+	int slot = (int)((due >> (WHEEL_BITS * level)) & WHEEL_MASK);
+	task->mNextInSlot = mWheel[level][slot];
+	mWheel[level][slot] = task;
+	mOccupied[level] |= (Uint64)1 << slot;
+	++mSleepingCount;
+}
+
+void TaskScheduler::cascade(int level, int slot)
+{
+	//Every task here is due within one turn of the level below now, so each lands lower down
+	Task* task = mWheel[level][slot];
+	mWheel[level][slot] = NULL;
+	mOccupied[level] &= ~((Uint64)1 << slot);
+	while (task != NULL)
+	{
+		Task* next = task->mNextInSlot;
+		--mSleepingCount;
+		insert(task);
+		task = next;
+	}
+}
+
+void TaskScheduler::advance(Uint64 target)
+{
+	while (mTick < target)
+	{
+		//The next tick worth stopping on: the next occupied slot this turn of level 0, otherwise the turn itself
+		Uint64 next = (mTick | WHEEL_MASK) + 1;
+		int from = (int)(mTick & WHEEL_MASK) + 1;
+		if (from < WHEEL_SLOTS)
+		{
+			Uint64 ahead = mOccupied[0] & (~(Uint64)0 << from);
+			if (ahead != 0)
+			{
+				next = (mTick & ~(Uint64)WHEEL_MASK) + lowestBit(ahead);
+			}
+		}
+		if (next > target)
+		{
+			mTick = target;
+			break;
+		}
+		mTick = next;
+
+		//On a turn the level above brings its next slot down, and on that level's turn the one above it
+		int slot = (int)(mTick & WHEEL_MASK);
+		if (slot == 0)
+		{
+			for (int level = 1; level < WHEEL_LEVELS; ++level)
+			{
+				int levelSlot = (int)((mTick >> (WHEEL_BITS * level)) & WHEEL_MASK);
+				cascade(level, levelSlot);
+				if (levelSlot != 0)
+				{
+					break;
+				}
+			}
+		}
+
+		//Everything in this slot is due on this tick
+		Task* task = mWheel[0][slot];
+		mWheel[0][slot] = NULL;
+		mOccupied[0] &= ~((Uint64)1 << slot);
+		while (task != NULL)
+		{
+			Task* next = task->mNextInSlot;
+			--mSleepingCount;
+			mReady.push_back(task);
+			task = next;
+		}
+	}
+}
+
+int TaskScheduler::lowestBit(Uint64 bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(bits);
+#elif defined(_MSC_VER)
+	//_BitScanForward64 is x64 only, two halves work for Win32 too
+	unsigned long index = 0;
+	if (_BitScanForward(&index, (unsigned long)bits))
+	{
+		return (int)index;
+	}
+	_BitScanForward(&index, (unsigned long)(bits >> 32));
+	return (int)index + 32;
+#else
+	int index = 0;
+	while ((bits & 1) == 0)
+	{
+		bits >>= 1;
+		++index;
+	}
+	return index;
+#endif
+}
+
+
+AssetLoader::AssetLoader()
+{
+	//Initialize
+	mNextLoad = 0;
+	mNextLoadTick = ASSET_LOAD_INTERVAL;
+}
+
+AssetLoader::~AssetLoader()
+{
+	//Deallocate
+	free();
+}
+
+Asset* AssetLoader::request(std::string path)
+{
+	Asset* asset = new Asset();
+	asset->path = path;
+	asset->loaded = false;
+	mAssets.push_back(asset);
+	return asset;
+}
+
+void AssetLoader::update(TaskScheduler& scheduler)
+{
+	if (mNextLoad >= mAssets.size() || scheduler.getTicks() < mNextLoadTick)
+	{
+		return;
+	}
+
+	//Load it and wake whoever's waiting, a failed load wakes them too so nothing waits forever
+	Asset* asset = mAssets[mNextLoad++];
+	if (!asset->texture.loadFromFile(asset->path))
+	{
+		printf("Failed to load %s!\n", asset->path.c_str());
+	}
+	asset->loaded = true;
+	scheduler.onAssetLoaded(asset);
+	mNextLoadTick = scheduler.getTicks() + ASSET_LOAD_INTERVAL;
+}
+
+void AssetLoader::free()
+{
+	for (size_t i = 0; i < mAssets.size(); ++i)
+	{
+		delete mAssets[i];
+	}
+	mAssets.clear();
+	mNextLoad = 0;
+}
+
+
+TaskWait SplashTask::resume()
+{
+	TASK_BEGIN();
+
+	//Up as soon as the image is
+	TASK_WAIT_ASSET(gSplashAsset);
+	gSplashAlpha = 255;
+	TASK_WAIT_SECONDS(SPLASH_SECONDS);
+
+	//Then fade out over the next frames
+	mFadeStart = gScheduler.getTicks();
+	while (gScheduler.getTicks() - mFadeStart < SPLASH_FADE_MILLISECONDS)
+	{
+		gSplashAlpha = (Uint8)(255 - 255 * (gScheduler.getTicks() - mFadeStart) / SPLASH_FADE_MILLISECONDS);
+		TASK_NEXT_FRAME();
+	}
+	gSplashAlpha = 0;
+
+	TASK_END();
+}
+
+BlinkerTask::BlinkerTask(int cell)
+{
+	//Initialize
+	mCell = cell;
+}
+
+TaskWait BlinkerTask::resume()
+{
+	TASK_BEGIN();
+
+	for (;;)
+	{
+		TASK_WAIT_MILLISECONDS(BLINK_MIN_MILLISECONDS + randomNumber() % (BLINK_MAX_MILLISECONDS - BLINK_MIN_MILLISECONDS));
+		gCells[mCell] ^= 1;
+	}
+
+	TASK_END();
+}
+
+WalkerTask::WalkerTask()
+{
+	//Initialize
+	mWalkStart = 0;
+	mFrom = 0;
+	mTo = 0;
+}
+
+TaskWait WalkerTask::resume()
+{
+	TASK_BEGIN();
+
+	//Nothing to walk until Foo' is loaded
+	TASK_WAIT_ASSET(gFooAsset);
+	mFrom = 0;
+	mTo = SCREEN_WIDTH - gFooAsset->texture.getWidth();
+
+	for (;;)
+	{
+		//Across a frame at a time
+		mWalkStart = gScheduler.getTicks();
+		while (gScheduler.getTicks() - mWalkStart < WALK_MILLISECONDS)
+		{
+			gFooX = mFrom + (int)((mTo - mFrom) * (int)(gScheduler.getTicks() - mWalkStart) / (int)WALK_MILLISECONDS);
+			TASK_NEXT_FRAME();
+		}
+		gFooX = mTo;
+
+		//Rest, then turn round
+		TASK_WAIT_SECONDS(1.0);
+		int from = mFrom;
+		mFrom = mTo;
+		mTo = from;
+		gFooFlip = mTo < mFrom ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+	}
+
+	TASK_END();
+}
+
+
+Uint32 randomNumber()
+{
+	//Xorshift, plenty for blinking
+	gRandom ^= gRandom << 13;
+	gRandom ^= gRandom >> 17;
+	gRandom ^= gRandom << 5;
+	return gRandom;
+}
+
+void addBlinkers(int count)
+{
+	for (; gBlinkers < count && gBlinkers < MAX_BLINKERS; ++gBlinkers)
+	{
+		gScheduler.start(new BlinkerTask(gBlinkers % CELL_COUNT));
+	}
+}
+
+
+//Self test bookkeeping: game time before the update that's running and how the waits came back
+static Uint64 gSelfTestPreviousTick = 0;
+static int gSelfTestFired = 0;
+static int gSelfTestEarly = 0;
+static int gSelfTestLate = 0;
+
+//Waits a few random delays spread over every level and past the top of the wheel, checking each one
+class TimerCheckTask : public Task
+{
+	public:
+		//Takes the scheduler it runs under
+		TimerCheckTask(TaskScheduler* scheduler)
+		{
+			mScheduler = scheduler;
+			mRound = 0;
+			mDue = 0;
+		}
+
+		TaskWait resume()
+		{
+			TASK_BEGIN();
+
+			for (mRound = 0; mRound < SELFTEST_ROUNDS; ++mRound)
+			{
+				mDue = mScheduler->getTicks() + 1 + randomNumber() % (1u << (randomNumber() % 26));
+				TASK_WAIT_MILLISECONDS((Uint32)(mDue - mScheduler->getTicks()));
+
+				//Has to be the first update that got to the due tick
+				++gSelfTestFired;
+				if (mScheduler->getTicks() < mDue)
+				{
+					++gSelfTestEarly;
+				}
+				else if (gSelfTestPreviousTick >= mDue)
+				{
+					++gSelfTestLate;
+				}
+			}
+
+			TASK_END();
+		}
+
+	private:
+		TaskScheduler* mScheduler;
+		int mRound;
+		Uint64 mDue;
+};
+
+//Something that does a little work every one to sixty seconds
+class SleeperTask : public Task
+{
+	public:
+		TaskWait resume()
+		{
+			TASK_BEGIN();
+
+			for (;;)
+			{
+				TASK_WAIT_MILLISECONDS(1000 + randomNumber() % 59000);
+			}
+
+			TASK_END();
+		}
+};
+
+bool runSelfTest()
+{
+	//Timers over the whole range, stepped through with frame sized and much bigger jumps. A lost task would
+	//keep the count up forever, so give up well after the longest wait should be over.
+	TaskScheduler scheduler;
+	for (int i = 0; i < SELFTEST_TIMERS; ++i)
+	{
+		scheduler.start(new TimerCheckTask(&scheduler));
+	}
+	int updates = 0;
+	Uint64 start = SDL_GetPerformanceCounter();
+	while (scheduler.getTaskCount() > 0 && updates < SELFTEST_MAX_UPDATES)
+	{
+		gSelfTestPreviousTick = scheduler.getTicks();
+		Uint32 step = randomNumber() % 64 == 0 ? randomNumber() % (1u << 22) : randomNumber() % (1u << (randomNumber() % 13));
+		scheduler.update(step);
+		++updates;
+	}
+	double testSeconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+	int expected = SELFTEST_TIMERS * SELFTEST_ROUNDS;
+	bool success = gSelfTestFired == expected && gSelfTestEarly == 0 && gSelfTestLate == 0;
+	printf("Timing wheel %s: %d of %d waits came back over %d updates, %d early, %d late, %.1f ms\n", success ? "holds" : "BROKEN", gSelfTestFired, expected, updates, gSelfTestEarly, gSelfTestLate, testSeconds * 1000.0);
+
+	//Frame by frame with lots of sleepers, against walking every task each frame to see if it's due
+	TaskScheduler sleepers;
+	for (int i = 0; i < BENCHMARK_SLEEPERS; ++i)
+	{
+		sleepers.start(new SleeperTask());
+	}
+	sleepers.update(0);
+	int resumed = 0;
+	start = SDL_GetPerformanceCounter();
+	for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+	{
+		sleepers.update(BENCHMARK_FRAME_MILLISECONDS);
+		resumed += sleepers.getResumedCount();
+	}
+	double wheelSeconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+	std::vector<Uint64> dues(BENCHMARK_SLEEPERS);
+	for (int i = 0; i < BENCHMARK_SLEEPERS; ++i)
+	{
+		dues[i] = 1000 + randomNumber() % 59000;
+	}
+	Uint64 now = 0;
+	int polled = 0;
+	start = SDL_GetPerformanceCounter();
+	for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+	{
+		now += BENCHMARK_FRAME_MILLISECONDS;
+		for (int i = 0; i < BENCHMARK_SLEEPERS; ++i)
+		{
+			if (dues[i] <= now)
+			{
+				dues[i] = now + 1000 + randomNumber() % 59000;
+				++polled;
+			}
+		}
+	}
+	double pollSeconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+	printf("%d sleepers over %d frames: wheel %.1f us/frame (%d resumed), polling %.1f us/frame (%d resumed)\n", BENCHMARK_SLEEPERS, BENCHMARK_FRAMES,
+		wheelSeconds * 1000000.0 / BENCHMARK_FRAMES, resumed, pollSeconds * 1000000.0 / BENCHMARK_FRAMES, polled);
+
+	return success;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create vsynced renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Nothing is loaded up front any more, the loader brings things in as the game runs and the tasks wait for them
+	gSplashAsset = gAssets.request("Images/hello_world.bmp");
+	gBackgroundAsset = gAssets.request("Images/background.png");
+	gFooAsset = gAssets.request("Images/foo.png");
+
+	//The behaviors
+	gScheduler.start(new SplashTask());
+	gScheduler.start(new WalkerTask());
+	addBlinkers(CELL_COUNT);
+
+	return true;
+}
+
+void close()
+{
+	//Tasks first, they point at the assets
+	gScheduler.clear();
+	gAssets.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"selftest" checks and times the timing wheel, no window needed
+	if (argc >= 2 && strcmp(args[1], "selftest") == 0)
+	{
+		if (SDL_Init(0) < 0)
+		{
+			printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+			return 1;
+		}
+		bool passed = runSelfTest();
+		SDL_Quit();
+		return passed ? 0 : 1;
+	}
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Game time follows real time from here
+			Uint32 lastTicks = SDL_GetTicks();
+
+			//Title statistics over a second
+			Uint32 titleTicks = lastTicks;
+			Uint64 updateCounter = 0;
+			int resumed = 0;
+			int frames = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					//Enter adds another field's worth of blinkers
+					else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_RETURN)
+					{
+						addBlinkers(gBlinkers + CELL_COUNT);
+					}
+				}
+
+				//Bring in whatever's due to load, then run the tasks
+				Uint32 ticks = SDL_GetTicks();
+				gAssets.update(gScheduler);
+				Uint64 updateStart = SDL_GetPerformanceCounter();
+				gScheduler.update(ticks - lastTicks);
+				updateCounter += SDL_GetPerformanceCounter() - updateStart;
+				resumed += gScheduler.getResumedCount();
+				lastTicks = ticks;
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Background once it's in
+				if (gBackgroundAsset->loaded)
+				{
+					gBackgroundAsset->texture.render(0, 0);
+				}
+
+				//Lit cells in one go
+				gLitCells.clear();
+				for (int i = 0; i < CELL_COUNT; ++i)
+				{
+					if (gCells[i] != 0)
+					{
+						SDL_Rect cell = { (i % CELL_COLUMNS) * CELL_SIZE, (i / CELL_COLUMNS) * CELL_SIZE, CELL_SIZE - 1, CELL_SIZE - 1 };
+						gLitCells.push_back(cell);
+					}
+				}
+				SDL_SetRenderDrawBlendMode(gRenderer, SDL_BLENDMODE_BLEND);
+				SDL_SetRenderDrawColor(gRenderer, 0x00, 0x80, 0xFF, 0x60);
+				SDL_RenderFillRects(gRenderer, gLitCells.data(), (int)gLitCells.size());
+
+				//Foo' once he's in
+				if (gFooAsset->loaded)
+				{
+					gFooAsset->texture.render(gFooX, SCREEN_HEIGHT - gFooAsset->texture.getHeight(), gFooFlip);
+				}
+
+				//Splash over everything while it's up
+				if (gSplashAlpha > 0)
+				{
+					gSplashAsset->texture.setAlpha(gSplashAlpha);
+					gSplashAsset->texture.render(0, 0);
+				}
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+				++frames;
+
+				//Once a second put the numbers in the title
+				if (ticks - titleTicks >= 1000)
+				{
+					char title[256];
+					double updateMilliseconds = (double)updateCounter * 1000.0 / SDL_GetPerformanceFrequency() / frames;
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - %d tasks, %d asleep in the wheel, %d resumed/frame, update %.3f ms (Enter: more blinkers)",
+						gScheduler.getTaskCount(), gScheduler.getSleepingCount(), resumed / frames, updateMilliseconds);
+					SDL_SetWindowTitle(gWindow, title);
+					titleTicks = ticks;
+					updateCounter = 0;
+					resumed = 0;
+					frames = 0;
+				}
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
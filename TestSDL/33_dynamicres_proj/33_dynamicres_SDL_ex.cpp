@@ -0,0 +1,810 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, math, strings, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <vector>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Internal resolution goes in twentieths of the window, which keeps both sides whole pixels at 640x480
+const int SCALE_STEPS = 20;
+const int MIN_SCALE_STEP = 5;
+const int MAX_SCALE_STEP = SCALE_STEPS;
+
+//Frames the controller averages before it decides anything
+const int CONTROLLER_FRAMES = 10;
+
+//Share of the frame time target the controller aims to fill, the rest soaks up noise
+const double CONTROLLER_HEADROOM = 0.9;
+
+//Frame time targets 1-3 pick between
+const int TOTAL_TARGETS = 3;
+const int TARGET_FPS[TOTAL_TARGETS] = { 60, 30, 120 };
+
+//Sprite counts, +/- doubles/halves between these
+const int DEFAULT_SPRITES = 256;
+const int MIN_SPRITES = 16;
+const int MAX_SPRITES = 8192;
+
+//Sprites are see-through so every one is a full blend
+const Uint8 SPRITE_ALPHA = 0xC0;
+
+//What the benchmark runs
+const int BENCHMARK_FRAMES = 120;
+const int BENCHMARK_SPRITES = 1024;
+const int BENCHMARK_CONTROLLED_FRAMES = 300;
+
+//Texture wrapper class
+class LTexture
+{
+	public:
+		//Initializes variables
+		LTexture();
+
+		//Deallocates memory
+		~LTexture();
+
+		//Loads image at specified path
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Set alpha modulation
+		void setAlpha(Uint8 alpha);
+
+		//Renders texture into a rect in scene coordinates
+		void render(const SDL_Rect& dst);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//A texture the scene is drawn into at a fraction of the window size, then stretched over the window in one copy.
+//It's allocated at full size once and only the top left corner is used, so the resolution can change every frame
+//without a texture being created.
+class LowResTarget
+{
+	public:
+		//Initializes variables
+		LowResTarget();
+
+		//Deallocates memory
+		~LowResTarget();
+
+		//Creates the target at full window size, fails without render target support
+		bool create(int width, int height);
+
+		//Deallocates target
+		void free();
+
+		//Starts drawing the scene at an internal resolution. The scene still draws in window coordinates,
+		//the render scale maps them down. At full size the scene goes straight to the window.
+		void begin(int width, int height);
+
+		//Stretches what was drawn over the window
+		void present();
+
+		//Gets whether it was created
+		bool isAvailable();
+
+	private:
+		//The target texture
+		SDL_Texture* mTexture;
+
+		//Its full dimensions and the part in use
+		int mFullWidth;
+		int mFullHeight;
+		int mWidth;
+		int mHeight;
+
+		//Whether the scene is going to the texture this frame
+		bool mActive;
+};
+
+//Picks the internal resolution that holds a frame time target. Fill cost goes with the pixel count,
+//the square of the scale, so a slow frame steps down as far as that says it takes to get back inside the budget.
+//It only steps up one at a time and only when the same model says the next step fits, which stops it bouncing.
+class ResolutionController
+{
+	public:
+		//Initializes variables
+		ResolutionController();
+
+		//Sets the frame time to hold, in milliseconds
+		void setTarget(double milliseconds);
+
+		//Feeds in how long a frame took to render, returns whether the scale changed
+		bool addFrame(double milliseconds);
+
+		//Sets the scale by hand and starts averaging again
+		void setStep(int step);
+
+		//Gets the scale in SCALE_STEPS
+		int getStep();
+
+	private:
+		int mStep;
+		double mTarget;
+		double mSum;
+		int mFrames;
+};
+
+//A bouncing Foo'
+struct Sprite
+{
+	float x;
+	float y;
+	float velX;
+	float velY;
+};
+
+//Starts up SDL and creates window, hidden for the benchmark
+bool init(bool software, bool hidden);
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Changes how many sprites there are, new ones start somewhere random
+void setSpriteCount(int count);
+
+//Moves the sprites on
+void moveSprites(float seconds);
+
+//Draws the scene in window coordinates, whatever resolution it ends up at
+void renderScene();
+
+//Renders one frame at an internal scale and returns how long it took in milliseconds
+double renderFrame(int step);
+
+//Times fixed scales, then lets the controller hold half the full resolution cost
+void runBenchmark();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+
+//Where the scene is drawn
+LowResTarget gLowResTarget;
+
+//The bouncing sprites
+std::vector<Sprite> gSprites;
+
+//Random state
+Uint32 gRandom = 0x2545F491;
+
+
+LTexture::LTexture()
+{
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture()
+{
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path)
+{
+	//Get rid of preexisting texture
+	free();
+
+	//The final texture
+	SDL_Texture* newTexture = NULL;
+
+	//Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL)
+	{
+		printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else
+	{
+		//Color key image
+		SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL)
+		{
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else
+		{
+			//Get image dimensions
+			mWidth = loadedSurface->w;
+			mHeight = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	//Return success
+	mTexture = newTexture;
+	return mTexture != NULL;
+}
+
+void LTexture::free()
+{
+	//Free texture if it exists
+	if (mTexture != NULL)
+	{
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::setAlpha(Uint8 alpha)
+{
+	//Set blending function
+	SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_BLEND);
+
+	//Modulate texture alpha
+	SDL_SetTextureAlphaMod(mTexture, alpha);
+}
+
+void LTexture::render(const SDL_Rect& dst)
+{
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &dst);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+
+LowResTarget::LowResTarget()
+{
+	//Initialize
+	mTexture = NULL;
+	mFullWidth = 0;
+	mFullHeight = 0;
+	mWidth = 0;
+	mHeight = 0;
+	mActive = false;
+}
+
+LowResTarget::~LowResTarget()
+{
+	//Deallocate
+	free();
+}
+
+bool LowResTarget::create(int width, int height)
+{
+	//Get rid of preexisting target
+	free();
+
+	if (SDL_RenderTargetSupported(gRenderer) != SDL_TRUE)
+	{
+		printf("Render targets not supported, drawing at full resolution!\n");
+		return false;
+	}
+
+	//Linear filtering for the upscale, the hint is read when the texture is created
+	SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
+	mTexture = SDL_CreateTexture(gRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+	if (mTexture == NULL)
+	{
+		printf("Unable to create render target! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	mFullWidth = width;
+	mFullHeight = height;
+	return true;
+}
+
+void LowResTarget::free()
+{
+	//Free target if it exists
+	if (mTexture != NULL)
+	{
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mFullWidth = 0;
+		mFullHeight = 0;
+	}
+	mActive = false;
+}
+
+void LowResTarget::begin(int width, int height)
+{
+	//Full size gains nothing from the extra copy
+	mActive = mTexture != NULL && (width < mFullWidth || height < mFullHeight);
+	if (!mActive)
+	{
+		return;
+	}
+
+	//Switching target resets the scale, so it's set after
+	mWidth = width;
+	mHeight = height;
+	SDL_SetRenderTarget(gRenderer, mTexture);
+	SDL_RenderSetScale(gRenderer, (float)width / mFullWidth, (float)height / mFullHeight);
+}
+
+void LowResTarget::present()
+{
+	if (!mActive)
+	{
+		return;
+	}
+
+	//Back to the window, which gets its own scale back, and stretch the used corner over it
+	SDL_SetRenderTarget(gRenderer, NULL);
+	SDL_Rect used = { 0, 0, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, &used, NULL);
+	mActive = false;
+}
+
+bool LowResTarget::isAvailable()
+{
+	return mTexture != NULL;
+}
+
+
+ResolutionController::ResolutionController()
+{
+	//Initialize
+	mStep = MAX_SCALE_STEP;
+	mTarget = 1000.0 / TARGET_FPS[0];
+	mSum = 0.0;
+	mFrames = 0;
+}
+
+void ResolutionController::setTarget(double milliseconds)
+{
+	mTarget = milliseconds;
+	mSum = 0.0;
+	mFrames = 0;
+}
+
+bool ResolutionController::addFrame(double milliseconds)
+{
+	//Wait for a full window of frames at the current scale
+	mSum += milliseconds;
+	if (++mFrames < CONTROLLER_FRAMES)
+	{
+		return false;
+	}
+	double average = mSum / mFrames;
+	mSum = 0.0;
+	mFrames = 0;
+
+	int step = mStep;
+	double budget = mTarget * CONTROLLER_HEADROOM;
+	if (average > mTarget)
+	{
+		//Over: straight down to the scale that should fit the budget, at least one step
+		step = (int)(mStep * sqrt(budget / average));
+		step = SDL_min(step, mStep - 1);
+	}
+	else
+	{
+		//Under: one step up if that should still fit
+		double ratio = (double)(mStep + 1) / mStep;
+		if (average * ratio * ratio < budget)
+		{
+			step = mStep + 1;
+		}
+	}
+	step = SDL_max(SDL_min(step, MAX_SCALE_STEP), MIN_SCALE_STEP);
+
+	bool changed = step != mStep;
+	mStep = step;
+	return changed;
+}
+
+void ResolutionController::setStep(int step)
+{
+	mStep = SDL_max(SDL_min(step, MAX_SCALE_STEP), MIN_SCALE_STEP);
+	mSum = 0.0;
+	mFrames = 0;
+}
+
+int ResolutionController::getStep()
+{
+	return mStep;
+}
+
+
+static float randomFloat()
+{
+	//Xorshift into [0, 1)
+	gRandom ^= gRandom << 13;
+	gRandom ^= gRandom >> 17;
+	gRandom ^= gRandom << 5;
+	return (gRandom >> 8) * (1.0f / 16777216.0f);
+}
+
+void setSpriteCount(int count)
+{
+	while ((int)gSprites.size() < count)
+	{
+		Sprite sprite;
+		sprite.x = randomFloat() * (SCREEN_WIDTH - gFooTexture.getWidth());
+		sprite.y = randomFloat() * (SCREEN_HEIGHT - gFooTexture.getHeight());
+		sprite.velX = (randomFloat() - 0.5f) * 400.0f;
+		sprite.velY = (randomFloat() - 0.5f) * 400.0f;
+		gSprites.push_back(sprite);
+	}
+	gSprites.resize(count);
+}
+
+void moveSprites(float seconds)
+{
+	float maxX = (float)(SCREEN_WIDTH - gFooTexture.getWidth());
+	float maxY = (float)(SCREEN_HEIGHT - gFooTexture.getHeight());
+	for (size_t i = 0; i < gSprites.size(); ++i)
+	{
+		Sprite& sprite = gSprites[i];
+		sprite.x += sprite.velX * seconds;
+		sprite.y += sprite.velY * seconds;
+		if (sprite.x < 0.0f || sprite.x > maxX)
+		{
+			sprite.velX = -sprite.velX;
+			sprite.x = SDL_max(SDL_min(sprite.x, maxX), 0.0f);
+		}
+		if (sprite.y < 0.0f || sprite.y > maxY)
+		{
+			sprite.velY = -sprite.velY;
+			sprite.y = SDL_max(SDL_min(sprite.y, maxY), 0.0f);
+		}
+	}
+}
+
+void renderScene()
+{
+	//The background covers everything, so it doubles as the clear. SDL_RenderClear() would wipe the whole target.
+	SDL_Rect screen = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+	gBackgroundTexture.render(screen);
+
+	//Blended sprites, the fill heavy part
+	for (size_t i = 0; i < gSprites.size(); ++i)
+	{
+		SDL_Rect dst = { (int)gSprites[i].x, (int)gSprites[i].y, gFooTexture.getWidth(), gFooTexture.getHeight() };
+		gFooTexture.render(dst);
+	}
+}
+
+double renderFrame(int step)
+{
+	//Timed up to the end of the present, on a CPU renderer that's where the fill happens
+	Uint64 start = SDL_GetPerformanceCounter();
+	gLowResTarget.begin(SCREEN_WIDTH * step / SCALE_STEPS, SCREEN_HEIGHT * step / SCALE_STEPS);
+	renderScene();
+	gLowResTarget.present();
+	SDL_RenderPresent(gRenderer);
+	return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+void runBenchmark()
+{
+	//Same scene every run
+	setSpriteCount(BENCHMARK_SPRITES);
+	printf("%d sprites, %s\n", BENCHMARK_SPRITES, gLowResTarget.isAvailable() ? "render target" : "no render target, full resolution only");
+
+	//Fixed scales, the cost should fall with the pixel count
+	double fullMilliseconds = 0.0;
+	for (int step = MAX_SCALE_STEP; step >= MIN_SCALE_STEP; step -= 5)
+	{
+		double total = 0.0;
+		for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+		{
+			SDL_PumpEvents();
+			total += renderFrame(step);
+		}
+		double average = total / BENCHMARK_FRAMES;
+		if (step == MAX_SCALE_STEP)
+		{
+			fullMilliseconds = average;
+		}
+		printf("%3d%% %dx%d: %.2f ms/frame (%.2fx)\n", step * 100 / SCALE_STEPS, SCREEN_WIDTH * step / SCALE_STEPS, SCREEN_HEIGHT * step / SCALE_STEPS,
+			average, fullMilliseconds / average);
+	}
+
+	//The controller against a target full resolution can't make
+	ResolutionController controller;
+	controller.setTarget(fullMilliseconds * 0.5);
+	double total = 0.0;
+	int counted = 0;
+	int changes = 0;
+	for (int frame = 0; frame < BENCHMARK_CONTROLLED_FRAMES; ++frame)
+	{
+		SDL_PumpEvents();
+		double milliseconds = renderFrame(controller.getStep());
+		changes += controller.addFrame(milliseconds) ? 1 : 0;
+
+		//Settled frames only
+		if (frame >= BENCHMARK_CONTROLLED_FRAMES / 2)
+		{
+			total += milliseconds;
+			++counted;
+		}
+	}
+	printf("Holding %.2f ms: settled at %d%% with %.2f ms/frame after %d changes\n", fullMilliseconds * 0.5, controller.getStep() * 100 / SCALE_STEPS, total / counted, changes);
+}
+
+bool init(bool software, bool hidden)
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//No vsync, the controller has to see what a frame really costs. Frames are capped by hand instead.
+			Uint32 flags = (software ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED) | SDL_RENDERER_TARGETTEXTURE;
+			gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load scene textures
+	if (!gFooTexture.loadFromFile("Images/foo.png"))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+	else
+	{
+		gFooTexture.setAlpha(SPRITE_ALPHA);
+	}
+	if (!gBackgroundTexture.loadFromFile("Images/background.png"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	//Without a target everything is drawn at full size
+	gLowResTarget.create(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images and the target
+	gFooTexture.free();
+	gBackgroundTexture.free();
+	gLowResTarget.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"benchmark" times the scales in a hidden window, "software" anywhere picks the CPU renderer
+	bool benchmark = false;
+	bool software = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		benchmark = benchmark || strcmp(args[i], "benchmark") == 0;
+		software = software || strcmp(args[i], "software") == 0;
+	}
+
+	//Start up SDL and create window
+	if (!init(software, benchmark))
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else if (benchmark)
+		{
+			runBenchmark();
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//The scene and the resolution it's drawn at
+			setSpriteCount(DEFAULT_SPRITES);
+			ResolutionController controller;
+			bool dynamic = gLowResTarget.isAvailable();
+			int target = 0;
+
+			//Frames are capped at the target by hand
+			Uint64 frequency = SDL_GetPerformanceFrequency();
+			Uint64 lastCounter = SDL_GetPerformanceCounter();
+
+			//Title statistics over a second
+			Uint32 titleTicks = SDL_GetTicks();
+			double renderMilliseconds = 0.0;
+			int frames = 0;
+			int changes = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_KEYDOWN)
+					{
+						switch (e.key.keysym.sym)
+						{
+							//+/- doubles/halves the sprites
+							case SDLK_PLUS:
+							case SDLK_EQUALS:
+							setSpriteCount(SDL_min((int)gSprites.size() * 2, MAX_SPRITES));
+							break;
+
+							case SDLK_MINUS:
+							setSpriteCount(SDL_max((int)gSprites.size() / 2, MIN_SPRITES));
+							break;
+
+							//D toggles the controller
+							case SDLK_d:
+							dynamic = !dynamic && gLowResTarget.isAvailable();
+							controller.setStep(controller.getStep());
+							break;
+
+							//Up/down sets the scale by hand
+							case SDLK_UP:
+							case SDLK_DOWN:
+							if (gLowResTarget.isAvailable())
+							{
+								dynamic = false;
+								controller.setStep(controller.getStep() + (e.key.keysym.sym == SDLK_UP ? 1 : -1));
+							}
+							break;
+
+							//1-3 pick the frame time target
+							case SDLK_1:
+							case SDLK_2:
+							case SDLK_3:
+							target = e.key.keysym.sym - SDLK_1;
+							controller.setTarget(1000.0 / TARGET_FPS[target]);
+							break;
+						}
+					}
+				}
+
+				//Move on by however long the last frame took
+				Uint64 counter = SDL_GetPerformanceCounter();
+				moveSprites(SDL_min((float)(counter - lastCounter) / frequency, 0.1f));
+				lastCounter = counter;
+
+				//Render, and let the controller see what it cost
+				int step = gLowResTarget.isAvailable() ? controller.getStep() : MAX_SCALE_STEP;
+				double milliseconds = renderFrame(step);
+				if (dynamic && controller.addFrame(milliseconds))
+				{
+					++changes;
+				}
+				renderMilliseconds += milliseconds;
+				++frames;
+
+				//Wait out the rest of the frame
+				double frameMilliseconds = 1000.0 / TARGET_FPS[target];
+				double spent = (double)(SDL_GetPerformanceCounter() - lastCounter) * 1000.0 / frequency;
+				if (spent < frameMilliseconds)
+				{
+					SDL_Delay((Uint32)(frameMilliseconds - spent));
+				}
+
+				//Once a second put the numbers in the title
+				Uint32 ticks = SDL_GetTicks();
+				if (ticks - titleTicks >= 1000)
+				{
+					char title[192];
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - %dx%d (%d%%, %s), %d sprites: render %.2f ms of %.2f ms, %d fps, %d changes",
+						SCREEN_WIDTH * step / SCALE_STEPS, SCREEN_HEIGHT * step / SCALE_STEPS, step * 100 / SCALE_STEPS, dynamic ? "dynamic" : "fixed",
+						(int)gSprites.size(), renderMilliseconds / frames, frameMilliseconds, frames, changes);
+					SDL_SetWindowTitle(gWindow, title);
+					titleTicks = ticks;
+					renderMilliseconds = 0.0;
+					frames = 0;
+					changes = 0;
+				}
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}
@@ -0,0 +1,1129 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, and vectors
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Bytes of the file the decoders see at a time, the rest stays on disk
+const int STREAM_BUFFER_SIZE = 16 * 1024;
+
+//QOI chunk tags, the format is explained in lesson 12
+const Uint8 QOI_OP_INDEX = 0x00;
+const Uint8 QOI_OP_DIFF = 0x40;
+const Uint8 QOI_OP_LUMA = 0x80;
+const Uint8 QOI_OP_RUN = 0xC0;
+const Uint8 QOI_OP_RGB = 0xFE;
+const Uint8 QOI_OP_RGBA = 0xFF;
+const Uint8 QOI_MASK_2 = 0xC0;
+
+//Both headers start with a 14 byte block: "qoif", width, height, channels, colorspace for QOI,
+//"BM", file size, reserved, pixel data offset for BMP
+const int FILE_HEADER_SIZE = 14;
+
+//BITMAPINFOHEADER, the smallest info header with everything needed
+const int BMP_INFO_HEADER_SIZE = 40;
+
+//Guards against headers that would make us allocate gigabytes
+const Uint32 IMAGE_PIXELS_MAX = 400000000;
+
+//Decoded QOI surfaces use R, G, B, A byte order like lesson 12
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+const Uint32 QOI_SURFACE_FORMAT = SDL_PIXELFORMAT_RGBA8888;
+#else
+const Uint32 QOI_SURFACE_FORMAT = SDL_PIXELFORMAT_ABGR8888;
+#endif
+
+//Loads per image in benchmark mode
+const int BENCHMARK_LOADS = 50;
+
+//Image formats that can be decoded a row at a time
+enum ImageKind
+{
+	IMAGE_QOI,
+	IMAGE_BMP,
+	IMAGE_OTHER
+};
+
+//What the header says about an image
+struct ImageHeader
+{
+	ImageKind kind;
+	int width;
+	int height;
+
+	//QOI files with 4 channels can have alpha
+	bool hasAlpha;
+
+	//BMP rows go bottom up unless the height was negative
+	bool topDown;
+};
+
+//Rows a decoder writes into, top row first, and where each channel goes in a 32-bit pixel
+struct PixelTarget
+{
+	Uint8* pixels;
+	int pitch;
+	int rShift;
+	int gShift;
+	int bShift;
+	int aShift;
+
+	//Cyan pixels get alpha 0, the same as the color key LTexture has always set
+	bool colorKey;
+};
+
+//Buffered reads from a file, so decoders can go a byte at a time without holding the whole file in memory
+class StreamReader
+{
+	public:
+		//Reads from a file the caller keeps open
+		StreamReader(SDL_RWops* src);
+
+		//Gets the next byte, 0 past the end
+		Uint8 readByte()
+		{
+			return mPosition < mLength ? mBuffer[mPosition++] : refill();
+		}
+
+		//Reads a block, false if the file ends first
+		bool read(void* dst, size_t size);
+
+		//Skips ahead, false if the file ends first
+		bool skip(size_t size);
+
+		//Gets whether a read went past the end
+		bool hasEnded();
+
+	private:
+		//Reads the next buffer full and returns its first byte
+		Uint8 refill();
+
+		SDL_RWops* mSrc;
+		Uint8 mBuffer[STREAM_BUFFER_SIZE];
+		size_t mPosition;
+		size_t mLength;
+		bool mEnded;
+};
+
+//Texture wrapper class
+class LTexture
+{
+	public:
+		//Initializes variables
+		LTexture();
+
+		//Deallocates memory
+		~LTexture();
+
+		//Loads image at specified path, straight into the texture when the format allows it
+		bool loadFromFile(std::string path);
+
+		//Deallocates texture
+		void free();
+
+		//Renders texture at given point
+		void render(int x, int y);
+
+		//Gets image dimensions
+		int getWidth();
+		int getHeight();
+
+	private:
+		//The actual hardware texture
+		SDL_Texture* mTexture;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+};
+
+//Starts up SDL and creates window, hidden for the benchmark
+bool init(bool software, bool hidden);
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Reads a QOI or 24-bit uncompressed BMP header and leaves the reader at the pixel data. False for anything else.
+bool readImageHeader(StreamReader& reader, ImageHeader& header);
+
+//Fills in a target for rows of 32-bit pixels in a format
+PixelTarget makePixelTarget(Uint32 format, void* pixels, int pitch, bool colorKey);
+
+//Decode the pixel data after a header into the target, writing every pixel once and never reading it back
+bool decodeQOI(StreamReader& reader, const ImageHeader& header, const PixelTarget& target);
+bool decodeBMP(StreamReader& reader, const ImageHeader& header, const PixelTarget& target);
+
+//Picks the 32-bit format the renderer takes natively, so locking a texture hands back its own memory
+//and not a buffer SDL converts from on unlock
+Uint32 chooseDirectFormat();
+
+//Reads the header, creates a streaming texture to match and decodes straight into the locked texture.
+//Formats that can't be decoded that way go through loadTextureSurface(). The software renderer locks the
+//texture's own pixels. The OpenGL renderers keep a copy of every streaming texture, so there only the surface is saved.
+SDL_Texture* loadTextureDirect(std::string path, bool colorKey, int* width, int* height);
+
+//The usual way for comparison: decode into a surface, then SDL_CreateTextureFromSurface() copies it
+SDL_Texture* loadTextureSurface(std::string path, bool colorKey, int* width, int* height);
+
+//Starts counting SDL heap bytes so the benchmark can report peaks, has to come before SDL_Init()
+bool initPeakTracking();
+
+//Starts a new peak from the current live bytes and returns them
+long long resetPeak();
+
+//Gets the highest live bytes since resetPeak()
+long long getPeak();
+
+//Times and measures both ways of loading each image, true if the decoders match SDL's
+bool runBenchmark();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Format direct loads create textures in
+Uint32 gDirectFormat = SDL_PIXELFORMAT_ARGB8888;
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+
+//SDL heap bytes live and the peak
+static long long gLiveBytes = 0;
+static long long gPeakBytes = 0;
+
+
+StreamReader::StreamReader(SDL_RWops* src)
+{
+	//Initialize
+	mSrc = src;
+	mPosition = 0;
+	mLength = 0;
+	mEnded = false;
+}
+
+bool StreamReader::read(void* dst, size_t size)
+{
+	//Whatever's buffered first
+	Uint8* bytes = (Uint8*)dst;
+	size_t buffered = SDL_min(size, mLength - mPosition);
+	SDL_memcpy(bytes, mBuffer + mPosition, buffered);
+	mPosition += buffered;
+	bytes += buffered;
+	size -= buffered;
+
+	//Big reads skip the buffer, small ones refill it
+	if (size >= (size_t)STREAM_BUFFER_SIZE)
+	{
+		if (SDL_RWread(mSrc, bytes, 1, size) != size)
+		{
+			mEnded = true;
+		}
+	}
+	else if (size > 0)
+	{
+		mPosition = 0;
+		mLength = SDL_RWread(mSrc, mBuffer, 1, STREAM_BUFFER_SIZE);
+		if (mLength < size)
+		{
+			mEnded = true;
+			mLength = 0;
+		}
+		else
+		{
+			SDL_memcpy(bytes, mBuffer, size);
+			mPosition = size;
+		}
+	}
+
+	return !mEnded;
+}
+
+bool StreamReader::skip(size_t size)
+{
+	//Within the buffer or past it
+	size_t buffered = mLength - mPosition;
+	if (size <= buffered)
+	{
+		mPosition += size;
+	}
+	else
+	{
+		mPosition = 0;
+		mLength = 0;
+		if (SDL_RWseek(mSrc, (Sint64)(size - buffered), RW_SEEK_CUR) < 0)
+		{
+			mEnded = true;
+		}
+	}
+
+	return !mEnded;
+}
+
+bool StreamReader::hasEnded()
+{
+	return mEnded;
+}
+
+Uint8 StreamReader::refill()
+{
+	mPosition = 0;
+	mLength = SDL_RWread(mSrc, mBuffer, 1, STREAM_BUFFER_SIZE);
+	if (mLength == 0)
+	{
+		mEnded = true;
+		return 0;
+	}
+	return mBuffer[mPosition++];
+}
+
+
+LTexture::LTexture()
+{
+	//Initialize
+	mTexture = NULL;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+LTexture::~LTexture()
+{
+	//Deallocate
+	free();
+}
+
+bool LTexture::loadFromFile(std::string path)
+{
+	//Get rid of preexisting texture
+	free();
+
+	//Color keyed like always, the decoders apply the key as they go
+	mTexture = loadTextureDirect(path, true, &mWidth, &mHeight);
+	return mTexture != NULL;
+}
+
+void LTexture::free()
+{
+	//Free texture if it exists
+	if (mTexture != NULL)
+	{
+		SDL_DestroyTexture(mTexture);
+		mTexture = NULL;
+		mWidth = 0;
+		mHeight = 0;
+	}
+}
+
+void LTexture::render(int x, int y)
+{
+	//Set rendering space and render to screen
+	SDL_Rect renderQuad = { x, y, mWidth, mHeight };
+	SDL_RenderCopy(gRenderer, mTexture, NULL, &renderQuad);
+}
+
+int LTexture::getWidth()
+{
+	return mWidth;
+}
+
+int LTexture::getHeight()
+{
+	return mHeight;
+}
+
+
+static inline Uint32 readBE32(const Uint8* bytes)
+{
+	return ((Uint32)bytes[0] << 24) | ((Uint32)bytes[1] << 16) | ((Uint32)bytes[2] << 8) | bytes[3];
+}
+
+static inline Uint32 readLE32(const Uint8* bytes)
+{
+	return ((Uint32)bytes[3] << 24) | ((Uint32)bytes[2] << 16) | ((Uint32)bytes[1] << 8) | bytes[0];
+}
+
+static inline Uint16 readLE16(const Uint8* bytes)
+{
+	return (Uint16)(((Uint16)bytes[1] << 8) | bytes[0]);
+}
+
+bool readImageHeader(StreamReader& reader, ImageHeader& header)
+{
+	header.kind = IMAGE_OTHER;
+	Uint8 bytes[BMP_INFO_HEADER_SIZE];
+	if (!reader.read(bytes, FILE_HEADER_SIZE))
+	{
+		return false;
+	}
+
+	if (bytes[0] == 'q' && bytes[1] == 'o' && bytes[2] == 'i' && bytes[3] == 'f')
+	{
+		Uint32 width = readBE32(bytes + 4);
+		Uint32 height = readBE32(bytes + 8);
+		Uint8 channels = bytes[12];
+		if (width == 0 || height == 0 || channels < 3 || channels > 4 || height >= IMAGE_PIXELS_MAX / width)
+		{
+			return false;
+		}
+
+		header.kind = IMAGE_QOI;
+		header.width = (int)width;
+		header.height = (int)height;
+		header.hasAlpha = channels == 4;
+		header.topDown = true;
+		return true;
+	}
+
+	if (bytes[0] == 'B' && bytes[1] == 'M')
+	{
+		//The info header follows, anything bigger than BITMAPINFOHEADER only adds fields at the end
+		Uint32 dataOffset = readLE32(bytes + 10);
+		if (!reader.read(bytes, BMP_INFO_HEADER_SIZE))
+		{
+			return false;
+		}
+		Uint32 infoSize = readLE32(bytes);
+		Sint32 width = (Sint32)readLE32(bytes + 4);
+		Sint32 height = (Sint32)readLE32(bytes + 8);
+		Uint16 bits = readLE16(bytes + 14);
+		Uint32 compression = readLE32(bytes + 16);
+
+		//Only plain 24-bit, palettes, masks and RLE go through SDL_LoadBMP
+		Uint32 headerEnd = FILE_HEADER_SIZE + BMP_INFO_HEADER_SIZE;
+		Sint64 rows = height < 0 ? -(Sint64)height : height;
+		if (infoSize < (Uint32)BMP_INFO_HEADER_SIZE || bits != 24 || compression != 0 || width <= 0 || rows == 0 ||
+			dataOffset < headerEnd || rows >= IMAGE_PIXELS_MAX / width)
+		{
+			return false;
+		}
+
+		header.kind = IMAGE_BMP;
+		header.width = width;
+		header.height = (int)rows;
+		header.hasAlpha = false;
+		header.topDown = height < 0;
+		return reader.skip(dataOffset - headerEnd);
+	}
+
+	return false;
+}
+
+//Position of the lowest bit of a channel mask
+static int maskShift(Uint32 mask)
+{
+	int shift = 0;
+	while (mask != 0 && (mask & 1) == 0)
+	{
+		mask >>= 1;
+		++shift;
+	}
+	return shift;
+}
+
+PixelTarget makePixelTarget(Uint32 format, void* pixels, int pitch, bool colorKey)
+{
+	int bpp = 0;
+	Uint32 rmask = 0, gmask = 0, bmask = 0, amask = 0;
+	SDL_PixelFormatEnumToMasks(format, &bpp, &rmask, &gmask, &bmask, &amask);
+
+	PixelTarget target;
+	target.pixels = (Uint8*)pixels;
+	target.pitch = pitch;
+	target.rShift = maskShift(rmask);
+	target.gShift = maskShift(gmask);
+	target.bShift = maskShift(bmask);
+	target.aShift = maskShift(amask);
+	target.colorKey = colorKey;
+	return target;
+}
+
+static inline Uint32 packPixel(const PixelTarget& target, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+	if (target.colorKey && r == 0 && g == 0xFF && b == 0xFF)
+	{
+		a = 0;
+	}
+	return ((Uint32)r << target.rShift) | ((Uint32)g << target.gShift) | ((Uint32)b << target.bShift) | ((Uint32)a << target.aShift);
+}
+
+bool decodeQOI(StreamReader& reader, const ImageHeader& header, const PixelTarget& target)
+{
+	//Recently seen pixels by hash, in R, G, B, A order
+	Uint8 index[64][4];
+	SDL_memset(index, 0, sizeof(index));
+
+	Uint8 r = 0, g = 0, b = 0, a = 255;
+	Uint32 packed = packPixel(target, r, g, b, a);
+	int run = 0;
+
+	for (int y = 0; y < header.height; ++y)
+	{
+		Uint32* row = (Uint32*)(target.pixels + y * target.pitch);
+		int x = 0;
+		while (x < header.width)
+		{
+			//A run fills as much of the row as it can in one go
+			if (run > 0)
+			{
+				int count = SDL_min(run, header.width - x);
+				for (int i = 0; i < count; ++i)
+				{
+					row[x + i] = packed;
+				}
+				x += count;
+				run -= count;
+				continue;
+			}
+
+			int b1 = reader.readByte();
+			if (b1 == QOI_OP_RGB)
+			{
+				r = reader.readByte();
+				g = reader.readByte();
+				b = reader.readByte();
+			}
+			else if (b1 == QOI_OP_RGBA)
+			{
+				r = reader.readByte();
+				g = reader.readByte();
+				b = reader.readByte();
+				a = reader.readByte();
+			}
+			else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX)
+			{
+				r = index[b1][0];
+				g = index[b1][1];
+				b = index[b1][2];
+				a = index[b1][3];
+			}
+			else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF)
+			{
+				r += ((b1 >> 4) & 0x03) - 2;
+				g += ((b1 >> 2) & 0x03) - 2;
+				b += (b1 & 0x03) - 2;
+			}
+			else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA)
+			{
+				int b2 = reader.readByte();
+				int vg = (b1 & 0x3F) - 32;
+				r += vg - 8 + ((b2 >> 4) & 0x0F);
+				g += vg;
+				b += vg - 8 + (b2 & 0x0F);
+			}
+			else
+			{
+				//QOI_OP_RUN, the bias of -1 is folded in since this pixel is written right away
+				run = b1 & 0x3F;
+			}
+
+			//Pack once per chunk, runs reuse it
+			Uint8* entry = index[(r * 3 + g * 5 + b * 7 + a * 11) & 63];
+			entry[0] = r;
+			entry[1] = g;
+			entry[2] = b;
+			entry[3] = a;
+			packed = packPixel(target, r, g, b, a);
+			row[x++] = packed;
+		}
+	}
+
+	//The end marker isn't needed, running out before the last pixel means the file was cut short
+	if (reader.hasEnded())
+	{
+		SDL_SetError("Truncated QOI image");
+		return false;
+	}
+	return true;
+}
+
+bool decodeBMP(StreamReader& reader, const ImageHeader& header, const PixelTarget& target)
+{
+	//Rows are padded to 4 bytes. One row is the only copy made, the locked memory is only written.
+	int stride = (header.width * 3 + 3) & ~3;
+	std::vector<Uint8> scanline(stride);
+
+	for (int i = 0; i < header.height; ++i)
+	{
+		if (!reader.read(&scanline[0], stride))
+		{
+			SDL_SetError("Truncated BMP image");
+			return false;
+		}
+
+		//Bottom up files fill the texture from the last row
+		int y = header.topDown ? i : header.height - 1 - i;
+		Uint32* row = (Uint32*)(target.pixels + y * target.pitch);
+		const Uint8* bgr = &scanline[0];
+		for (int x = 0; x < header.width; ++x)
+		{
+			row[x] = packPixel(target, bgr[2], bgr[1], bgr[0], 255);
+			bgr += 3;
+		}
+	}
+
+	return true;
+}
+
+Uint32 chooseDirectFormat()
+{
+	//First format the renderer lists that the decoders can pack into
+	SDL_RendererInfo info;
+	if (SDL_GetRendererInfo(gRenderer, &info) == 0)
+	{
+		for (Uint32 i = 0; i < info.num_texture_formats; ++i)
+		{
+			Uint32 format = info.texture_formats[i];
+			if (format == SDL_PIXELFORMAT_ARGB8888 || format == SDL_PIXELFORMAT_ABGR8888 || format == SDL_PIXELFORMAT_RGBA8888 || format == SDL_PIXELFORMAT_BGRA8888)
+			{
+				return format;
+			}
+		}
+	}
+
+	return SDL_PIXELFORMAT_ARGB8888;
+}
+
+SDL_Texture* loadTextureDirect(std::string path, bool colorKey, int* width, int* height)
+{
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == NULL)
+	{
+		printf("Unable to open image %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return NULL;
+	}
+
+	//Anything the header doesn't vouch for goes the usual way
+	StreamReader reader(file);
+	ImageHeader header;
+	if (!readImageHeader(reader, header))
+	{
+		SDL_RWclose(file);
+		return loadTextureSurface(path, colorKey, width, height);
+	}
+
+	//The final texture, the size and format known before a single pixel is decoded
+	SDL_Texture* newTexture = SDL_CreateTexture(gRenderer, gDirectFormat, SDL_TEXTUREACCESS_STREAMING, header.width, header.height);
+	if (newTexture == NULL)
+	{
+		printf("Unable to create texture for %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+	}
+	else
+	{
+		//Decode into the texture's own memory
+		void* pixels = NULL;
+		int pitch = 0;
+		bool decoded = false;
+		if (SDL_LockTexture(newTexture, NULL, &pixels, &pitch) != 0)
+		{
+			printf("Unable to lock texture for %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else
+		{
+			PixelTarget target = makePixelTarget(gDirectFormat, pixels, pitch, colorKey);
+			decoded = header.kind == IMAGE_QOI ? decodeQOI(reader, header, target) : decodeBMP(reader, header, target);
+			SDL_UnlockTexture(newTexture);
+			if (!decoded)
+			{
+				printf("Unable to decode %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+			}
+		}
+
+		if (!decoded)
+		{
+			SDL_DestroyTexture(newTexture);
+			newTexture = NULL;
+		}
+		else
+		{
+			//Blend like SDL_CreateTextureFromSurface() would for a keyed or alpha surface
+			if (colorKey || header.hasAlpha)
+			{
+				SDL_SetTextureBlendMode(newTexture, SDL_BLENDMODE_BLEND);
+			}
+			*width = header.width;
+			*height = header.height;
+		}
+	}
+
+	SDL_RWclose(file);
+	return newTexture;
+}
+
+SDL_Texture* loadTextureSurface(std::string path, bool colorKey, int* width, int* height)
+{
+	SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+	if (file == NULL)
+	{
+		printf("Unable to open image %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		return NULL;
+	}
+
+	//QOI through our decoder into a surface like lesson 12, everything else through SDL_image
+	SDL_Surface* loadedSurface = NULL;
+	StreamReader reader(file);
+	ImageHeader header;
+	if (readImageHeader(reader, header) && header.kind == IMAGE_QOI)
+	{
+		int bpp = 0;
+		Uint32 rmask = 0, gmask = 0, bmask = 0, amask = 0;
+		SDL_PixelFormatEnumToMasks(QOI_SURFACE_FORMAT, &bpp, &rmask, &gmask, &bmask, &amask);
+		loadedSurface = SDL_CreateRGBSurface(0, header.width, header.height, bpp, rmask, gmask, bmask, amask);
+		if (loadedSurface != NULL && !decodeQOI(reader, header, makePixelTarget(QOI_SURFACE_FORMAT, loadedSurface->pixels, loadedSurface->pitch, false)))
+		{
+			SDL_FreeSurface(loadedSurface);
+			loadedSurface = NULL;
+		}
+		SDL_RWclose(file);
+	}
+	else
+	{
+		SDL_RWclose(file);
+		loadedSurface = IMG_Load(path.c_str());
+	}
+
+	//The final texture
+	SDL_Texture* newTexture = NULL;
+	if (loadedSurface == NULL)
+	{
+		printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else
+	{
+		//Color key image
+		if (colorKey)
+		{
+			SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+		}
+
+		//Create texture from surface pixels
+		newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+		if (newTexture == NULL)
+		{
+			printf("Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+		else
+		{
+			//Get image dimensions
+			*width = loadedSurface->w;
+			*height = loadedSurface->h;
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	return newTexture;
+}
+
+
+//Every block carries its size in front, padded to keep the block aligned
+union PeakHeader
+{
+	size_t size;
+	double align[2];
+};
+
+static SDL_malloc_func gOriginalMalloc = NULL;
+static SDL_calloc_func gOriginalCalloc = NULL;
+static SDL_realloc_func gOriginalRealloc = NULL;
+static SDL_free_func gOriginalFree = NULL;
+
+static void countBytes(long long bytes)
+{
+	gLiveBytes += bytes;
+	if (gLiveBytes > gPeakBytes)
+	{
+		gPeakBytes = gLiveBytes;
+	}
+}
+
+static void* SDLCALL peakMalloc(size_t size)
+{
+	PeakHeader* header = (PeakHeader*)gOriginalMalloc(size + sizeof(PeakHeader));
+	if (header == NULL)
+	{
+		return NULL;
+	}
+	header->size = size;
+	countBytes((long long)size);
+	return header + 1;
+}
+
+static void* SDLCALL peakCalloc(size_t count, size_t size)
+{
+	//Refuse sizes that would overflow, like calloc does
+	if (size != 0 && count > ((size_t)-1 - sizeof(PeakHeader)) / size)
+	{
+		return NULL;
+	}
+
+	void* memory = peakMalloc(count * size);
+	if (memory != NULL)
+	{
+		SDL_memset(memory, 0, count * size);
+	}
+	return memory;
+}
+
+static void SDLCALL peakFree(void* memory)
+{
+	if (memory == NULL)
+	{
+		return;
+	}
+	PeakHeader* header = (PeakHeader*)memory - 1;
+	countBytes(-(long long)header->size);
+	gOriginalFree(header);
+}
+
+static void* SDLCALL peakRealloc(void* memory, size_t size)
+{
+	if (memory == NULL)
+	{
+		return peakMalloc(size);
+	}
+	PeakHeader* header = (PeakHeader*)memory - 1;
+	size_t oldSize = header->size;
+	PeakHeader* newHeader = (PeakHeader*)gOriginalRealloc(header, size + sizeof(PeakHeader));
+	if (newHeader == NULL)
+	{
+		return NULL;
+	}
+	newHeader->size = size;
+	countBytes((long long)size - (long long)oldSize);
+	return newHeader + 1;
+}
+
+bool initPeakTracking()
+{
+#if SDL_VERSION_ATLEAST(2, 0, 7)
+	//Blocks from before this would reach peakFree() without a header, lesson 15 explains
+	if (SDL_GetNumAllocations() > 0)
+	{
+		printf("Warning: SDL allocated memory before tracking started, peaks won't be measured!\n");
+		return false;
+	}
+
+	SDL_GetMemoryFunctions(&gOriginalMalloc, &gOriginalCalloc, &gOriginalRealloc, &gOriginalFree);
+	if (SDL_SetMemoryFunctions(peakMalloc, peakCalloc, peakRealloc, peakFree) < 0)
+	{
+		printf("Unable to hook SDL memory functions! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+	return true;
+#else
+	printf("Warning: SDL_SetMemoryFunctions needs SDL 2.0.7, peaks won't be measured!\n");
+	return false;
+#endif
+}
+
+long long resetPeak()
+{
+	gPeakBytes = gLiveBytes;
+	return gLiveBytes;
+}
+
+long long getPeak()
+{
+	return gPeakBytes;
+}
+
+//Decodes an image to ARGB8888 rows in memory, directly or through SDL, for comparing the two
+static bool decodeToMemory(std::string path, bool direct, std::vector<Uint32>& pixels, int* width, int* height)
+{
+	pixels.clear();
+	if (direct)
+	{
+		SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+		if (file == NULL)
+		{
+			return false;
+		}
+		StreamReader reader(file);
+		ImageHeader header;
+		bool decoded = readImageHeader(reader, header);
+		if (decoded)
+		{
+			pixels.resize((size_t)header.width * header.height);
+			PixelTarget target = makePixelTarget(SDL_PIXELFORMAT_ARGB8888, &pixels[0], header.width * 4, false);
+			decoded = header.kind == IMAGE_QOI ? decodeQOI(reader, header, target) : decodeBMP(reader, header, target);
+			*width = header.width;
+			*height = header.height;
+		}
+		SDL_RWclose(file);
+		return decoded;
+	}
+
+	SDL_Surface* loaded = IMG_Load(path.c_str());
+	if (loaded == NULL)
+	{
+		return false;
+	}
+	SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+	SDL_FreeSurface(loaded);
+	if (converted == NULL)
+	{
+		return false;
+	}
+	*width = converted->w;
+	*height = converted->h;
+	pixels.resize((size_t)converted->w * converted->h);
+	for (int y = 0; y < converted->h; ++y)
+	{
+		SDL_memcpy(&pixels[(size_t)y * converted->w], (Uint8*)converted->pixels + y * converted->pitch, converted->w * 4);
+	}
+	SDL_FreeSurface(converted);
+	return true;
+}
+
+bool runBenchmark()
+{
+	//Each image and what SDL_image decodes to the same pixels, to check the direct decoders against
+	const char* images[][2] = {
+		{ "Images/background.qoi", "Images/background.png" },
+		{ "Images/foo.qoi", "Images/foo.png" },
+		{ "Images/hello_world.bmp", "Images/hello_world.bmp" },
+		{ "Images/background.png", NULL }
+	};
+
+	SDL_RendererInfo info;
+	SDL_GetRendererInfo(gRenderer, &info);
+	printf("%s renderer, direct loads use %s\n", info.name, SDL_GetPixelFormatName(gDirectFormat));
+	printf("%-24s %10s %10s %14s %14s %8s\n", "image", "direct ms", "surface ms", "direct peak", "surface peak", "pixels");
+
+	double frequency = (double)SDL_GetPerformanceFrequency();
+	bool allMatch = true;
+	for (size_t i = 0; i < SDL_arraysize(images); ++i)
+	{
+		std::string path = images[i][0];
+		double milliseconds[2] = { 0.0, 0.0 };
+		long long peak[2] = { 0, 0 };
+		for (int way = 0; way < 2; ++way)
+		{
+			//Peak heap over one load, the texture itself included
+			int width = 0;
+			int height = 0;
+			long long before = resetPeak();
+			SDL_Texture* texture = way == 0 ? loadTextureDirect(path, true, &width, &height) : loadTextureSurface(path, true, &width, &height);
+			peak[way] = getPeak() - before;
+			SDL_DestroyTexture(texture);
+
+			Uint64 start = SDL_GetPerformanceCounter();
+			for (int n = 0; n < BENCHMARK_LOADS; ++n)
+			{
+				texture = way == 0 ? loadTextureDirect(path, true, &width, &height) : loadTextureSurface(path, true, &width, &height);
+				SDL_DestroyTexture(texture);
+			}
+			milliseconds[way] = (SDL_GetPerformanceCounter() - start) / frequency * 1000.0 / BENCHMARK_LOADS;
+		}
+
+		//Same pixels as SDL_image gets, where there's a reference
+		const char* match = "-";
+		if (images[i][1] != NULL)
+		{
+			std::vector<Uint32> direct;
+			std::vector<Uint32> reference;
+			int directWidth = 0, directHeight = 0, referenceWidth = 0, referenceHeight = 0;
+			bool same = decodeToMemory(path, true, direct, &directWidth, &directHeight) && decodeToMemory(images[i][1], false, reference, &referenceWidth, &referenceHeight) &&
+				directWidth == referenceWidth && directHeight == referenceHeight && direct == reference;
+			match = same ? "same" : "DIFFER";
+			allMatch = allMatch && same;
+		}
+
+		printf("%-24s %10.3f %10.3f %11lld KB %11lld KB %8s\n", path.c_str(), milliseconds[0], milliseconds[1], peak[0] / 1024, peak[1] / 1024, match);
+	}
+
+	printf("Direct decoders %s SDL_image\n", allMatch ? "match" : "DO NOT match");
+	return allMatch;
+}
+
+bool init(bool software, bool hidden)
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Set texture filtering to linear
+		if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1"))
+		{
+			printf("Warning: Linear texture filtering not enabled!");
+		}
+
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Create vsynced renderer for window
+			gRenderer = SDL_CreateRenderer(gWindow, -1, software ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize renderer color
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+
+				//Direct loads write the renderer's own pixel format
+				gDirectFormat = chooseDirectFormat();
+
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' texture
+	if (!gFooTexture.loadFromFile("Images/foo.qoi"))
+	{
+		printf("Failed to load Foo' texture image!\n");
+		success = false;
+	}
+
+	//Load background texture
+	if (!gBackgroundTexture.loadFromFile("Images/background.qoi"))
+	{
+		printf("Failed to load background texture image!\n");
+		success = false;
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free loaded images
+	gFooTexture.free();
+	gBackgroundTexture.free();
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"benchmark" compares the two ways of loading in a hidden window, "software" anywhere picks the CPU renderer
+	bool benchmark = false;
+	bool software = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		benchmark = benchmark || strcmp(args[i], "benchmark") == 0;
+		software = software || strcmp(args[i], "software") == 0;
+	}
+
+	//Peaks need the allocator hooked before SDL allocates anything
+	if (benchmark)
+	{
+		initPeakTracking();
+	}
+
+	//The benchmark exits nonzero when it can't run or the decoders disagree, so scripts can gate on it
+	int exitCode = 0;
+
+	//Start up SDL and create window
+	if (!init(software, benchmark))
+	{
+		printf("Failed to initialize!\n");
+		exitCode = benchmark ? 1 : 0;
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+			exitCode = benchmark ? 1 : 0;
+		}
+		else if (benchmark)
+		{
+			exitCode = runBenchmark() ? 0 : 1;
+		}
+		else
+		{
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+				}
+
+				//Clear screen
+				SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
+				SDL_RenderClear(gRenderer);
+
+				//Render background texture to screen
+				gBackgroundTexture.render(0, 0);
+
+				//Render Foo' to the screen
+				gFooTexture.render(240, 190);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return exitCode;
+}
@@ -0,0 +1,1233 @@
+/*This source code copyrighted by Lazy Foo' Productions (2004-2015)
+and may not be redistributed without written permission.*/
+
+//Using SDL, SDL_image, standard IO, strings, vectors, algorithms and stdlib
+#include <SDL.h>
+#include <SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+//SSE2 is always there on x64 and on x86 builds compiled with /arch:SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PALETTE_USE_SSE2 1
+#endif
+
+//AVX2 kernels are compiled for any x86 target and only called when the CPU has it.
+//MSVC allows the intrinsics anywhere, GCC and Clang need them marked per function.
+#if defined(PALETTE_USE_SSE2) && defined(_MSC_VER)
+#include <immintrin.h>
+#define PALETTE_USE_AVX2 1
+#define PALETTE_TARGET_AVX2
+#elif defined(PALETTE_USE_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define PALETTE_USE_AVX2 1
+#define PALETTE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+//Screen dimension constants
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Sprites composited each frame
+const int TOTAL_SPRITES = 256;
+
+//Team colors the sprites get recolored with
+const int TOTAL_TEAMS = 4;
+const SDL_Color TEAM_COLORS[TOTAL_TEAMS] = { { 0xE0, 0x20, 0x20, 0xFF }, { 0x20, 0x50, 0xE0, 0xFF }, { 0x20, 0xB0, 0x30, 0xFF }, { 0xF0, 0xC0, 0x10, 0xFF } };
+
+//Frames expanded per level in the self test benchmark
+const int BENCHMARK_ITERATIONS = 100;
+
+//Key press surfaces constants, the backgrounds are picked with the arrow keys
+enum KeyPressSurfaces
+{
+	KEY_PRESS_SURFACE_DEFAULT,
+	KEY_PRESS_SURFACE_UP,
+	KEY_PRESS_SURFACE_DOWN,
+	KEY_PRESS_SURFACE_LEFT,
+	KEY_PRESS_SURFACE_RIGHT,
+	KEY_PRESS_SURFACE_TOTAL
+};
+
+//Kernel implementations, in the order they are tried
+enum PaletteLevel
+{
+	PALETTE_SCALAR,
+	PALETTE_SSE2,
+	PALETTE_AVX2,
+	PALETTE_TOTAL
+};
+
+//Names used in the title and the self test
+const char* PALETTE_LEVEL_NAMES[PALETTE_TOTAL] = { "scalar", "SSE2", "AVX2" };
+
+//Writes palette[src] over dst except where the index is 0, which is transparent. Pixels are ARGB8888.
+typedef void(*ExpandRowFunc)(Uint32* dst, const Uint8* src, int count, const Uint32* palette);
+
+//Copies src over dst except where the src alpha is 0, the 32 bit path the indexed one replaces
+typedef void(*CopyRowFunc)(Uint32* dst, const Uint32* src, int count);
+
+//256 ARGB8888 colors, entry 0 is transparent and never drawn
+struct LPalette
+{
+	Uint32 colors[256];
+};
+
+//Image stored as one byte per pixel plus a palette
+class LIndexedImage
+{
+	public:
+		//Initializes variables
+		LIndexedImage();
+
+		//Deallocates memory
+		~LIndexedImage();
+
+		//Loads image at specified path, cyan becomes transparent if colorKey is set
+		bool loadFromFile(std::string path, bool colorKey);
+
+		//Builds the indices from an ARGB8888 surface, quantizing if it has more than 255 colors
+		bool createFromSurface(SDL_Surface* surface, bool colorKey);
+
+		//Deallocates image
+		void free();
+
+		//Expands the image into an ARGB8888 surface at (x, y), clipped, with its own palette or a swapped one
+		void render(SDL_Surface* dst, int x, int y, const LPalette* palette = NULL);
+
+		//Makes the 32 bit surface this image would have been without indexing
+		SDL_Surface* createSurface(const LPalette* palette = NULL);
+
+		//Gets image info
+		const LPalette& getPalette() const;
+		int getWidth() const;
+		int getHeight() const;
+		int getColorCount() const;
+		bool wasQuantized() const;
+
+		//Bytes for the indices and the palette
+		int getByteSize() const;
+
+	private:
+		//One palette index per pixel, rows packed with no padding
+		std::vector<Uint8> mIndices;
+		LPalette mPalette;
+
+		//Image dimensions
+		int mWidth;
+		int mHeight;
+
+		//Palette entries in use, not counting the transparent one
+		int mColorCount;
+		bool mQuantized;
+};
+
+//Starts up SDL and creates window
+bool init();
+
+//Loads media
+bool loadMedia();
+
+//Frees media and shuts down SDL
+void close();
+
+//Loads an image and converts it to ARGB8888
+SDL_Surface* loadSurface(std::string path);
+
+//Creates an empty ARGB8888 surface
+SDL_Surface* createFrameSurface(int width, int height);
+
+//Recolors a palette towards a team color, dark entries take the team color and light ones stay light
+void makeTeamPalette(const LPalette& base, SDL_Color team, LPalette* palette);
+
+//Whether a kernel level can run on this CPU
+bool isPaletteLevelSupported(int level);
+
+//Switches the kernels the render functions use
+void setPaletteLevel(int level);
+
+//Composites a 32 bit sprite onto dst at (x, y), clipped to dst
+void compositeCopy(SDL_Surface* dst, SDL_Surface* src, int x, int y);
+
+//Checks every level against the scalar kernels and the quantizer on a gradient, then times them
+bool runSelfTest();
+
+//The window we'll be rendering to
+SDL_Window* gWindow = NULL;
+
+//The window renderer
+SDL_Renderer* gRenderer = NULL;
+
+//Indexed images and the team palettes Foo' is drawn with
+LIndexedImage gFooImage;
+LIndexedImage gBackgroundImages[KEY_PRESS_SURFACE_TOTAL];
+LPalette gTeamPalettes[TOTAL_TEAMS];
+
+//The same art as 32 bit surfaces, which need a whole copy of Foo' per team
+SDL_Surface* gFooSurfaces[TOTAL_TEAMS] = { NULL };
+SDL_Surface* gBackgroundSurfaces[KEY_PRESS_SURFACE_TOTAL] = { NULL };
+
+//Frame composited on the CPU and the texture it is shown through
+SDL_Surface* gFrameSurface = NULL;
+SDL_Texture* gFrameTexture = NULL;
+
+//Kernels in use
+ExpandRowFunc gExpandRow = NULL;
+CopyRowFunc gCopyRow = NULL;
+int gPaletteLevel = PALETTE_SCALAR;
+
+
+//Scalar reference kernels, the SIMD versions have to match these exactly
+static void expandRowScalar(Uint32* dst, const Uint8* src, int count, const Uint32* palette)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		if (src[i] != 0)
+		{
+			dst[i] = palette[src[i]];
+		}
+	}
+}
+
+static void copyRowScalar(Uint32* dst, const Uint32* src, int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		if ((src[i] >> 24) != 0)
+		{
+			dst[i] = src[i];
+		}
+	}
+}
+
+#ifdef PALETTE_USE_SSE2
+static void expandRowSSE2(Uint32* dst, const Uint8* src, int count, const Uint32* palette)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	int i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		//Sixteen indices at once, runs that are all transparent are skipped without touching dst
+		__m128i indices = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i clear = _mm_cmpeq_epi8(indices, zero);
+		int clearBits = _mm_movemask_epi8(clear);
+		if (clearBits == 0xFFFF)
+		{
+			continue;
+		}
+
+		//SSE2 has no gather, the lookups are scalar and the select is vector
+		const Uint8* s = src + i;
+		__m128i colors[4];
+		for (int j = 0; j < 4; ++j)
+		{
+			colors[j] = _mm_setr_epi32((int)palette[s[j * 4]], (int)palette[s[j * 4 + 1]], (int)palette[s[j * 4 + 2]], (int)palette[s[j * 4 + 3]]);
+		}
+
+		if (clearBits == 0)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				_mm_storeu_si128((__m128i*)(dst + i + j * 4), colors[j]);
+			}
+			continue;
+		}
+
+		//Widen the byte mask to one 32 bit mask per pixel, transparent pixels keep the destination
+		__m128i clearLow = _mm_unpacklo_epi8(clear, clear);
+		__m128i clearHigh = _mm_unpackhi_epi8(clear, clear);
+		__m128i keep[4] = { _mm_unpacklo_epi16(clearLow, clearLow), _mm_unpackhi_epi16(clearLow, clearLow), _mm_unpacklo_epi16(clearHigh, clearHigh), _mm_unpackhi_epi16(clearHigh, clearHigh) };
+		for (int j = 0; j < 4; ++j)
+		{
+			__m128i d = _mm_loadu_si128((const __m128i*)(dst + i + j * 4));
+			_mm_storeu_si128((__m128i*)(dst + i + j * 4), _mm_or_si128(_mm_and_si128(keep[j], d), _mm_andnot_si128(keep[j], colors[j])));
+		}
+	}
+
+	expandRowScalar(dst + i, src + i, count - i, palette);
+}
+
+static void copyRowSSE2(Uint32* dst, const Uint32* src, int count)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+
+		//All ones where alpha is 0, those keep the destination
+		__m128i clear = _mm_cmpeq_epi32(_mm_srli_epi32(s, 24), zero);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(_mm_and_si128(clear, d), _mm_andnot_si128(clear, s)));
+	}
+
+	copyRowScalar(dst + i, src + i, count - i);
+}
+#endif
+
+#ifdef PALETTE_USE_AVX2
+PALETTE_TARGET_AVX2
+static void expandRowAVX2(Uint32* dst, const Uint8* src, int count, const Uint32* palette)
+{
+	const __m256i zero = _mm256_setzero_si256();
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		//Eight indices as one integer, all transparent skips the run
+		Uint64 packed;
+		memcpy(&packed, src + i, sizeof(packed));
+		if (packed == 0)
+		{
+			continue;
+		}
+
+		//Widen the indices to 32 bits and fetch all eight colors with one gather
+		__m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i)));
+		__m256i colors = _mm256_i32gather_epi32((const int*)palette, indices, 4);
+
+		//No zero byte in the run means nothing to keep from the destination
+		const Uint64 ones = 0x0101010101010101ULL;
+		if (((packed - ones) & ~packed & (ones << 7)) == 0)
+		{
+			_mm256_storeu_si256((__m256i*)(dst + i), colors);
+			continue;
+		}
+
+		__m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_blendv_epi8(colors, d, _mm256_cmpeq_epi32(indices, zero)));
+	}
+
+	expandRowScalar(dst + i, src + i, count - i, palette);
+}
+
+PALETTE_TARGET_AVX2
+static void copyRowAVX2(Uint32* dst, const Uint32* src, int count)
+{
+	const __m256i zero = _mm256_setzero_si256();
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+		__m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_blendv_epi8(s, d, _mm256_cmpeq_epi32(_mm256_srli_epi32(s, 24), zero)));
+	}
+
+	copyRowScalar(dst + i, src + i, count - i);
+}
+#endif
+
+bool isPaletteLevelSupported(int level)
+{
+	switch (level)
+	{
+		case PALETTE_SCALAR:
+		return true;
+
+#ifdef PALETTE_USE_SSE2
+		case PALETTE_SSE2:
+		return SDL_HasSSE2() == SDL_TRUE;
+#endif
+
+#if defined(PALETTE_USE_AVX2) && SDL_VERSION_ATLEAST(2, 0, 4)
+		case PALETTE_AVX2:
+		return SDL_HasAVX2() == SDL_TRUE;
+#endif
+
+		default:
+		return false;
+	}
+}
+
+//Gets the kernels for a level, falls back to scalar for levels that weren't compiled in
+static void getPaletteKernels(int level, ExpandRowFunc* expandRow, CopyRowFunc* copyRow)
+{
+	*expandRow = expandRowScalar;
+	*copyRow = copyRowScalar;
+
+#ifdef PALETTE_USE_SSE2
+	if (level == PALETTE_SSE2)
+	{
+		*expandRow = expandRowSSE2;
+		*copyRow = copyRowSSE2;
+	}
+#endif
+
+#ifdef PALETTE_USE_AVX2
+	if (level == PALETTE_AVX2)
+	{
+		*expandRow = expandRowAVX2;
+		*copyRow = copyRowAVX2;
+	}
+#endif
+}
+
+void setPaletteLevel(int level)
+{
+	gPaletteLevel = level;
+	getPaletteKernels(level, &gExpandRow, &gCopyRow);
+}
+
+//Clips a width x height source placed at (x, y) against dst, false if nothing is left
+static bool clipToSurface(SDL_Surface* dst, int width, int height, int x, int y, SDL_Rect* srcRect)
+{
+	srcRect->x = x < 0 ? -x : 0;
+	srcRect->y = y < 0 ? -y : 0;
+	srcRect->w = SDL_min(width, dst->w - x) - srcRect->x;
+	srcRect->h = SDL_min(height, dst->h - y) - srcRect->y;
+	return srcRect->w > 0 && srcRect->h > 0;
+}
+
+void compositeCopy(SDL_Surface* dst, SDL_Surface* src, int x, int y)
+{
+	SDL_Rect clip;
+	if (!clipToSurface(dst, src->w, src->h, x, y, &clip))
+	{
+		return;
+	}
+
+	for (int row = 0; row < clip.h; ++row)
+	{
+		const Uint32* s = (const Uint32*)((const Uint8*)src->pixels + (clip.y + row) * src->pitch) + clip.x;
+		Uint32* d = (Uint32*)((Uint8*)dst->pixels + (y + clip.y + row) * dst->pitch) + x + clip.x;
+		gCopyRow(d, s, clip.w);
+	}
+}
+
+//Whether a pixel becomes the transparent index
+static inline bool isClearPixel(Uint32 pixel, bool colorKey)
+{
+	return (pixel >> 24) < 0x80 || (colorKey && (pixel & 0x00FFFFFF) == 0x0000FFFF);
+}
+
+//Cell of a color on a 5 bits per channel grid
+static inline int getColorCell(Uint32 pixel)
+{
+	return (int)(((pixel >> 9) & 0x7C00) | ((pixel >> 6) & 0x03E0) | ((pixel >> 3) & 0x001F));
+}
+
+LIndexedImage::LIndexedImage()
+{
+	//Initialize
+	memset(&mPalette, 0, sizeof(mPalette));
+	mWidth = 0;
+	mHeight = 0;
+	mColorCount = 0;
+	mQuantized = false;
+}
+
+LIndexedImage::~LIndexedImage()
+{
+	//Deallocate
+	free();
+}
+
+bool LIndexedImage::loadFromFile(std::string path, bool colorKey)
+{
+	SDL_Surface* loadedSurface = loadSurface(path);
+	if (loadedSurface == NULL)
+	{
+		return false;
+	}
+
+	bool success = createFromSurface(loadedSurface, colorKey);
+	SDL_FreeSurface(loadedSurface);
+	return success;
+}
+
+bool LIndexedImage::createFromSurface(SDL_Surface* surface, bool colorKey)
+{
+	//Get rid of preexisting image
+	free();
+
+	if (surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+	{
+		printf("Indexed images are made from ARGB8888 surfaces only!\n");
+		return false;
+	}
+
+	//Every distinct opaque color, alpha forced up so half transparent edges index the same as solid ones
+	std::vector<Uint32> colors;
+	colors.reserve(surface->w * surface->h);
+	for (int y = 0; y < surface->h; ++y)
+	{
+		const Uint32* row = (const Uint32*)((const Uint8*)surface->pixels + y * surface->pitch);
+		for (int x = 0; x < surface->w; ++x)
+		{
+			if (!isClearPixel(row[x], colorKey))
+			{
+				colors.push_back(row[x] | 0xFF000000);
+			}
+		}
+	}
+	std::sort(colors.begin(), colors.end());
+	colors.erase(std::unique(colors.begin(), colors.end()), colors.end());
+
+	mWidth = surface->w;
+	mHeight = surface->h;
+	mIndices.resize(mWidth * mHeight);
+
+	if (colors.size() <= 255)
+	{
+		//Few enough colors to keep exactly, the sorted list is the palette
+		for (size_t i = 0; i < colors.size(); ++i)
+		{
+			mPalette.colors[i + 1] = colors[i];
+		}
+		mColorCount = (int)colors.size();
+
+		for (int y = 0; y < mHeight; ++y)
+		{
+			const Uint32* row = (const Uint32*)((const Uint8*)surface->pixels + y * surface->pitch);
+			for (int x = 0; x < mWidth; ++x)
+			{
+				Uint8 index = 0;
+				if (!isClearPixel(row[x], colorKey))
+				{
+					index = (Uint8)(1 + (std::lower_bound(colors.begin(), colors.end(), row[x] | 0xFF000000) - colors.begin()));
+				}
+				mIndices[y * mWidth + x] = index;
+			}
+		}
+		return true;
+	}
+
+	//Too many colors, median cut over a 5 bits per channel grid. The box of cells with the widest
+	//channel is split at its pixel weighted median until there are 255, each box's average is an entry.
+	const int TOTAL_CELLS = 32 * 32 * 32;
+	std::vector<Uint32> cellCounts(TOTAL_CELLS, 0);
+	std::vector<Uint32> cellSums(TOTAL_CELLS * 3, 0);
+	for (int y = 0; y < mHeight; ++y)
+	{
+		const Uint32* row = (const Uint32*)((const Uint8*)surface->pixels + y * surface->pitch);
+		for (int x = 0; x < mWidth; ++x)
+		{
+			if (!isClearPixel(row[x], colorKey))
+			{
+				int cell = getColorCell(row[x]);
+				++cellCounts[cell];
+				cellSums[cell * 3] += (row[x] >> 16) & 0xFF;
+				cellSums[cell * 3 + 1] += (row[x] >> 8) & 0xFF;
+				cellSums[cell * 3 + 2] += row[x] & 0xFF;
+			}
+		}
+	}
+
+	std::vector<int> usedCells;
+	for (int cell = 0; cell < TOTAL_CELLS; ++cell)
+	{
+		if (cellCounts[cell] > 0)
+		{
+			usedCells.push_back(cell);
+		}
+	}
+
+	//Boxes are ranges of usedCells, channel 0 is red and 2 is blue
+	std::vector<std::pair<int, int> > boxes(1, std::make_pair(0, (int)usedCells.size()));
+	while (boxes.size() < 255)
+	{
+		int bestBox = -1;
+		int bestChannel = 0;
+		int bestRange = 0;
+		for (size_t i = 0; i < boxes.size(); ++i)
+		{
+			for (int channel = 0; channel < 3; ++channel)
+			{
+				int shift = 10 - channel * 5;
+				int low = 31;
+				int high = 0;
+				for (int k = boxes[i].first; k < boxes[i].second; ++k)
+				{
+					int value = (usedCells[k] >> shift) & 0x1F;
+					low = SDL_min(low, value);
+					high = SDL_max(high, value);
+				}
+				if (high - low > bestRange)
+				{
+					bestBox = (int)i;
+					bestChannel = channel;
+					bestRange = high - low;
+				}
+			}
+		}
+
+		//Every box is down to a single cell
+		if (bestBox < 0)
+		{
+			break;
+		}
+
+		int begin = boxes[bestBox].first;
+		int end = boxes[bestBox].second;
+		int shift = 10 - bestChannel * 5;
+		std::sort(usedCells.begin() + begin, usedCells.begin() + end, [shift](int a, int b) { return ((a >> shift) & 0x1F) < ((b >> shift) & 0x1F); });
+
+		Uint32 total = 0;
+		for (int k = begin; k < end; ++k)
+		{
+			total += cellCounts[usedCells[k]];
+		}
+		int split = begin + 1;
+		for (Uint32 running = cellCounts[usedCells[begin]]; split < end - 1 && running * 2 < total; ++split)
+		{
+			running += cellCounts[usedCells[split]];
+		}
+
+		boxes[bestBox].second = split;
+		boxes.push_back(std::make_pair(split, end));
+	}
+
+	std::vector<Uint8> cellIndices(TOTAL_CELLS, 0);
+	for (size_t i = 0; i < boxes.size(); ++i)
+	{
+		Uint32 sums[3] = { 0, 0, 0 };
+		Uint32 count = 0;
+		for (int k = boxes[i].first; k < boxes[i].second; ++k)
+		{
+			int cell = usedCells[k];
+			sums[0] += cellSums[cell * 3];
+			sums[1] += cellSums[cell * 3 + 1];
+			sums[2] += cellSums[cell * 3 + 2];
+			count += cellCounts[cell];
+			cellIndices[cell] = (Uint8)(i + 1);
+		}
+		mPalette.colors[i + 1] = 0xFF000000 | (((sums[0] + count / 2) / count) << 16) | (((sums[1] + count / 2) / count) << 8) | ((sums[2] + count / 2) / count);
+	}
+	mColorCount = (int)boxes.size();
+	mQuantized = true;
+
+	for (int y = 0; y < mHeight; ++y)
+	{
+		const Uint32* row = (const Uint32*)((const Uint8*)surface->pixels + y * surface->pitch);
+		for (int x = 0; x < mWidth; ++x)
+		{
+			mIndices[y * mWidth + x] = isClearPixel(row[x], colorKey) ? 0 : cellIndices[getColorCell(row[x])];
+		}
+	}
+
+	return true;
+}
+
+void LIndexedImage::free()
+{
+	//Free indices if they exist
+	std::vector<Uint8>().swap(mIndices);
+	memset(&mPalette, 0, sizeof(mPalette));
+	mWidth = 0;
+	mHeight = 0;
+	mColorCount = 0;
+	mQuantized = false;
+}
+
+void LIndexedImage::render(SDL_Surface* dst, int x, int y, const LPalette* palette)
+{
+	//Swapped palettes recolor the same indices
+	if (palette == NULL)
+	{
+		palette = &mPalette;
+	}
+
+	SDL_Rect clip;
+	if (!clipToSurface(dst, mWidth, mHeight, x, y, &clip))
+	{
+		return;
+	}
+
+	for (int row = 0; row < clip.h; ++row)
+	{
+		const Uint8* s = &mIndices[(clip.y + row) * mWidth + clip.x];
+		Uint32* d = (Uint32*)((Uint8*)dst->pixels + (y + clip.y + row) * dst->pitch) + x + clip.x;
+		gExpandRow(d, s, clip.w, palette->colors);
+	}
+}
+
+SDL_Surface* LIndexedImage::createSurface(const LPalette* palette)
+{
+	if (palette == NULL)
+	{
+		palette = &mPalette;
+	}
+
+	//Starts out all zero so transparent pixels end up with alpha 0
+	SDL_Surface* surface = createFrameSurface(mWidth, mHeight);
+	if (surface != NULL)
+	{
+		for (int y = 0; y < mHeight; ++y)
+		{
+			expandRowScalar((Uint32*)((Uint8*)surface->pixels + y * surface->pitch), &mIndices[y * mWidth], mWidth, palette->colors);
+		}
+	}
+
+	return surface;
+}
+
+const LPalette& LIndexedImage::getPalette() const
+{
+	return mPalette;
+}
+
+int LIndexedImage::getWidth() const
+{
+	return mWidth;
+}
+
+int LIndexedImage::getHeight() const
+{
+	return mHeight;
+}
+
+int LIndexedImage::getColorCount() const
+{
+	return mColorCount;
+}
+
+bool LIndexedImage::wasQuantized() const
+{
+	return mQuantized;
+}
+
+int LIndexedImage::getByteSize() const
+{
+	return (int)mIndices.size() + (int)sizeof(mPalette);
+}
+
+void makeTeamPalette(const LPalette& base, SDL_Color team, LPalette* palette)
+{
+	palette->colors[0] = 0;
+	for (int i = 1; i < 256; ++i)
+	{
+		//Luma picks how far from the team color towards white the entry goes
+		Uint32 color = base.colors[i];
+		Uint32 luma = (((color >> 16) & 0xFF) * 77 + ((color >> 8) & 0xFF) * 150 + (color & 0xFF) * 29) >> 8;
+		Uint32 r = (team.r * (255 - luma) + 255 * luma) / 255;
+		Uint32 g = (team.g * (255 - luma) + 255 * luma) / 255;
+		Uint32 b = (team.b * (255 - luma) + 255 * luma) / 255;
+		palette->colors[i] = (color & 0xFF000000) | (r << 16) | (g << 8) | b;
+	}
+}
+
+bool runSelfTest()
+{
+	bool success = true;
+
+	//Odd counts and offsets so the scalar tails and unaligned loads get exercised
+	const int ROW_CAPACITY = 1024;
+	Uint8 indices[ROW_CAPACITY];
+	Uint32 src[ROW_CAPACITY];
+	Uint32 expected[ROW_CAPACITY];
+	Uint32 actual[ROW_CAPACITY];
+	LPalette palette;
+
+	for (int level = PALETTE_SSE2; level < PALETTE_TOTAL; ++level)
+	{
+		if (!isPaletteLevelSupported(level))
+		{
+			printf("%-6s not supported on this CPU, skipped\n", PALETTE_LEVEL_NAMES[level]);
+			continue;
+		}
+
+		ExpandRowFunc expandRow;
+		CopyRowFunc copyRow;
+		getPaletteKernels(level, &expandRow, &copyRow);
+
+		int failures = 0;
+		for (int run = 0; run < 2000; ++run)
+		{
+			int offset = rand() % 8;
+			int count = rand() % (ROW_CAPACITY - offset);
+
+			//Entry 0 is garbage on purpose, the kernels must never write it
+			for (int i = 0; i < 256; ++i)
+			{
+				palette.colors[i] = (Uint32)rand() ^ ((Uint32)rand() << 16);
+			}
+
+			//Transparent runs of every length between random indices, so the skip paths get hit too
+			for (int i = 0; i < ROW_CAPACITY; )
+			{
+				int length = 1 + rand() % 40;
+				bool clear = rand() % 3 == 0;
+				for (; length > 0 && i < ROW_CAPACITY; --length, ++i)
+				{
+					indices[i] = clear ? 0 : (Uint8)(rand() & 0xFF);
+					Uint32 pixel = (Uint32)rand() ^ ((Uint32)rand() << 16);
+					src[i] = clear ? (pixel & 0x00FFFFFF) : pixel;
+				}
+			}
+			for (int i = 0; i < ROW_CAPACITY; ++i)
+			{
+				expected[i] = actual[i] = (Uint32)rand() ^ ((Uint32)rand() << 16);
+			}
+
+			expandRowScalar(expected + offset, indices + offset, count, palette.colors);
+			expandRow(actual + offset, indices + offset, count, palette.colors);
+			copyRowScalar(expected + offset, src + offset, count);
+			copyRow(actual + offset, src + offset, count);
+
+			if (memcmp(expected, actual, sizeof(expected)) != 0)
+			{
+				++failures;
+			}
+		}
+
+		printf("%-6s %s against scalar (%d mismatched rows)\n", PALETTE_LEVEL_NAMES[level], failures == 0 ? "matches" : "DIFFERS", failures);
+		success = success && failures == 0;
+	}
+
+	//A gradient with far more than 255 colors has to come back quantized and close
+	SDL_Surface* gradient = createFrameSurface(256, 256);
+	if (gradient == NULL)
+	{
+		return false;
+	}
+	for (int y = 0; y < gradient->h; ++y)
+	{
+		Uint32* row = (Uint32*)((Uint8*)gradient->pixels + y * gradient->pitch);
+		for (int x = 0; x < gradient->w; ++x)
+		{
+			row[x] = 0xFF000000 | (x << 16) | (y << 8) | ((x + y) / 2);
+		}
+	}
+
+	LIndexedImage quantized;
+	if (!quantized.createFromSurface(gradient, false))
+	{
+		SDL_FreeSurface(gradient);
+		return false;
+	}
+	SDL_Surface* expanded = quantized.createSurface();
+	double totalError = 0.0;
+	for (int y = 0; expanded != NULL && y < gradient->h; ++y)
+	{
+		const Uint32* a = (const Uint32*)((const Uint8*)gradient->pixels + y * gradient->pitch);
+		const Uint32* b = (const Uint32*)((const Uint8*)expanded->pixels + y * expanded->pitch);
+		for (int x = 0; x < gradient->w; ++x)
+		{
+			for (int shift = 0; shift < 24; shift += 8)
+			{
+				totalError += SDL_fabs((double)((a[x] >> shift) & 0xFF) - (double)((b[x] >> shift) & 0xFF));
+			}
+		}
+	}
+	double meanError = totalError / (gradient->w * gradient->h * 3);
+	bool quantizeOk = expanded != NULL && quantized.wasQuantized() && quantized.getColorCount() <= 255 && meanError < 6.0;
+	printf("quantizer %s: 65536 colors down to %d, mean channel error %.2f\n", quantizeOk ? "ok" : "FAILED", quantized.getColorCount(), meanError);
+	success = success && quantizeOk;
+	SDL_FreeSurface(expanded);
+	SDL_FreeSurface(gradient);
+
+	//Time each level expanding a whole frame from indices against copying it from 32 bit pixels.
+	//Full size buffers so the difference in bytes read shows, not just the kernels in cache.
+	const int FRAME_PIXELS = SCREEN_WIDTH * SCREEN_HEIGHT;
+	std::vector<Uint8> frameIndices(FRAME_PIXELS);
+	std::vector<Uint32> framePixels(FRAME_PIXELS);
+	std::vector<Uint32> frame(FRAME_PIXELS, 0);
+	for (int i = 0; i < 256; ++i)
+	{
+		palette.colors[i] = 0xFF000000 | ((Uint32)rand() ^ ((Uint32)rand() << 16));
+	}
+	for (int i = 0; i < FRAME_PIXELS; ++i)
+	{
+		//About a quarter transparent in short runs, like sprites over a background
+		frameIndices[i] = ((i / 16) % 4 == 0) ? 0 : (Uint8)(1 + rand() % 255);
+		framePixels[i] = frameIndices[i] == 0 ? 0 : palette.colors[frameIndices[i]];
+	}
+
+	for (int level = PALETTE_SCALAR; level < PALETTE_TOTAL; ++level)
+	{
+		if (!isPaletteLevelSupported(level))
+		{
+			continue;
+		}
+
+		ExpandRowFunc expandRow;
+		CopyRowFunc copyRow;
+		getPaletteKernels(level, &expandRow, &copyRow);
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (int n = 0; n < BENCHMARK_ITERATIONS; ++n)
+		{
+			for (int row = 0; row < SCREEN_HEIGHT; ++row)
+			{
+				expandRow(&frame[row * SCREEN_WIDTH], &frameIndices[row * SCREEN_WIDTH], SCREEN_WIDTH, palette.colors);
+			}
+		}
+		Uint64 middle = SDL_GetPerformanceCounter();
+		for (int n = 0; n < BENCHMARK_ITERATIONS; ++n)
+		{
+			for (int row = 0; row < SCREEN_HEIGHT; ++row)
+			{
+				copyRow(&frame[row * SCREEN_WIDTH], &framePixels[row * SCREEN_WIDTH], SCREEN_WIDTH);
+			}
+		}
+		Uint64 end = SDL_GetPerformanceCounter();
+
+		double frequency = (double)SDL_GetPerformanceFrequency();
+		printf("%-6s indexed %.3f ms (%d KB read), 32 bit %.3f ms (%d KB read) per %dx%d frame\n", PALETTE_LEVEL_NAMES[level],
+			(middle - start) * 1000.0 / frequency / BENCHMARK_ITERATIONS, (FRAME_PIXELS + (int)sizeof(LPalette)) / 1024,
+			(end - middle) * 1000.0 / frequency / BENCHMARK_ITERATIONS, FRAME_PIXELS * 4 / 1024, SCREEN_WIDTH, SCREEN_HEIGHT);
+	}
+
+	return success;
+}
+
+SDL_Surface* loadSurface(std::string path)
+{
+	//The final optimized image
+	SDL_Surface* optimizedSurface = NULL;
+
+	//Load image at specified path
+	SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+	if (loadedSurface == NULL)
+	{
+		printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+	}
+	else
+	{
+		//Indexing reads ARGB8888 only
+		optimizedSurface = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_ARGB8888, 0);
+		if (optimizedSurface == NULL)
+		{
+			printf("Unable to convert image %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+		}
+
+		//Get rid of old loaded surface
+		SDL_FreeSurface(loadedSurface);
+	}
+
+	return optimizedSurface;
+}
+
+SDL_Surface* createFrameSurface(int width, int height)
+{
+	int bpp;
+	Uint32 rmask, gmask, bmask, amask;
+	SDL_PixelFormatEnumToMasks(SDL_PIXELFORMAT_ARGB8888, &bpp, &rmask, &gmask, &bmask, &amask);
+	SDL_Surface* surface = SDL_CreateRGBSurface(0, width, height, bpp, rmask, gmask, bmask, amask);
+	if (surface == NULL)
+	{
+		printf("Unable to create surface! SDL Error: %s\n", SDL_GetError());
+	}
+
+	return surface;
+}
+
+bool init()
+{
+	//Initialization flag
+	bool success = true;
+
+	//Initialize SDL
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		printf("SDL could not initialize! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+	else
+	{
+		//Create window
+		gWindow = SDL_CreateWindow("SDL Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+		if (gWindow == NULL)
+		{
+			printf("Window could not be created! SDL Error: %s\n", SDL_GetError());
+			success = false;
+		}
+		else
+		{
+			//Software renderer, the expansion happens in the CPU compositor since renderers have no indexed textures
+			gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_SOFTWARE);
+			if (gRenderer == NULL)
+			{
+				printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+				success = false;
+			}
+			else
+			{
+				//Initialize PNG loading
+				int imgFlags = IMG_INIT_PNG;
+				if (!(IMG_Init(imgFlags) & imgFlags))
+				{
+					printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+					success = false;
+				}
+
+				//Frame buffer the images get expanded into
+				gFrameSurface = createFrameSurface(SCREEN_WIDTH, SCREEN_HEIGHT);
+				gFrameTexture = SDL_CreateTexture(gRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, SCREEN_WIDTH, SCREEN_HEIGHT);
+				if (gFrameSurface == NULL || gFrameTexture == NULL)
+				{
+					printf("Unable to create frame buffer! SDL Error: %s\n", SDL_GetError());
+					success = false;
+				}
+			}
+		}
+	}
+
+	return success;
+}
+
+bool loadMedia()
+{
+	//Loading success flag
+	bool success = true;
+
+	//Load Foo' with cyan as the transparent index
+	if (!gFooImage.loadFromFile("Images/foo.png", true))
+	{
+		printf("Failed to load Foo' image!\n");
+		success = false;
+	}
+	else
+	{
+		//One palette per team and the 32 bit copies the same thing would take without palettes
+		for (int i = 0; i < TOTAL_TEAMS; ++i)
+		{
+			makeTeamPalette(gFooImage.getPalette(), TEAM_COLORS[i], &gTeamPalettes[i]);
+			gFooSurfaces[i] = gFooImage.createSurface(&gTeamPalettes[i]);
+			if (gFooSurfaces[i] == NULL)
+			{
+				success = false;
+			}
+		}
+	}
+
+	//Load the key press backgrounds, opaque so nothing is keyed
+	const char* BACKGROUND_PATHS[KEY_PRESS_SURFACE_TOTAL] = { "Images/press.bmp", "Images/up.bmp", "Images/down.bmp", "Images/left.bmp", "Images/right.bmp" };
+	for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; ++i)
+	{
+		if (!gBackgroundImages[i].loadFromFile(BACKGROUND_PATHS[i], false))
+		{
+			printf("Failed to load %s!\n", BACKGROUND_PATHS[i]);
+			success = false;
+			continue;
+		}
+
+		printf("%s: %d colors%s\n", BACKGROUND_PATHS[i], gBackgroundImages[i].getColorCount(), gBackgroundImages[i].wasQuantized() ? ", quantized" : "");
+		gBackgroundSurfaces[i] = gBackgroundImages[i].createSurface();
+		if (gBackgroundSurfaces[i] == NULL)
+		{
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+void close()
+{
+	//Free indexed images
+	gFooImage.free();
+	for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; ++i)
+	{
+		gBackgroundImages[i].free();
+		SDL_FreeSurface(gBackgroundSurfaces[i]);
+		gBackgroundSurfaces[i] = NULL;
+	}
+
+	//Free 32 bit images
+	for (int i = 0; i < TOTAL_TEAMS; ++i)
+	{
+		SDL_FreeSurface(gFooSurfaces[i]);
+		gFooSurfaces[i] = NULL;
+	}
+	SDL_FreeSurface(gFrameSurface);
+	gFrameSurface = NULL;
+
+	//Free frame texture
+	if (gFrameTexture != NULL)
+	{
+		SDL_DestroyTexture(gFrameTexture);
+		gFrameTexture = NULL;
+	}
+
+	//Destroy window
+	SDL_DestroyRenderer(gRenderer);
+	SDL_DestroyWindow(gWindow);
+	gWindow = NULL;
+	gRenderer = NULL;
+
+	//Quit SDL subsystems
+	IMG_Quit();
+	SDL_Quit();
+}
+
+int main(int argc, char* args[])
+{
+	//"selftest" checks the SIMD kernels against the scalar ones and times them, no window needed
+	if (argc >= 2 && strcmp(args[1], "selftest") == 0)
+	{
+		return runSelfTest() ? 0 : 1;
+	}
+
+	//Start up SDL and create window
+	if (!init())
+	{
+		printf("Failed to initialize!\n");
+	}
+	else
+	{
+		//Load media
+		if (!loadMedia())
+		{
+			printf("Failed to load media!\n");
+		}
+		else
+		{
+			//Start with the best kernels the CPU has
+			int bestLevel = PALETTE_SCALAR;
+			for (int level = PALETTE_SCALAR; level < PALETTE_TOTAL; ++level)
+			{
+				if (isPaletteLevelSupported(level))
+				{
+					bestLevel = level;
+				}
+			}
+			setPaletteLevel(bestLevel);
+
+			//What the art takes in each mode, the palettes are what replaces the per team copies
+			int indexedBytes = gFooImage.getByteSize() + TOTAL_TEAMS * (int)sizeof(LPalette);
+			int fullBytes = TOTAL_TEAMS * gFooImage.getWidth() * gFooImage.getHeight() * 4;
+			for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; ++i)
+			{
+				indexedBytes += gBackgroundImages[i].getByteSize();
+				fullBytes += gBackgroundImages[i].getWidth() * gBackgroundImages[i].getHeight() * 4;
+			}
+
+			//Main loop flag
+			bool quit = false;
+
+			//Event handler
+			SDL_Event e;
+
+			//Current background, draw mode and which team each sprite starts on
+			int currentBackground = KEY_PRESS_SURFACE_DEFAULT;
+			bool indexed = true;
+			int teamOffset = 0;
+
+			//Composite timing shown in the title once a second
+			Uint64 compositeCounter = 0;
+			int compositeCount = 0;
+			Uint32 nextTitleUpdate = 0;
+
+			//While application is running
+			while (!quit)
+			{
+				//Handle events on queue
+				while (SDL_PollEvent(&e) != 0)
+				{
+					//User requests quit
+					if (e.type == SDL_QUIT)
+					{
+						quit = true;
+					}
+					else if (e.type == SDL_KEYDOWN)
+					{
+						//1, 2 and 3 pick scalar, SSE2 and AVX2
+						if (e.key.keysym.sym >= SDLK_1 && e.key.keysym.sym < SDLK_1 + PALETTE_TOTAL)
+						{
+							int level = e.key.keysym.sym - SDLK_1;
+							if (isPaletteLevelSupported(level))
+							{
+								setPaletteLevel(level);
+							}
+						}
+
+						//Select backgrounds based on key press
+						switch (e.key.keysym.sym)
+						{
+							case SDLK_UP:
+							currentBackground = KEY_PRESS_SURFACE_UP;
+							break;
+
+							case SDLK_DOWN:
+							currentBackground = KEY_PRESS_SURFACE_DOWN;
+							break;
+
+							case SDLK_LEFT:
+							currentBackground = KEY_PRESS_SURFACE_LEFT;
+							break;
+
+							case SDLK_RIGHT:
+							currentBackground = KEY_PRESS_SURFACE_RIGHT;
+							break;
+
+							//Space switches between indexed and 32 bit art
+							case SDLK_SPACE:
+							indexed = !indexed;
+							break;
+
+							//T swaps every sprite's team, only palettes change
+							case SDLK_t:
+							teamOffset = (teamOffset + 1) % TOTAL_TEAMS;
+							break;
+
+							default:
+							break;
+						}
+					}
+				}
+
+				//Composite the frame on the CPU
+				Uint64 compositeStart = SDL_GetPerformanceCounter();
+				if (indexed)
+				{
+					gBackgroundImages[currentBackground].render(gFrameSurface, 0, 0);
+				}
+				else
+				{
+					compositeCopy(gFrameSurface, gBackgroundSurfaces[currentBackground], 0, 0);
+				}
+
+				float time = SDL_GetTicks() / 1000.0f;
+				for (int i = 0; i < TOTAL_SPRITES; ++i)
+				{
+					int team = (i + teamOffset) % TOTAL_TEAMS;
+					int x = (int)((i * 97) % SCREEN_WIDTH + 40.0f * SDL_sin(time + i)) - gFooImage.getWidth() / 2;
+					int y = (int)((i * 59) % SCREEN_HEIGHT + 40.0f * SDL_cos(time * 1.3f + i)) - gFooImage.getHeight() / 2;
+					if (indexed)
+					{
+						gFooImage.render(gFrameSurface, x, y, &gTeamPalettes[team]);
+					}
+					else
+					{
+						compositeCopy(gFrameSurface, gFooSurfaces[team], x, y);
+					}
+				}
+				compositeCounter += SDL_GetPerformanceCounter() - compositeStart;
+				++compositeCount;
+
+				if (SDL_GetTicks() >= nextTitleUpdate)
+				{
+					char title[160];
+					SDL_snprintf(title, sizeof(title), "SDL Tutorial - %s %s %.3f ms, art %d KB (%s)", indexed ? "indexed" : "32 bit", PALETTE_LEVEL_NAMES[gPaletteLevel],
+						compositeCounter * 1000.0 / SDL_GetPerformanceFrequency() / (compositeCount > 0 ? compositeCount : 1),
+						(indexed ? indexedBytes : fullBytes) / 1024, indexed ? "palettes" : "copy per team");
+					SDL_SetWindowTitle(gWindow, title);
+					compositeCounter = 0;
+					compositeCount = 0;
+					nextTitleUpdate = SDL_GetTicks() + 1000;
+				}
+
+				//Show the frame
+				SDL_UpdateTexture(gFrameTexture, NULL, gFrameSurface->pixels, gFrameSurface->pitch);
+				SDL_RenderCopy(gRenderer, gFrameTexture, NULL, NULL);
+
+				//Update screen
+				SDL_RenderPresent(gRenderer);
+			}
+		}
+	}
+
+	//Free resources and close SDL
+	close();
+
+	return 0;
+}